@@ -0,0 +1,19 @@
+#pragma once
+#include <benchmark/benchmark.h>
+#include <stdint.h>
+
+/* replaces operator new/delete, so it may only be included by one translation unit of a benchmark */
+#include "../test/allocations.hpp"
+
+namespace allocations {
+
+/* reports the allocations made since start as allocs/call and bytes/call */
+inline void report(benchmark::State& state, const Counts& start, uint64_t calls)
+{
+    Counts end = current();
+    double divisor = static_cast<double>(calls ? calls : 1);
+    state.counters["allocs/call"] = static_cast<double>(end.allocations - start.allocations) / divisor;
+    state.counters["bytes/call"] = static_cast<double>(end.bytes - start.bytes) / divisor;
+}
+
+} // namespace allocations
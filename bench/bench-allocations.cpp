@@ -0,0 +1,235 @@
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <rapidfuzz/distance.hpp>
+#include <rapidfuzz/fuzz.hpp>
+#include <string>
+#include <vector>
+
+#include "allocations.hpp"
+#include "corpus.hpp"
+
+/*
+ * Counts the heap allocations of the free functions, the cached scorers and the Multi* scorers.
+ * Every benchmark reports allocs/call and bytes/call, which are independent of the machine, so
+ * they can be tracked using e.g. --benchmark_format=json. Benchmarks are named
+ *
+ *     <scorer>/len:<length>/<heap|workspace>
+ *
+ * The workspace variants bind a rapidfuzz::Workspace, so scorers taking their temporary buffers
+ * from it should report 0 allocations. Every pair is scored once before counting, so one-time
+ * allocations (e.g. the growth of the workspace) are not included.
+ */
+
+static std::shared_ptr<const corpus::Corpus> make_corpus(size_t len)
+{
+    corpus::Config config;
+    config.min_len = len;
+    config.max_len = len;
+    config.similarity = 0.8;
+    config.count = 64;
+    return std::make_shared<const corpus::Corpus>(corpus::generate(config));
+}
+
+/* runs func(i) for every query and reports the allocations per call */
+template <typename Func>
+static void run_counted(benchmark::State& state, size_t calls_per_iteration, bool use_workspace, Func func)
+{
+    rapidfuzz::Workspace workspace;
+    std::unique_ptr<rapidfuzz::WorkspaceGuard> guard;
+    if (use_workspace) guard.reset(new rapidfuzz::WorkspaceGuard(workspace));
+
+    for (size_t i = 0; i < calls_per_iteration; ++i)
+        benchmark::DoNotOptimize(func(i));
+
+    allocations::Counts start = allocations::current();
+    for (auto _ : state)
+        for (size_t i = 0; i < calls_per_iteration; ++i)
+            benchmark::DoNotOptimize(func(i));
+
+    allocations::report(state, start, static_cast<uint64_t>(state.iterations()) * calls_per_iteration);
+}
+
+static std::string bench_name(const std::string& scorer, size_t len, bool use_workspace)
+{
+    return scorer + "/len:" + std::to_string(len) + (use_workspace ? "/workspace" : "/heap");
+}
+
+template <typename Func>
+static void register_free(const std::string& scorer, std::shared_ptr<const corpus::Corpus> data, size_t len,
+                          Func func)
+{
+    for (bool use_workspace : {false, true}) {
+        auto bench = [data, use_workspace, func](benchmark::State& state) {
+            const corpus::Corpus& corpus = *data;
+            run_counted(state, corpus.choices.size(), use_workspace,
+                        [&](size_t i) { return func(corpus.choices[i], corpus.queries[i]); });
+        };
+        benchmark::RegisterBenchmark(bench_name(scorer, len, use_workspace).c_str(), bench);
+    }
+}
+
+template <typename CachedScorer>
+static void register_cached(const std::string& scorer, std::shared_ptr<const corpus::Corpus> data, size_t len)
+{
+    for (bool use_workspace : {false, true}) {
+        auto bench = [data, use_workspace](benchmark::State& state) {
+            const corpus::Corpus& corpus = *data;
+            std::vector<CachedScorer> scorers;
+            for (const auto& choice : corpus.choices)
+                scorers.emplace_back(choice);
+
+            run_counted(state, corpus.choices.size(), use_workspace,
+                        [&](size_t i) { return scorers[i].similarity(corpus.queries[i]); });
+        };
+        benchmark::RegisterBenchmark(bench_name(scorer, len, use_workspace).c_str(), bench);
+    }
+}
+
+#ifdef RAPIDFUZZ_SIMD
+/* every call compares a query with all choices */
+template <typename MultiScorer, typename ResType>
+static void register_multi(const std::string& scorer, std::shared_ptr<const corpus::Corpus> data, size_t len)
+{
+    for (bool use_workspace : {false, true}) {
+        auto bench = [data, use_workspace](benchmark::State& state) {
+            const corpus::Corpus& corpus = *data;
+            MultiScorer multi(corpus.choices.size());
+            for (const auto& choice : corpus.choices)
+                multi.insert(choice);
+
+            std::vector<ResType> results(multi.result_count());
+            run_counted(state, corpus.queries.size(), use_workspace, [&](size_t i) {
+                multi.similarity(&results[0], results.size(), corpus.queries[i]);
+                return results[0];
+            });
+        };
+        benchmark::RegisterBenchmark(bench_name(scorer, len, use_workspace).c_str(), bench);
+    }
+}
+
+static void register_multi_scorers(std::shared_ptr<const corpus::Corpus> data, size_t len)
+{
+    using namespace rapidfuzz::experimental;
+    namespace fuzz = rapidfuzz::fuzz::experimental;
+
+    register_multi<MultiLevenshtein<64>, size_t>("MultiLevenshtein<64>", data, len);
+    register_multi<MultiLCSseq<64>, size_t>("MultiLCSseq<64>", data, len);
+    register_multi<MultiIndel<64>, size_t>("MultiIndel<64>", data, len);
+    register_multi<MultiOSA<64>, size_t>("MultiOSA<64>", data, len);
+    register_multi<MultiHamming<64>, size_t>("MultiHamming<64>", data, len);
+    register_multi<MultiDamerauLevenshtein<64>, size_t>("MultiDamerauLevenshtein<64>", data, len);
+    register_multi<MultiJaro<64>, double>("MultiJaro<64>", data, len);
+    register_multi<MultiJaroWinkler<64>, double>("MultiJaroWinkler<64>", data, len);
+    register_multi<fuzz::MultiRatio<64>, double>("MultiRatio<64>", data, len);
+    register_multi<fuzz::MultiPartialRatio<64>, double>("MultiPartialRatio<64>", data, len);
+    register_multi<fuzz::MultiTokenSortRatio<64>, double>("MultiTokenSortRatio<64>", data, len);
+    register_multi<fuzz::MultiTokenSetRatio<64>, double>("MultiTokenSetRatio<64>", data, len);
+    register_multi<fuzz::MultiWRatio<64>, double>("MultiWRatio<64>", data, len);
+    register_multi<fuzz::MultiQRatio<64>, double>("MultiQRatio<64>", data, len);
+}
+#endif
+
+static void register_free_functions(std::shared_ptr<const corpus::Corpus> data, size_t len)
+{
+    using namespace rapidfuzz;
+
+    register_free("levenshtein_distance", data, len, [](const std::wstring& s1, const std::wstring& s2) {
+        return levenshtein_distance(s1, s2);
+    });
+    register_free("lcs_seq_similarity", data, len, [](const std::wstring& s1, const std::wstring& s2) {
+        return lcs_seq_similarity(s1, s2);
+    });
+    register_free("indel_distance", data, len, [](const std::wstring& s1, const std::wstring& s2) {
+        return indel_distance(s1, s2);
+    });
+    register_free("osa_distance", data, len, [](const std::wstring& s1, const std::wstring& s2) {
+        return osa_distance(s1, s2);
+    });
+    register_free("hamming_distance", data, len, [](const std::wstring& s1, const std::wstring& s2) {
+        return hamming_distance(s1, s2);
+    });
+    register_free("damerau_levenshtein_distance", data, len,
+                  [](const std::wstring& s1, const std::wstring& s2) {
+                      return experimental::damerau_levenshtein_distance(s1, s2);
+                  });
+    register_free("jaro_similarity", data, len, [](const std::wstring& s1, const std::wstring& s2) {
+        return jaro_similarity(s1, s2);
+    });
+    register_free("jaro_winkler_similarity", data, len, [](const std::wstring& s1, const std::wstring& s2) {
+        return jaro_winkler_similarity(s1, s2);
+    });
+    register_free("ratio", data, len, [](const std::wstring& s1, const std::wstring& s2) {
+        return fuzz::ratio(s1, s2);
+    });
+    register_free("partial_ratio", data, len, [](const std::wstring& s1, const std::wstring& s2) {
+        return fuzz::partial_ratio(s1, s2);
+    });
+    register_free("token_sort_ratio", data, len, [](const std::wstring& s1, const std::wstring& s2) {
+        return fuzz::token_sort_ratio(s1, s2);
+    });
+    register_free("partial_token_sort_ratio", data, len, [](const std::wstring& s1, const std::wstring& s2) {
+        return fuzz::partial_token_sort_ratio(s1, s2);
+    });
+    register_free("token_set_ratio", data, len, [](const std::wstring& s1, const std::wstring& s2) {
+        return fuzz::token_set_ratio(s1, s2);
+    });
+    register_free("partial_token_set_ratio", data, len, [](const std::wstring& s1, const std::wstring& s2) {
+        return fuzz::partial_token_set_ratio(s1, s2);
+    });
+    register_free("token_ratio", data, len, [](const std::wstring& s1, const std::wstring& s2) {
+        return fuzz::token_ratio(s1, s2);
+    });
+    register_free("partial_token_ratio", data, len, [](const std::wstring& s1, const std::wstring& s2) {
+        return fuzz::partial_token_ratio(s1, s2);
+    });
+    register_free("WRatio", data, len, [](const std::wstring& s1, const std::wstring& s2) {
+        return fuzz::WRatio(s1, s2);
+    });
+    register_free("QRatio", data, len, [](const std::wstring& s1, const std::wstring& s2) {
+        return fuzz::QRatio(s1, s2);
+    });
+}
+
+static void register_cached_scorers(std::shared_ptr<const corpus::Corpus> data, size_t len)
+{
+    using namespace rapidfuzz;
+
+    register_cached<CachedLevenshtein<wchar_t>>("CachedLevenshtein", data, len);
+    register_cached<CachedLCSseq<wchar_t>>("CachedLCSseq", data, len);
+    register_cached<CachedIndel<wchar_t>>("CachedIndel", data, len);
+    register_cached<CachedOSA<wchar_t>>("CachedOSA", data, len);
+    register_cached<CachedHamming<wchar_t>>("CachedHamming", data, len);
+    register_cached<experimental::CachedDamerauLevenshtein<wchar_t>>("CachedDamerauLevenshtein", data, len);
+    register_cached<CachedJaro<wchar_t>>("CachedJaro", data, len);
+    register_cached<CachedJaroWinkler<wchar_t>>("CachedJaroWinkler", data, len);
+    register_cached<fuzz::CachedRatio<wchar_t>>("CachedRatio", data, len);
+    register_cached<fuzz::CachedPartialRatio<wchar_t>>("CachedPartialRatio", data, len);
+    register_cached<fuzz::CachedTokenSortRatio<wchar_t>>("CachedTokenSortRatio", data, len);
+    register_cached<fuzz::CachedPartialTokenSortRatio<wchar_t>>("CachedPartialTokenSortRatio", data, len);
+    register_cached<fuzz::CachedTokenSetRatio<wchar_t>>("CachedTokenSetRatio", data, len);
+    register_cached<fuzz::CachedPartialTokenSetRatio<wchar_t>>("CachedPartialTokenSetRatio", data, len);
+    register_cached<fuzz::CachedTokenRatio<wchar_t>>("CachedTokenRatio", data, len);
+    register_cached<fuzz::CachedPartialTokenRatio<wchar_t>>("CachedPartialTokenRatio", data, len);
+    register_cached<fuzz::CachedWRatio<wchar_t>>("CachedWRatio", data, len);
+    register_cached<fuzz::CachedQRatio<wchar_t>>("CachedQRatio", data, len);
+}
+
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+
+    /* the short strings fit into a single word, the long ones use the block implementations */
+    for (size_t len : {size_t(16), size_t(256)}) {
+        auto data = make_corpus(len);
+        register_free_functions(data, len);
+        register_cached_scorers(data, len);
+#ifdef RAPIDFUZZ_SIMD
+        if (len <= 64) register_multi_scorers(data, len);
+#endif
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,450 @@
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <rapidfuzz/distance.hpp>
+#include <string>
+#include <vector>
+
+#include "corpus.hpp"
+
+/*
+ * Benchmarks on generated corpora with controlled length distributions, alphabets and similarity
+ * levels. Every benchmark is named
+ *
+ *     <scorer>/<kernel>/<alphabet>/len:<length>/sim:<similarity in %>/cutoff:<score_cutoff>
+ *
+ * where kernel is the implementation the scorer used for the pairs, so e.g.
+ * --benchmark_filter=/small_band/ only runs benchmarks of the small band implementation. It is
+ * taken from the counters of RAPIDFUZZ_ENABLE_STATS after scoring every pair once, so it includes
+ * the effects of the common affix removal and of the score_hint loop, which can run multiple
+ * kernels (e.g. small_band+block). Corpora mixing lengths are named mixed. A corpus with one
+ * string per line can be added using --corpus=<path>.
+ *
+ * The counters add overhead to the kernels, so the timed benchmarks are built without them. This
+ * file is built a second time with RAPIDFUZZ_ENABLE_STATS as bench_corpus_kernels, which writes
+ * the kernel of every benchmark to the file passed as --kernels=<path> instead of running it.
+ * bench_corpus reads the kernels from the file passed the same way:
+ *
+ *     bench_corpus_kernels --kernels=kernels.txt
+ *     bench_corpus --kernels=kernels.txt
+ */
+
+static const size_t no_cutoff = std::numeric_limits<size_t>::max();
+
+/* counters of a metric: its filter followed by its kernels */
+struct MetricPaths {
+    rapidfuzz::StatsPath filter;
+    rapidfuzz::StatsPath last;
+};
+
+static const MetricPaths levenshtein_paths = {rapidfuzz::StatsPath::LevenshteinFilter,
+                                              rapidfuzz::StatsPath::LevenshteinSimd};
+
+/* Indel uses the LCSseq implementation */
+static const MetricPaths indel_paths = {rapidfuzz::StatsPath::LCSseqFilter, rapidfuzz::StatsPath::LCSseqSimd};
+
+static const MetricPaths osa_paths = {rapidfuzz::StatsPath::OSAFilter, rapidfuzz::StatsPath::OSASimd};
+
+static const MetricPaths damerau_levenshtein_paths = {rapidfuzz::StatsPath::DamerauLevenshteinFilter,
+                                                      rapidfuzz::StatsPath::DamerauLevenshteinZhao};
+
+/*
+ * scores every pair once using func and names the kernels it ran, e.g. "small_band+block". Pairs
+ * handled by the filter are only named, when no kernel ran at all.
+ */
+template <typename Func>
+static std::string used_kernels(const corpus::Corpus& corpus, MetricPaths paths, Func func)
+{
+    rapidfuzz::stats_reset();
+    for (size_t i = 0; i < corpus.choices.size(); ++i)
+        benchmark::DoNotOptimize(func(i));
+    rapidfuzz::Stats stats = rapidfuzz::stats_snapshot();
+
+    std::string kernels;
+    for (size_t i = static_cast<size_t>(paths.filter) + 1; i <= static_cast<size_t>(paths.last); ++i) {
+        auto path = static_cast<rapidfuzz::StatsPath>(i);
+        if (!stats[path].calls) continue;
+
+        std::string name = rapidfuzz::to_string(path);
+        if (!kernels.empty()) kernels += "+";
+        kernels += name.substr(name.find('/') + 1);
+    }
+    return kernels.empty() ? "filter" : kernels;
+}
+
+#ifdef RAPIDFUZZ_ENABLE_STATS
+/* one line "<key>\t<kernel>" per benchmark, read by bench_corpus */
+static std::ofstream g_kernel_file;
+
+static void open_kernels(const std::string& path)
+{
+    g_kernel_file.open(path);
+    if (!g_kernel_file) throw std::runtime_error("failed to create " + path);
+}
+
+template <typename Func>
+static std::string kernel_name(const std::string& key, Func used)
+{
+    std::string kernel = used();
+    g_kernel_file << key << '\t' << kernel << '\n';
+    return kernel;
+}
+#else
+/* kernels of the benchmarks written by bench_corpus_kernels */
+static std::map<std::string, std::string> g_kernels;
+
+static void load_kernels(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file) throw std::runtime_error("failed to open " + path);
+
+    std::string line;
+    while (std::getline(file, line)) {
+        size_t tab = line.find('\t');
+        if (tab != std::string::npos) g_kernels[line.substr(0, tab)] = line.substr(tab + 1);
+    }
+}
+
+template <typename Func>
+static std::string kernel_name(const std::string& key, Func)
+{
+    auto kernel = g_kernels.find(key);
+    if (kernel == g_kernels.end())
+        throw std::runtime_error("the kernels file does not name " + key + ", rerun bench_corpus_kernels");
+    return kernel->second;
+}
+#endif
+
+static std::string cutoff_name(size_t score_cutoff)
+{
+    return (score_cutoff == no_cutoff) ? "none" : std::to_string(score_cutoff);
+}
+
+/* corpus and parameters shared by the scorers benchmarked on it */
+struct BenchCase {
+    std::shared_ptr<const corpus::Corpus> corpus;
+    std::string alphabet;
+    std::string len;
+    double similarity;
+    size_t score_cutoff;
+
+    std::string name(const std::string& scorer, const std::string& kernel) const
+    {
+        return scorer + "/" + kernel + "/" + alphabet + "/len:" + len +
+               "/sim:" + std::to_string(static_cast<int>(similarity * 100)) +
+               "/cutoff:" + cutoff_name(score_cutoff);
+    }
+};
+
+/* reports compared pairs and characters per second, so corpora of different lengths can be compared */
+static void set_throughput(benchmark::State& state, size_t pairs, size_t chars)
+{
+    state.counters["pairs/s"] = benchmark::Counter(static_cast<double>(pairs), benchmark::Counter::kIsRate);
+    state.counters["chars/s"] = benchmark::Counter(static_cast<double>(chars), benchmark::Counter::kIsRate);
+}
+
+/* compares every query with the choice it was generated from */
+template <typename Func>
+static void run_pairs(benchmark::State& state, const corpus::Corpus& corpus, Func func)
+{
+    size_t chars = 0;
+    for (size_t i = 0; i < corpus.choices.size(); ++i)
+        chars += corpus.choices[i].size() + corpus.queries[i].size();
+
+    for (auto _ : state)
+        for (size_t i = 0; i < corpus.choices.size(); ++i)
+            benchmark::DoNotOptimize(func(i));
+
+    set_throughput(state, state.iterations() * corpus.choices.size(), state.iterations() * chars);
+}
+
+static size_t levenshtein_pair(const BenchCase& bench, size_t i)
+{
+    const corpus::Corpus& corpus = *bench.corpus;
+    return rapidfuzz::levenshtein_distance(corpus.choices[i], corpus.queries[i], {1, 1, 1},
+                                           bench.score_cutoff);
+}
+
+/* kernel is taken from the counters when it is empty */
+static void register_levenshtein(const BenchCase& bench, std::string kernel = "")
+{
+    if (kernel.empty())
+        kernel = kernel_name(bench.name("Levenshtein", "*"), [&] {
+            return used_kernels(*bench.corpus, levenshtein_paths,
+                                [&](size_t i) { return levenshtein_pair(bench, i); });
+        });
+
+    benchmark::RegisterBenchmark(bench.name("Levenshtein", kernel).c_str(), [bench](benchmark::State& state) {
+        run_pairs(state, *bench.corpus, [&](size_t i) { return levenshtein_pair(bench, i); });
+    });
+}
+
+template <typename CachedScorer>
+static std::vector<CachedScorer> make_scorers(const corpus::Corpus& corpus)
+{
+    std::vector<CachedScorer> scorers;
+    for (const auto& choice : corpus.choices)
+        scorers.emplace_back(choice);
+    return scorers;
+}
+
+/* kernel is taken from the counters of paths when it is empty */
+template <typename CachedScorer>
+static void register_cached(const BenchCase& bench, const std::string& scorer_name, MetricPaths paths,
+                            std::string kernel = "")
+{
+    if (kernel.empty())
+        kernel = kernel_name(bench.name(scorer_name, "*"), [&] {
+            auto scorers = make_scorers<CachedScorer>(*bench.corpus);
+            return used_kernels(*bench.corpus, paths, [&](size_t i) {
+                return scorers[i].distance(bench.corpus->queries[i], bench.score_cutoff);
+            });
+        });
+
+    benchmark::RegisterBenchmark(bench.name(scorer_name, kernel).c_str(), [bench](benchmark::State& state) {
+        const corpus::Corpus& corpus = *bench.corpus;
+        auto scorers = make_scorers<CachedScorer>(corpus);
+        run_pairs(state, corpus,
+                  [&](size_t i) { return scorers[i].distance(corpus.queries[i], bench.score_cutoff); });
+    });
+}
+
+#ifdef RAPIDFUZZ_SIMD
+/* compares every query with all choices */
+template <typename MultiScorer>
+static void run_multi(benchmark::State& state, const corpus::Corpus& corpus, const MultiScorer& scorer,
+                      size_t score_cutoff)
+{
+    std::vector<size_t> results(scorer.result_count());
+    size_t choice_chars = 0;
+    for (const auto& choice : corpus.choices)
+        choice_chars += choice.size();
+
+    size_t chars = 0;
+    for (const auto& query : corpus.queries)
+        chars += choice_chars + query.size() * corpus.choices.size();
+
+    for (auto _ : state) {
+        for (const auto& query : corpus.queries) {
+            scorer.distance(&results[0], results.size(), query, score_cutoff);
+            benchmark::DoNotOptimize(results.data());
+        }
+    }
+
+    set_throughput(state, state.iterations() * corpus.queries.size() * corpus.choices.size(),
+                   state.iterations() * chars);
+}
+
+template <typename MultiScorer>
+static void register_multi(const BenchCase& bench, const std::string& scorer_name)
+{
+    benchmark::RegisterBenchmark(bench.name(scorer_name, "simd").c_str(), [bench](benchmark::State& state) {
+        const corpus::Corpus& corpus = *bench.corpus;
+        MultiScorer scorer(corpus.choices.size());
+        for (const auto& choice : corpus.choices)
+            scorer.insert(choice);
+
+        run_multi(state, corpus, scorer, bench.score_cutoff);
+    });
+}
+
+template <int MaxLen>
+static void register_simd(corpus::Alphabet alphabet, double similarity)
+{
+    corpus::Config config;
+    config.alphabet = alphabet;
+    config.min_len = MaxLen / 2;
+    config.max_len = MaxLen;
+    config.similarity = similarity;
+    config.count = 256;
+    auto generated = std::make_shared<corpus::Corpus>(corpus::generate(config));
+    /* every query is compared with all choices, so a few of them are enough */
+    generated->queries.resize(16);
+
+    std::string len = std::to_string(MaxLen / 2) + "-" + std::to_string(MaxLen);
+    BenchCase bench{generated, corpus::to_string(alphabet), len, similarity, no_cutoff};
+    std::string suffix = "<" + std::to_string(MaxLen) + ">";
+    register_multi<rapidfuzz::experimental::MultiLevenshtein<MaxLen>>(bench, "MultiLevenshtein" + suffix);
+    register_multi<rapidfuzz::experimental::MultiIndel<MaxLen>>(bench, "MultiIndel" + suffix);
+}
+#endif
+
+/* Levenshtein and Indel for fixed lengths and a sweep over score_cutoff */
+static void register_length_sweep(corpus::Alphabet alphabet, double similarity)
+{
+    const size_t lengths[] = {8, 32, 64, 256, 2048};
+    const size_t cutoffs[] = {2, 8, 31, 128, no_cutoff};
+
+    for (size_t len : lengths) {
+        corpus::Config config;
+        config.alphabet = alphabet;
+        config.min_len = len;
+        config.max_len = len;
+        config.similarity = similarity;
+        /* keep the amount of characters per iteration similar */
+        config.count = std::min<size_t>(1000, std::max<size_t>(16, 262144 / len));
+        auto generated = std::make_shared<const corpus::Corpus>(corpus::generate(config));
+        std::string alphabet_name = corpus::to_string(alphabet);
+
+        for (size_t score_cutoff : cutoffs) {
+            if (score_cutoff != no_cutoff && score_cutoff >= len) continue;
+
+            BenchCase bench{generated, alphabet_name, std::to_string(len), similarity, score_cutoff};
+            register_levenshtein(bench);
+            register_cached<rapidfuzz::CachedLevenshtein<wchar_t>>(bench, "CachedLevenshtein",
+                                                                   levenshtein_paths);
+            register_cached<rapidfuzz::CachedIndel<wchar_t>>(bench, "CachedIndel", indel_paths);
+        }
+    }
+}
+
+/*
+ * Damerau Levenshtein on pairs with an OSA distance in (2, 2 * score_cutoff]. The OSA filter can't
+ * answer these pairs, so they run the banded DP. CachedOSA on the same pairs shows the remaining gap
+ * to the bit-parallel OSA kernels
+ */
+static void register_damerau_levenshtein(corpus::Alphabet alphabet)
+{
+    const size_t lengths[] = {8, 32, 64, 256};
+    const size_t cutoffs[] = {4, 8, 31, no_cutoff};
+
+    for (size_t len : lengths) {
+        for (size_t score_cutoff : cutoffs) {
+            if (score_cutoff != no_cutoff && score_cutoff >= len) continue;
+
+            /* about as many edits as the cutoff allows, so most pairs pass the OSA filter */
+            size_t edits = (score_cutoff == no_cutoff) ? len / 4 : score_cutoff;
+            double edit_share = static_cast<double>(edits + 1) / static_cast<double>(len);
+            double similarity = std::min(0.97, std::max(0.3, 1.0 - edit_share));
+
+            corpus::Config config;
+            config.alphabet = alphabet;
+            config.min_len = len;
+            config.max_len = len;
+            config.similarity = similarity;
+            config.count = 4 * std::min<size_t>(1000, std::max<size_t>(16, 65536 / len));
+            corpus::Corpus generated = corpus::generate(config);
+
+            size_t max_osa = (score_cutoff == no_cutoff) ? no_cutoff : 2 * score_cutoff;
+            auto data = std::make_shared<corpus::Corpus>();
+            for (size_t i = 0; i < generated.choices.size(); ++i) {
+                size_t osa = rapidfuzz::osa_distance(generated.choices[i], generated.queries[i]);
+                if (osa <= 2 || osa > max_osa) continue;
+
+                data->choices.push_back(generated.choices[i]);
+                data->queries.push_back(generated.queries[i]);
+            }
+            if (data->choices.empty()) continue;
+
+            BenchCase bench{data, corpus::to_string(alphabet), std::to_string(len), similarity, score_cutoff};
+            register_cached<rapidfuzz::experimental::CachedDamerauLevenshtein<wchar_t>>(
+                bench, "CachedDamerauLevenshtein", damerau_levenshtein_paths);
+            register_cached<rapidfuzz::CachedOSA<wchar_t>>(bench, "CachedOSA", osa_paths);
+        }
+    }
+}
+
+/* corpora mixing lengths like real data, so the kernel changes between the pairs */
+static void register_mixed(const std::string& alphabet, std::shared_ptr<const corpus::Corpus> data,
+                           double similarity)
+{
+    for (size_t score_cutoff : {size_t(8), no_cutoff}) {
+        BenchCase bench{data, alphabet, "mixed", similarity, score_cutoff};
+        register_levenshtein(bench, "mixed");
+        register_cached<rapidfuzz::CachedLevenshtein<wchar_t>>(bench, "CachedLevenshtein", levenshtein_paths,
+                                                               "mixed");
+        register_cached<rapidfuzz::CachedIndel<wchar_t>>(bench, "CachedIndel", indel_paths, "mixed");
+    }
+}
+
+static void register_benchmarks(const std::string& corpus_path)
+{
+    const corpus::Alphabet alphabets[] = {corpus::Alphabet::ASCII, corpus::Alphabet::Latin1,
+                                          corpus::Alphabet::CJK};
+    const double similarities[] = {0.9, 0.5};
+
+    for (auto alphabet : alphabets) {
+        for (double similarity : similarities) {
+            register_length_sweep(alphabet, similarity);
+#ifdef RAPIDFUZZ_SIMD
+            register_simd<8>(alphabet, similarity);
+            register_simd<16>(alphabet, similarity);
+            register_simd<32>(alphabet, similarity);
+            register_simd<64>(alphabet, similarity);
+            register_simd<128>(alphabet, similarity);
+#endif
+        }
+
+        register_damerau_levenshtein(alphabet);
+
+        /* lengths of names and titles */
+        corpus::Config config;
+        config.alphabet = alphabet;
+        config.length_distribution = corpus::LengthDistribution::LogNormal;
+        config.min_len = 1;
+        config.max_len = 512;
+        config.median_len = 24;
+        config.sigma = 0.7;
+        config.similarity = 0.8;
+        auto generated = std::make_shared<const corpus::Corpus>(corpus::generate(config));
+        register_mixed(corpus::to_string(alphabet), generated, config.similarity);
+    }
+
+    if (!corpus_path.empty()) {
+        corpus::Config config;
+        config.max_len = 4096;
+        config.similarity = 0.8;
+        config.count = 10000;
+        auto loaded = std::make_shared<const corpus::Corpus>(corpus::load(corpus_path, config));
+        register_mixed("file", loaded, config.similarity);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+
+    std::string corpus_path;
+    std::string kernels_path;
+    int remaining = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--corpus=", 9) == 0)
+            corpus_path = argv[i] + 9;
+        else if (std::strncmp(argv[i], "--kernels=", 10) == 0)
+            kernels_path = argv[i] + 10;
+        else
+            argv[remaining++] = argv[i];
+    }
+    if (benchmark::ReportUnrecognizedArguments(remaining, argv)) return 1;
+
+    if (kernels_path.empty()) {
+        std::cerr << "usage: " << argv[0] << " --kernels=<path> [--corpus=<path>] [benchmark options]\n"
+                  << "the kernels file is written by bench_corpus_kernels --kernels=<path>" << std::endl;
+        return 1;
+    }
+
+    try {
+#ifdef RAPIDFUZZ_ENABLE_STATS
+        open_kernels(kernels_path);
+#else
+        load_kernels(kernels_path);
+#endif
+        register_benchmarks(corpus_path);
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    /* bench_corpus_kernels only names the kernels */
+#ifndef RAPIDFUZZ_ENABLE_STATS
+    benchmark::RunSpecifiedBenchmarks();
+#endif
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,355 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <rapidfuzz/distance.hpp>
+#include <rapidfuzz/fuzz.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "corpus.hpp"
+
+/*
+ * Shares a single scorer between a growing number of threads and reports the latency distribution
+ * of the requests and the throughput compared to a single thread. Unlike the Google Benchmark targets
+ * this shows effects like false sharing, contention in the allocator and the limits of the memory
+ * bandwidth. Every request scores one query with the length distribution of names and titles.
+ *
+ * Every thread count is measured without a Workspace, so the temporary buffers of the scorers use the
+ * allocator, and with a Workspace bound in every thread.
+ *
+ * options:
+ *     --threads=<n>      maximum amount of threads (default: all cores)
+ *     --duration=<ms>    duration of every measurement (default: 1000)
+ *     --scorer=<name>    only run scorers containing name
+ *     --no_workspace     only measure without a Workspace
+ *     --workspace        only measure with a Workspace
+ *
+ * The latencies include the overhead of reading std::chrono::steady_clock twice per request. They are
+ * recorded in a histogram, so the percentiles are rounded to about 3%.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    size_t max_threads = 0;
+    size_t duration_ms = 1000;
+    std::string scorer_filter;
+    bool without_workspace = true;
+    bool with_workspace = true;
+};
+
+/* scores the query with the given index and returns a value, so the call can't be optimized away */
+using Request = std::function<double(size_t)>;
+
+struct Workload {
+    std::string name;
+    /* called once in every thread, so requests can use thread local buffers */
+    std::function<Request()> make_request;
+};
+
+/*
+ * log-linear histogram of the latencies in ns. Values below 32 have their own bucket and every larger
+ * power of two is split into 32 buckets. It has a fixed size, so recording doesn't allocate while
+ * measuring
+ */
+class LatencyHistogram {
+public:
+    LatencyHistogram() : m_counts(), m_total(0)
+    {}
+
+    void record(uint64_t value) noexcept
+    {
+        ++m_counts[index(value)];
+        ++m_total;
+    }
+
+    void merge(const LatencyHistogram& other) noexcept
+    {
+        for (size_t i = 0; i < bucket_count; ++i)
+            m_counts[i] += other.m_counts[i];
+        m_total += other.m_total;
+    }
+
+    uint64_t total() const noexcept
+    {
+        return m_total;
+    }
+
+    /* middle of the bucket containing the quantile */
+    uint64_t percentile(double quantile) const noexcept
+    {
+        if (!m_total) return 0;
+        auto rank = static_cast<uint64_t>(quantile * static_cast<double>(m_total - 1));
+        uint64_t count = 0;
+        for (size_t i = 0; i < bucket_count; ++i) {
+            count += m_counts[i];
+            if (count > rank) return bucket_middle(i);
+        }
+        return bucket_middle(bucket_count - 1);
+    }
+
+private:
+    static constexpr int sub_bits = 5;
+    static constexpr uint64_t sub_buckets = 1 << sub_bits;
+    static constexpr size_t bucket_count = (64 - sub_bits + 1) * sub_buckets;
+
+    static size_t index(uint64_t value) noexcept
+    {
+        if (value < sub_buckets) return static_cast<size_t>(value);
+
+        int shift = 63 - __builtin_clzll(value) - sub_bits;
+        return static_cast<size_t>((static_cast<uint64_t>(shift) + 1) * sub_buckets + (value >> shift) -
+                                   sub_buckets);
+    }
+
+    static uint64_t bucket_middle(size_t index) noexcept
+    {
+        if (index < sub_buckets) return index;
+
+        int shift = static_cast<int>(index / sub_buckets) - 1;
+        uint64_t lower = (sub_buckets + index % sub_buckets) << shift;
+        return lower + ((UINT64_C(1) << shift) >> 1);
+    }
+
+    std::array<uint64_t, bucket_count> m_counts;
+    uint64_t m_total;
+};
+
+struct ThreadResult {
+    LatencyHistogram latencies;
+    double sink = 0;
+};
+
+/* keeps the results of the threads on separate cache lines */
+struct PaddedResult {
+    ThreadResult result;
+    char padding[64];
+};
+
+struct Measurement {
+    size_t threads;
+    bool workspace;
+    double requests_per_second;
+    uint64_t p50;
+    uint64_t p99;
+    uint64_t p999;
+};
+
+static void run_thread(const Workload& workload, const corpus::Corpus& corpus, size_t thread_id,
+                       bool use_workspace, std::atomic<size_t>& ready, const std::atomic<bool>& start,
+                       const std::atomic<bool>& stop, ThreadResult& result)
+{
+    rapidfuzz::Workspace workspace;
+    std::unique_ptr<rapidfuzz::WorkspaceGuard> guard;
+    if (use_workspace) guard.reset(new rapidfuzz::WorkspaceGuard(workspace));
+
+    Request request = workload.make_request();
+
+    /* warm up the workspace and the caches before the measurement starts */
+    for (size_t i = 0; i < std::min<size_t>(corpus.queries.size(), 64); ++i)
+        result.sink += request(i);
+
+    ++ready;
+    while (!start.load(std::memory_order_acquire))
+        std::this_thread::yield();
+
+    /* the threads start at different queries, so they don't process the same request at the same time */
+    size_t query = (thread_id * 7919) % corpus.queries.size();
+    while (!stop.load(std::memory_order_relaxed)) {
+        auto begin = Clock::now();
+        result.sink += request(query);
+        auto end = Clock::now();
+        result.latencies.record(
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()));
+
+        if (++query == corpus.queries.size()) query = 0;
+    }
+}
+
+static Measurement measure(const Workload& workload, const corpus::Corpus& corpus, size_t thread_count,
+                           bool use_workspace, const Options& options)
+{
+    std::vector<PaddedResult> results(thread_count);
+    std::vector<std::thread> threads;
+    std::atomic<size_t> ready(0);
+    std::atomic<bool> start(false);
+    std::atomic<bool> stop(false);
+
+    for (size_t i = 0; i < thread_count; ++i)
+        threads.emplace_back(run_thread, std::cref(workload), std::cref(corpus), i, use_workspace,
+                             std::ref(ready), std::cref(start), std::cref(stop), std::ref(results[i].result));
+
+    while (ready.load() != thread_count)
+        std::this_thread::yield();
+
+    auto begin = Clock::now();
+    start.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(std::chrono::milliseconds(options.duration_ms));
+    stop.store(true);
+    for (auto& thread : threads)
+        thread.join();
+    double seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+
+    LatencyHistogram latencies;
+    double sink = 0;
+    for (auto& padded : results) {
+        latencies.merge(padded.result.latencies);
+        sink += padded.result.sink;
+    }
+    /* use the results, so the compiler can't remove the requests */
+    if (sink < 0) std::cout << sink << std::endl;
+
+    Measurement measurement;
+    measurement.threads = thread_count;
+    measurement.workspace = use_workspace;
+    measurement.requests_per_second = static_cast<double>(latencies.total()) / seconds;
+    measurement.p50 = latencies.percentile(0.5);
+    measurement.p99 = latencies.percentile(0.99);
+    measurement.p999 = latencies.percentile(0.999);
+    return measurement;
+}
+
+/* 1, 2, 4, ... up to max_threads, which is always included */
+static std::vector<size_t> thread_counts(size_t max_threads)
+{
+    std::vector<size_t> counts;
+    for (size_t count = 1; count < max_threads; count *= 2)
+        counts.push_back(count);
+    counts.push_back(max_threads);
+    return counts;
+}
+
+static void run_workload(const Workload& workload, const corpus::Corpus& corpus, const Options& options)
+{
+    std::printf("\n%s\n", workload.name.c_str());
+    std::printf("%8s %10s %14s %8s %10s %10s %10s\n", "threads", "workspace", "requests/s", "scaling",
+                "p50 ns", "p99 ns", "p999 ns");
+
+    std::vector<bool> modes;
+    if (options.without_workspace) modes.push_back(false);
+    if (options.with_workspace) modes.push_back(true);
+
+    /* throughput of a single thread in every mode */
+    double single_thread[2] = {0, 0};
+    for (size_t thread_count : thread_counts(options.max_threads)) {
+        for (bool use_workspace : modes) {
+            Measurement m = measure(workload, corpus, thread_count, use_workspace, options);
+            if (thread_count == 1) single_thread[use_workspace] = m.requests_per_second;
+
+            double baseline = single_thread[use_workspace];
+            double scaling = baseline ? m.requests_per_second / baseline : 0.0;
+            std::printf("%8zu %10s %14.0f %7.2fx %10llu %10llu %10llu\n", m.threads,
+                        m.workspace ? "yes" : "no", m.requests_per_second, scaling,
+                        static_cast<unsigned long long>(m.p50),
+                        static_cast<unsigned long long>(m.p99), static_cast<unsigned long long>(m.p999));
+            std::fflush(stdout);
+        }
+    }
+}
+
+static std::vector<Workload> make_workloads(std::shared_ptr<const corpus::Corpus> data)
+{
+    std::vector<Workload> workloads;
+
+    /* the scorers are shared by all threads and compare the queries with the first choice */
+    auto levenshtein = std::make_shared<rapidfuzz::CachedLevenshtein<wchar_t>>(data->choices[0]);
+    workloads.push_back({"CachedLevenshtein", [data, levenshtein]() -> Request {
+                             return [data, levenshtein](size_t i) {
+                                 return static_cast<double>(levenshtein->distance(data->queries[i]));
+                             };
+                         }});
+
+    workloads.push_back({"CachedLevenshtein (score_cutoff 4)", [data, levenshtein]() -> Request {
+                             return [data, levenshtein](size_t i) {
+                                 return static_cast<double>(levenshtein->distance(data->queries[i], 4));
+                             };
+                         }});
+
+    auto wratio = std::make_shared<rapidfuzz::fuzz::CachedWRatio<wchar_t>>(data->choices[0]);
+    workloads.push_back({"CachedWRatio", [data, wratio]() -> Request {
+                             return [data, wratio](size_t i) { return wratio->similarity(data->queries[i]); };
+                         }});
+
+#ifdef RAPIDFUZZ_SIMD
+    /* every request compares a query with all choices of up to 64 characters */
+    auto multi = std::make_shared<rapidfuzz::experimental::MultiLevenshtein<64>>(data->choices.size());
+    for (const auto& choice : data->choices)
+        if (choice.size() <= 64) multi->insert(choice);
+
+    workloads.push_back({"MultiLevenshtein<64>", [data, multi]() -> Request {
+                             auto results = std::make_shared<std::vector<size_t>>(multi->result_count());
+                             return [data, multi, results](size_t i) {
+                                 multi->distance(&(*results)[0], results->size(), data->queries[i]);
+                                 return static_cast<double>((*results)[0]);
+                             };
+                         }});
+#endif
+
+    return workloads;
+}
+
+static bool parse_options(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--threads=", 10) == 0)
+            options.max_threads = static_cast<size_t>(std::strtoul(argv[i] + 10, nullptr, 10));
+        else if (std::strncmp(argv[i], "--duration=", 11) == 0)
+            options.duration_ms = static_cast<size_t>(std::strtoul(argv[i] + 11, nullptr, 10));
+        else if (std::strncmp(argv[i], "--scorer=", 9) == 0)
+            options.scorer_filter = argv[i] + 9;
+        else if (std::strcmp(argv[i], "--no_workspace") == 0)
+            options.with_workspace = false;
+        else if (std::strcmp(argv[i], "--workspace") == 0)
+            options.without_workspace = false;
+        else {
+            std::cerr << "unrecognized argument " << argv[i] << std::endl;
+            return false;
+        }
+    }
+
+    if (!options.without_workspace && !options.with_workspace) {
+        std::cerr << "--no_workspace and --workspace exclude each other" << std::endl;
+        return false;
+    }
+
+    if (!options.duration_ms) {
+        std::cerr << "duration has to be at least 1 ms" << std::endl;
+        return false;
+    }
+
+    if (!options.max_threads) options.max_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parse_options(argc, argv, options)) return 1;
+
+    /* names and titles: mostly short strings with a few long outliers */
+    corpus::Config config;
+    config.length_distribution = corpus::LengthDistribution::LogNormal;
+    config.min_len = 1;
+    config.max_len = 256;
+    config.median_len = 24;
+    config.sigma = 0.7;
+    config.similarity = 0.8;
+    config.count = 4096;
+    auto data = std::make_shared<const corpus::Corpus>(corpus::generate(config));
+
+    std::printf("threads: up to %zu, duration: %zu ms\n", options.max_threads, options.duration_ms);
+
+    for (const auto& workload : make_workloads(data))
+        if (workload.name.find(options.scorer_filter) != std::string::npos)
+            run_workload(workload, *data, options);
+
+    return 0;
+}
@@ -0,0 +1,582 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <rapidfuzz/distance.hpp>
+#include <rapidfuzz/fuzz.hpp>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../rapidfuzz_reference/DamerauLevenshtein.hpp"
+#include "../rapidfuzz_reference/Hamming.hpp"
+#include "../rapidfuzz_reference/Indel.hpp"
+#include "../rapidfuzz_reference/Jaro.hpp"
+#include "../rapidfuzz_reference/JaroWinkler.hpp"
+#include "../rapidfuzz_reference/LCSseq.hpp"
+#include "../rapidfuzz_reference/Levenshtein.hpp"
+#include "../rapidfuzz_reference/OSA.hpp"
+#include "../rapidfuzz_reference/fuzz.hpp"
+#include "corpus.hpp"
+
+/*
+ * Compares the optimized implementations with the implementations in rapidfuzz_reference on the
+ * same generated corpora. Before running any benchmark every pair is scored by the optimized
+ * function, the cached scorer and the reference implementation. If any result differs the
+ * mismatches are printed and the program exits with 1. Benchmarks are named
+ *
+ *     <metric>/<rapidfuzz|reference>/<alphabet>/len:<length bucket>/cutoff:<score_cutoff>
+ *
+ * and the speedup of rapidfuzz over the reference implementation is printed for every
+ * metric/alphabet/length bucket/cutoff after all benchmarks ran. --verify_only skips the benchmarks.
+ */
+
+static const size_t no_cutoff = std::numeric_limits<size_t>::max();
+
+static std::string cutoff_name(size_t score_cutoff)
+{
+    return (score_cutoff == no_cutoff) ? "none" : std::to_string(score_cutoff);
+}
+
+static std::string cutoff_name(double score_cutoff)
+{
+    if (score_cutoff == 0.0) return "none";
+    std::ostringstream name;
+    name << score_cutoff;
+    return name.str();
+}
+
+static bool same_result(size_t a, size_t b)
+{
+    return a == b;
+}
+
+/* the floating point calculations are not performed in the same order */
+static bool same_result(double a, double b)
+{
+    return std::fabs(a - b) <= std::max(std::fabs(a), std::fabs(b)) * 0.0001;
+}
+
+/* a similarity matching the cutoff can be rounded to either side of it, so both results are accepted */
+static bool on_cutoff(size_t, size_t)
+{
+    return false;
+}
+
+static bool on_cutoff(double expected, double score_cutoff)
+{
+    return score_cutoff != 0.0 && same_result(expected, score_cutoff);
+}
+
+/* cutoffs selecting the different implementations (e.g. mbleven and the banded implementations) */
+static std::vector<size_t> distance_cutoffs(size_t max_len)
+{
+    std::vector<size_t> cutoffs = {no_cutoff, 2};
+    if (max_len / 4 > 2) cutoffs.push_back(max_len / 4);
+    return cutoffs;
+}
+
+struct Levenshtein {
+    using Cached = rapidfuzz::CachedLevenshtein<wchar_t>;
+
+    static const char* name()
+    {
+        return "Levenshtein";
+    }
+
+    static std::vector<size_t> cutoffs(size_t max_len)
+    {
+        return distance_cutoffs(max_len);
+    }
+
+    static size_t optimized(const std::wstring& s1, const std::wstring& s2, size_t score_cutoff)
+    {
+        return rapidfuzz::levenshtein_distance(s1, s2, {1, 1, 1}, score_cutoff);
+    }
+
+    static size_t cached(const Cached& scorer, const std::wstring& s2, size_t score_cutoff)
+    {
+        return scorer.distance(s2, score_cutoff);
+    }
+
+    static size_t reference(const std::wstring& s1, const std::wstring& s2, size_t score_cutoff)
+    {
+        return rapidfuzz_reference::levenshtein_distance(s1, s2, {1, 1, 1}, score_cutoff);
+    }
+};
+
+struct Indel {
+    using Cached = rapidfuzz::CachedIndel<wchar_t>;
+
+    static const char* name()
+    {
+        return "Indel";
+    }
+
+    static std::vector<size_t> cutoffs(size_t max_len)
+    {
+        return distance_cutoffs(max_len);
+    }
+
+    static size_t optimized(const std::wstring& s1, const std::wstring& s2, size_t score_cutoff)
+    {
+        return rapidfuzz::indel_distance(s1, s2, score_cutoff);
+    }
+
+    static size_t cached(const Cached& scorer, const std::wstring& s2, size_t score_cutoff)
+    {
+        return scorer.distance(s2, score_cutoff);
+    }
+
+    static size_t reference(const std::wstring& s1, const std::wstring& s2, size_t score_cutoff)
+    {
+        return rapidfuzz_reference::indel_distance(s1, s2, score_cutoff);
+    }
+};
+
+struct LCSseq {
+    using Cached = rapidfuzz::CachedLCSseq<wchar_t>;
+
+    static const char* name()
+    {
+        return "LCSseq";
+    }
+
+    static std::vector<size_t> cutoffs(size_t max_len)
+    {
+        return {0, max_len / 2};
+    }
+
+    static size_t optimized(const std::wstring& s1, const std::wstring& s2, size_t score_cutoff)
+    {
+        return rapidfuzz::lcs_seq_similarity(s1, s2, score_cutoff);
+    }
+
+    static size_t cached(const Cached& scorer, const std::wstring& s2, size_t score_cutoff)
+    {
+        return scorer.similarity(s2, score_cutoff);
+    }
+
+    static size_t reference(const std::wstring& s1, const std::wstring& s2, size_t score_cutoff)
+    {
+        return rapidfuzz_reference::lcs_seq_similarity(s1, s2, score_cutoff);
+    }
+};
+
+struct OSA {
+    using Cached = rapidfuzz::CachedOSA<wchar_t>;
+
+    static const char* name()
+    {
+        return "OSA";
+    }
+
+    static std::vector<size_t> cutoffs(size_t max_len)
+    {
+        return distance_cutoffs(max_len);
+    }
+
+    static size_t optimized(const std::wstring& s1, const std::wstring& s2, size_t score_cutoff)
+    {
+        return rapidfuzz::osa_distance(s1, s2, score_cutoff);
+    }
+
+    static size_t cached(const Cached& scorer, const std::wstring& s2, size_t score_cutoff)
+    {
+        return scorer.distance(s2, score_cutoff);
+    }
+
+    static size_t reference(const std::wstring& s1, const std::wstring& s2, size_t score_cutoff)
+    {
+        return rapidfuzz_reference::osa_distance(s1, s2, score_cutoff);
+    }
+};
+
+struct DamerauLevenshtein {
+    using Cached = rapidfuzz::experimental::CachedDamerauLevenshtein<wchar_t>;
+
+    static const char* name()
+    {
+        return "DamerauLevenshtein";
+    }
+
+    static std::vector<size_t> cutoffs(size_t max_len)
+    {
+        return distance_cutoffs(max_len);
+    }
+
+    static size_t optimized(const std::wstring& s1, const std::wstring& s2, size_t score_cutoff)
+    {
+        return rapidfuzz::experimental::damerau_levenshtein_distance(s1, s2, score_cutoff);
+    }
+
+    static size_t cached(const Cached& scorer, const std::wstring& s2, size_t score_cutoff)
+    {
+        return scorer.distance(s2, score_cutoff);
+    }
+
+    static size_t reference(const std::wstring& s1, const std::wstring& s2, size_t score_cutoff)
+    {
+        return rapidfuzz_reference::damerau_levenshtein_distance(s1, s2, score_cutoff);
+    }
+};
+
+struct Jaro {
+    using Cached = rapidfuzz::CachedJaro<wchar_t>;
+
+    static const char* name()
+    {
+        return "Jaro";
+    }
+
+    static std::vector<double> cutoffs(size_t)
+    {
+        return {0.0, 0.9};
+    }
+
+    static double optimized(const std::wstring& s1, const std::wstring& s2, double score_cutoff)
+    {
+        return rapidfuzz::jaro_similarity(s1, s2, score_cutoff);
+    }
+
+    static double cached(const Cached& scorer, const std::wstring& s2, double score_cutoff)
+    {
+        return scorer.similarity(s2, score_cutoff);
+    }
+
+    static double reference(const std::wstring& s1, const std::wstring& s2, double score_cutoff)
+    {
+        return rapidfuzz_reference::jaro_similarity(s1, s2, score_cutoff);
+    }
+};
+
+struct JaroWinkler {
+    using Cached = rapidfuzz::CachedJaroWinkler<wchar_t>;
+
+    static const char* name()
+    {
+        return "JaroWinkler";
+    }
+
+    static std::vector<double> cutoffs(size_t)
+    {
+        return {0.0, 0.9};
+    }
+
+    static double optimized(const std::wstring& s1, const std::wstring& s2, double score_cutoff)
+    {
+        return rapidfuzz::jaro_winkler_similarity(s1, s2, 0.1, score_cutoff);
+    }
+
+    static double cached(const Cached& scorer, const std::wstring& s2, double score_cutoff)
+    {
+        return scorer.similarity(s2, score_cutoff);
+    }
+
+    static double reference(const std::wstring& s1, const std::wstring& s2, double score_cutoff)
+    {
+        return rapidfuzz_reference::jaro_winkler_similarity(s1, s2, 0.1, score_cutoff);
+    }
+};
+
+/* only defined for strings of the same length, so the pairs are truncated (see equal_length) */
+struct Hamming {
+    using Cached = rapidfuzz::CachedHamming<wchar_t>;
+
+    static const char* name()
+    {
+        return "Hamming";
+    }
+
+    static std::vector<size_t> cutoffs(size_t)
+    {
+        return {no_cutoff, 2};
+    }
+
+    static size_t optimized(const std::wstring& s1, const std::wstring& s2, size_t score_cutoff)
+    {
+        return rapidfuzz::hamming_distance(s1, s2, false, score_cutoff);
+    }
+
+    static size_t cached(const Cached& scorer, const std::wstring& s2, size_t score_cutoff)
+    {
+        return scorer.distance(s2, score_cutoff);
+    }
+
+    static size_t reference(const std::wstring& s1, const std::wstring& s2, size_t score_cutoff)
+    {
+        return rapidfuzz_reference::hamming_distance(s1.begin(), s1.end(), s2.begin(), s2.end(),
+                                                     score_cutoff);
+    }
+};
+
+template <typename Metric>
+struct equal_length : std::false_type {};
+
+template <>
+struct equal_length<Hamming> : std::true_type {};
+
+struct Ratio {
+    using Cached = rapidfuzz::fuzz::CachedRatio<wchar_t>;
+
+    static const char* name()
+    {
+        return "ratio";
+    }
+
+    static std::vector<double> cutoffs(size_t)
+    {
+        return {0.0, 90.0};
+    }
+
+    static double optimized(const std::wstring& s1, const std::wstring& s2, double score_cutoff)
+    {
+        return rapidfuzz::fuzz::ratio(s1, s2, score_cutoff);
+    }
+
+    static double cached(const Cached& scorer, const std::wstring& s2, double score_cutoff)
+    {
+        return scorer.similarity(s2, score_cutoff);
+    }
+
+    static double reference(const std::wstring& s1, const std::wstring& s2, double score_cutoff)
+    {
+        return rapidfuzz_reference::ratio(s1, s2, score_cutoff);
+    }
+};
+
+struct PartialRatio {
+    using Cached = rapidfuzz::fuzz::CachedPartialRatio<wchar_t>;
+
+    static const char* name()
+    {
+        return "partial_ratio";
+    }
+
+    static std::vector<double> cutoffs(size_t)
+    {
+        return {0.0, 90.0};
+    }
+
+    static double optimized(const std::wstring& s1, const std::wstring& s2, double score_cutoff)
+    {
+        return rapidfuzz::fuzz::partial_ratio(s1, s2, score_cutoff);
+    }
+
+    static double cached(const Cached& scorer, const std::wstring& s2, double score_cutoff)
+    {
+        return scorer.similarity(s2, score_cutoff);
+    }
+
+    static double reference(const std::wstring& s1, const std::wstring& s2, double score_cutoff)
+    {
+        return rapidfuzz_reference::partial_ratio(s1, s2, score_cutoff);
+    }
+};
+
+struct LengthBucket {
+    size_t min_len;
+    size_t max_len;
+
+    std::string name() const
+    {
+        return std::to_string(min_len) + "-" + std::to_string(max_len);
+    }
+};
+
+/* the bucket borders are the lengths where the implementations switch to more blocks */
+static const LengthBucket length_buckets[] = {{1, 8}, {9, 32}, {33, 64}, {65, 256}, {257, 1024}};
+
+static std::string case_name(const std::string& metric, const std::string& impl, corpus::Alphabet alphabet,
+                             const LengthBucket& bucket, const std::string& cutoff)
+{
+    return metric + "/" + impl + "/" + corpus::to_string(alphabet) + "/len:" + bucket.name() +
+           "/cutoff:" + cutoff;
+}
+
+/* amount of mismatches printed per metric before only counting them */
+static const size_t max_printed_mismatches = 10;
+
+template <typename Metric, typename CutoffType>
+static size_t verify(const corpus::Corpus& corpus, const std::string& name, CutoffType score_cutoff)
+{
+    size_t mismatches = 0;
+    for (size_t i = 0; i < corpus.choices.size(); ++i) {
+        const std::wstring& s1 = corpus.choices[i];
+        const std::wstring& s2 = corpus.queries[i];
+        typename Metric::Cached scorer(s1);
+
+        auto expected = Metric::reference(s1, s2, score_cutoff);
+        auto result = Metric::optimized(s1, s2, score_cutoff);
+        auto cached_result = Metric::cached(scorer, s2, score_cutoff);
+        if (same_result(result, expected) && same_result(cached_result, expected)) continue;
+        if (on_cutoff(expected, score_cutoff)) continue;
+
+        if (++mismatches <= max_printed_mismatches)
+            std::cerr << name << ": pair " << i << " (len " << s1.size() << "/" << s2.size()
+                      << ") reference = " << expected << ", rapidfuzz = " << result
+                      << ", cached = " << cached_result << std::endl;
+    }
+    return mismatches;
+}
+
+template <typename Func>
+static void register_case(const std::string& name, std::shared_ptr<const corpus::Corpus> data, Func func)
+{
+    benchmark::RegisterBenchmark(name.c_str(), [data, func](benchmark::State& state) {
+        const corpus::Corpus& corpus = *data;
+        for (auto _ : state)
+            for (size_t i = 0; i < corpus.choices.size(); ++i)
+                benchmark::DoNotOptimize(func(corpus.choices[i], corpus.queries[i]));
+
+        state.counters["pairs/s"] =
+            benchmark::Counter(static_cast<double>(state.iterations() * corpus.choices.size()),
+                               benchmark::Counter::kIsRate);
+    });
+}
+
+/**
+ * verifies the metric on all corpora and registers a rapidfuzz and a reference benchmark for each of
+ * them. Returns the amount of mismatches
+ */
+template <typename Metric>
+static size_t add_metric(corpus::Alphabet alphabet, size_t max_len, bool verify_only)
+{
+    size_t mismatches = 0;
+    for (const auto& bucket : length_buckets) {
+        if (bucket.min_len > max_len) break;
+
+        corpus::Config config;
+        config.alphabet = alphabet;
+        config.min_len = bucket.min_len;
+        config.max_len = bucket.max_len;
+        config.similarity = 0.8;
+        /* the reference implementations are quadratic, so use fewer pairs for long strings */
+        config.count = std::max<size_t>(16, 16384 / bucket.max_len);
+        corpus::Corpus generated = corpus::generate(config);
+        if (equal_length<Metric>::value) {
+            for (size_t i = 0; i < generated.choices.size(); ++i) {
+                size_t len = std::min(generated.choices[i].size(), generated.queries[i].size());
+                generated.choices[i].resize(len);
+                generated.queries[i].resize(len);
+            }
+        }
+        auto data = std::make_shared<const corpus::Corpus>(std::move(generated));
+
+        for (auto score_cutoff : Metric::cutoffs(bucket.max_len)) {
+            std::string cutoff = cutoff_name(score_cutoff);
+            std::string name = case_name(Metric::name(), "rapidfuzz", alphabet, bucket, cutoff);
+            mismatches += verify<Metric>(*data, name, score_cutoff);
+            if (verify_only) continue;
+
+            register_case(name, data, [score_cutoff](const std::wstring& s1, const std::wstring& s2) {
+                return Metric::optimized(s1, s2, score_cutoff);
+            });
+            register_case(case_name(Metric::name(), "reference", alphabet, bucket, cutoff), data,
+                          [score_cutoff](const std::wstring& s1, const std::wstring& s2) {
+                              return Metric::reference(s1, s2, score_cutoff);
+                          });
+        }
+    }
+    return mismatches;
+}
+
+static size_t add_metrics(bool verify_only)
+{
+    size_t mismatches = 0;
+    for (auto alphabet : {corpus::Alphabet::ASCII, corpus::Alphabet::CJK}) {
+        mismatches += add_metric<Levenshtein>(alphabet, 1024, verify_only);
+        mismatches += add_metric<Indel>(alphabet, 1024, verify_only);
+        mismatches += add_metric<LCSseq>(alphabet, 1024, verify_only);
+        mismatches += add_metric<OSA>(alphabet, 1024, verify_only);
+        mismatches += add_metric<DamerauLevenshtein>(alphabet, 1024, verify_only);
+        mismatches += add_metric<Hamming>(alphabet, 1024, verify_only);
+        mismatches += add_metric<Jaro>(alphabet, 1024, verify_only);
+        mismatches += add_metric<JaroWinkler>(alphabet, 1024, verify_only);
+        mismatches += add_metric<Ratio>(alphabet, 1024, verify_only);
+        /* the reference implementation of partial_ratio is cubic */
+        mismatches += add_metric<PartialRatio>(alphabet, 64, verify_only);
+    }
+    return mismatches;
+}
+
+/* prints the benchmarks like the console reporter followed by the speedup over the reference */
+class SpeedupReporter : public benchmark::ConsoleReporter {
+public:
+    void ReportRuns(const std::vector<Run>& reports) override
+    {
+        benchmark::ConsoleReporter::ReportRuns(reports);
+        for (const auto& run : reports) {
+            if (run.run_type != Run::RT_Iteration) continue;
+
+            /* <metric>/<impl>/<rest> */
+            std::string name = run.benchmark_name();
+            size_t metric_end = name.find('/');
+            size_t impl_end = name.find('/', metric_end + 1);
+            if (metric_end == std::string::npos || impl_end == std::string::npos) continue;
+
+            std::string key = name.substr(0, metric_end) + name.substr(impl_end);
+            if (!m_timings.count(key)) m_order.push_back(key);
+            Timing& timing = m_timings[key];
+            if (name.compare(metric_end + 1, impl_end - metric_end - 1, "reference") == 0)
+                timing.reference += run.GetAdjustedRealTime();
+            else
+                timing.rapidfuzz += run.GetAdjustedRealTime();
+        }
+    }
+
+    void Finalize() override
+    {
+        std::ostream& out = GetOutputStream();
+        out << "\nspeedup over rapidfuzz_reference\n";
+        for (const auto& key : m_order) {
+            const Timing& timing = m_timings[key];
+            if (timing.rapidfuzz <= 0.0 || timing.reference <= 0.0) continue;
+            out << key << ": " << timing.reference / timing.rapidfuzz << "x\n";
+        }
+        benchmark::ConsoleReporter::Finalize();
+    }
+
+private:
+    struct Timing {
+        double rapidfuzz = 0.0;
+        double reference = 0.0;
+    };
+
+    std::map<std::string, Timing> m_timings;
+    /* keys in the order the benchmarks ran */
+    std::vector<std::string> m_order;
+};
+
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+
+    bool verify_only = false;
+    int remaining = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--verify_only") == 0)
+            verify_only = true;
+        else
+            argv[remaining++] = argv[i];
+    }
+    if (benchmark::ReportUnrecognizedArguments(remaining, argv)) return 1;
+
+    size_t mismatches = add_metrics(verify_only);
+    if (mismatches) {
+        std::cerr << mismatches << " results differ from rapidfuzz_reference" << std::endl;
+        return 1;
+    }
+    std::cout << "all results match rapidfuzz_reference" << std::endl;
+    if (verify_only) return 0;
+
+    SpeedupReporter reporter;
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,246 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*
+ * Generates the corpora used by the benchmarks. All strings are stored as std::wstring, so
+ * the same corpus can contain ASCII, Latin-1 and CJK characters.
+ */
+namespace corpus {
+
+enum class Alphabet {
+    /* lowercase and uppercase letters, digits and space */
+    ASCII,
+    /* lowercase letters mixed with the accented characters of Latin-1 */
+    Latin1,
+    /* CJK Unified Ideographs, which are stored in the hashmap of the pattern match vectors */
+    CJK
+};
+
+enum class LengthDistribution {
+    /* lengths between min_len and max_len with the same probability */
+    Uniform,
+    /* lognormal distribution around median_len clamped to [min_len, max_len] like names or titles */
+    LogNormal
+};
+
+struct Config {
+    Alphabet alphabet = Alphabet::ASCII;
+    /* amount of distinct characters used. 0 uses the whole alphabet */
+    size_t alphabet_size = 0;
+
+    LengthDistribution length_distribution = LengthDistribution::Uniform;
+    size_t min_len = 16;
+    size_t max_len = 16;
+    size_t median_len = 16;
+    double sigma = 0.5;
+
+    /* share of characters of a choice kept in the matching query. The rest is edited randomly */
+    double similarity = 0.9;
+    size_t count = 1000;
+    uint32_t seed = 42;
+};
+
+struct Corpus {
+    /* strings the queries are compared with */
+    std::vector<std::wstring> choices;
+    /* queries[i] is created by editing choices[i] */
+    std::vector<std::wstring> queries;
+
+    size_t max_choice_len() const
+    {
+        size_t len = 0;
+        for (const auto& choice : choices)
+            len = std::max(len, choice.size());
+        return len;
+    }
+};
+
+inline const char* to_string(Alphabet alphabet)
+{
+    switch (alphabet) {
+    case Alphabet::ASCII: return "ascii";
+    case Alphabet::Latin1: return "latin1";
+    case Alphabet::CJK: return "cjk";
+    }
+    return "unknown";
+}
+
+inline std::vector<wchar_t> alphabet_chars(Alphabet alphabet, size_t alphabet_size)
+{
+    std::vector<wchar_t> chars;
+    switch (alphabet) {
+    case Alphabet::ASCII:
+        for (wchar_t ch = L'a'; ch <= L'z'; ++ch)
+            chars.push_back(ch);
+        for (wchar_t ch = L'A'; ch <= L'Z'; ++ch)
+            chars.push_back(ch);
+        for (wchar_t ch = L'0'; ch <= L'9'; ++ch)
+            chars.push_back(ch);
+        chars.push_back(L' ');
+        break;
+    case Alphabet::Latin1:
+        /* interleave, so small alphabets still contain both */
+        for (wchar_t i = 0; i < 32; ++i) {
+            if (i < 26) chars.push_back(static_cast<wchar_t>(L'a' + i));
+            chars.push_back(static_cast<wchar_t>(0xE0 + i));
+        }
+        break;
+    case Alphabet::CJK:
+        for (wchar_t ch = 0x4E00; ch < 0x4E00 + 2048; ++ch)
+            chars.push_back(ch);
+        break;
+    }
+
+    if (alphabet_size && alphabet_size < chars.size()) chars.resize(alphabet_size);
+    return chars;
+}
+
+class Generator {
+public:
+    explicit Generator(const Config& config)
+        : m_config(config),
+          m_chars(alphabet_chars(config.alphabet, config.alphabet_size)),
+          m_engine(config.seed)
+    {
+        if (config.min_len > config.max_len) throw std::invalid_argument("min_len has to be <= max_len");
+    }
+
+    size_t length()
+    {
+        if (m_config.length_distribution == LengthDistribution::LogNormal) {
+            std::lognormal_distribution<double> dist(std::log(static_cast<double>(m_config.median_len)),
+                                                     m_config.sigma);
+            auto len = static_cast<size_t>(std::lround(dist(m_engine)));
+            return std::min(std::max(len, m_config.min_len), m_config.max_len);
+        }
+
+        std::uniform_int_distribution<size_t> dist(m_config.min_len, m_config.max_len);
+        return dist(m_engine);
+    }
+
+    wchar_t character()
+    {
+        std::uniform_int_distribution<size_t> dist(0, m_chars.size() - 1);
+        return m_chars[dist(m_engine)];
+    }
+
+    std::wstring string(size_t len)
+    {
+        std::wstring str;
+        for (size_t i = 0; i < len; ++i)
+            str += character();
+        return str;
+    }
+
+    /* applies round((1 - similarity) * len) random insertions, deletions and substitutions */
+    std::wstring edit(std::wstring str, size_t max_len)
+    {
+        double edit_share = 1.0 - m_config.similarity;
+        auto edits = static_cast<size_t>(std::lround(edit_share * static_cast<double>(str.size())));
+        std::uniform_int_distribution<int> op_dist(0, 2);
+        for (size_t i = 0; i < edits; ++i) {
+            int op = op_dist(m_engine);
+            if (str.empty() || (op == 0 && str.size() < max_len)) {
+                std::uniform_int_distribution<size_t> pos(0, str.size());
+                str.insert(str.begin() + static_cast<ptrdiff_t>(pos(m_engine)), character());
+            }
+            else {
+                std::uniform_int_distribution<size_t> pos(0, str.size() - 1);
+                auto iter = str.begin() + static_cast<ptrdiff_t>(pos(m_engine));
+                if (op == 1)
+                    str.erase(iter);
+                else
+                    *iter = character();
+            }
+        }
+        return str;
+    }
+
+private:
+    Config m_config;
+    std::vector<wchar_t> m_chars;
+    std::mt19937 m_engine;
+};
+
+/* queries never exceed max_len, so they can be used with the Multi* scorers of the same MaxLen */
+inline Corpus generate(const Config& config)
+{
+    Generator gen(config);
+    Corpus corpus;
+    for (size_t i = 0; i < config.count; ++i) {
+        corpus.choices.push_back(gen.string(gen.length()));
+        corpus.queries.push_back(gen.edit(corpus.choices.back(), config.max_len));
+    }
+    return corpus;
+}
+
+/* decodes UTF-8. Invalid sequences are replaced with U+FFFD */
+inline std::wstring decode_utf8(const std::string& str)
+{
+    std::wstring res;
+    for (size_t i = 0; i < str.size();) {
+        auto byte = static_cast<unsigned char>(str[i]);
+        size_t extra = 4;
+        if (byte < 0x80)
+            extra = 0;
+        else if ((byte >> 5) == 0x6)
+            extra = 1;
+        else if ((byte >> 4) == 0xE)
+            extra = 2;
+        else if ((byte >> 3) == 0x1E)
+            extra = 3;
+
+        bool valid = extra < 4 && i + extra < str.size();
+        for (size_t j = 1; valid && j <= extra; ++j)
+            valid = (static_cast<unsigned char>(str[i + j]) >> 6) == 0x2;
+
+        if (!valid) {
+            res += static_cast<wchar_t>(0xFFFD);
+            ++i;
+            continue;
+        }
+
+        uint32_t code = extra ? (byte & (0x3F >> extra)) : byte;
+        for (size_t j = 1; j <= extra; ++j)
+            code = (code << 6) | (static_cast<unsigned char>(str[i + j]) & 0x3F);
+
+        /* wchar_t is only 16 bit on windows */
+        if (sizeof(wchar_t) == 2 && code > 0xFFFF) code = 0xFFFD;
+        res += static_cast<wchar_t>(code);
+        i += extra + 1;
+    }
+    return res;
+}
+
+/**
+ * loads the lines of a UTF-8 file as choices. The queries are created by editing them according to
+ * config.similarity. Lines longer than config.max_len are skipped
+ */
+inline Corpus load(const std::string& path, const Config& config)
+{
+    std::ifstream file(path);
+    if (!file) throw std::runtime_error("can't open corpus " + path);
+
+    Generator gen(config);
+    Corpus corpus;
+    std::string line;
+    while (std::getline(file, line) && corpus.choices.size() < config.count) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        std::wstring choice = decode_utf8(line);
+        if (choice.size() > config.max_len) continue;
+
+        corpus.choices.push_back(choice);
+        corpus.queries.push_back(gen.edit(choice, config.max_len));
+    }
+    if (corpus.choices.empty()) throw std::runtime_error("corpus " + path + " contains no usable lines");
+    return corpus;
+}
+
+} // namespace corpus
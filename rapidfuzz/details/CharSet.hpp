@@ -53,20 +53,26 @@ struct CharSet<CharT1, 1> {
 
 template <typename CharT1, size_t size>
 struct CharSet {
+    /* characters below 256 are stored in a lookup table, since they are the most common ones */
+    std::array<bool, 256> m_extendedAscii;
     std::unordered_set<CharT1> m_val;
 
-    CharSet() : m_val{}
+    CharSet() : m_extendedAscii{}, m_val{}
     {}
 
     void insert(CharT1 ch)
     {
-        m_val.insert(ch);
+        if (CanTypeFitValue<uint8_t>(ch))
+            m_extendedAscii[static_cast<uint8_t>(ch)] = true;
+        else
+            m_val.insert(ch);
     }
 
     template <typename CharT2>
     bool find(CharT2 ch) const
     {
         if (!CanTypeFitValue<CharT1>(ch)) return false;
+        if (CanTypeFitValue<uint8_t>(ch)) return m_extendedAscii[static_cast<uint8_t>(ch)];
 
         return m_val.find(CharT1(ch)) != m_val.end();
     }
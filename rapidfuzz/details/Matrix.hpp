@@ -8,6 +8,8 @@
 #include <stdio.h>
 #include <vector>
 
+#include <rapidfuzz/details/Workspace.hpp>
+
 namespace rapidfuzz {
 namespace detail {
 
@@ -43,22 +45,23 @@ struct BitMatrix {
 
     using value_type = T;
 
-    BitMatrix() : m_rows(0), m_cols(0), m_matrix(nullptr)
+    BitMatrix() : m_rows(0), m_cols(0), m_matrix(nullptr), m_owner(true)
     {}
 
-    BitMatrix(size_t rows, size_t cols, T val) : m_rows(rows), m_cols(cols), m_matrix(nullptr)
+    BitMatrix(size_t rows, size_t cols, T val) : m_rows(rows), m_cols(cols), m_matrix(nullptr), m_owner(true)
     {
         if (m_rows && m_cols) m_matrix = new T[m_rows * m_cols];
         std::fill_n(m_matrix, m_rows * m_cols, val);
     }
 
-    BitMatrix(const BitMatrix& other) : m_rows(other.m_rows), m_cols(other.m_cols), m_matrix(nullptr)
+    BitMatrix(const BitMatrix& other)
+        : m_rows(other.m_rows), m_cols(other.m_cols), m_matrix(nullptr), m_owner(true)
     {
         if (m_rows && m_cols) m_matrix = new T[m_rows * m_cols];
         std::copy(other.m_matrix, other.m_matrix + m_rows * m_cols, m_matrix);
     }
 
-    BitMatrix(BitMatrix&& other) noexcept : m_rows(0), m_cols(0), m_matrix(nullptr)
+    BitMatrix(BitMatrix&& other) noexcept : m_rows(0), m_cols(0), m_matrix(nullptr), m_owner(true)
     {
         other.swap(*this);
     }
@@ -82,11 +85,45 @@ struct BitMatrix {
         swap(m_rows, rhs.m_rows);
         swap(m_cols, rhs.m_cols);
         swap(m_matrix, rhs.m_matrix);
+        swap(m_owner, rhs.m_owner);
     }
 
     ~BitMatrix()
     {
-        delete[] m_matrix;
+        if (m_owner) delete[] m_matrix;
+    }
+
+    /**
+     * read only matrix using the \p rows * \p cols elements stored in \p data, which have to outlive it.
+     * Copies of the view own their elements
+     */
+    static BitMatrix view(const T* data, size_t rows, size_t cols) noexcept
+    {
+        BitMatrix matrix;
+        matrix.m_rows = rows;
+        matrix.m_cols = cols;
+        matrix.m_matrix = const_cast<T*>(data);
+        matrix.m_owner = false;
+        return matrix;
+    }
+
+    /**
+     * matrix taking its elements from the bound Workspace, so it must not outlive the current
+     * ScratchFrame. Without a bound Workspace the elements are allocated on the heap.
+     * Copies of the matrix own their elements
+     */
+    static BitMatrix scratch(size_t rows, size_t cols, T val)
+    {
+        ScratchAllocator<T> allocator;
+        if (!allocator.uses_workspace()) return BitMatrix(rows, cols, val);
+
+        BitMatrix matrix;
+        matrix.m_rows = rows;
+        matrix.m_cols = cols;
+        if (rows && cols) matrix.m_matrix = allocator.allocate(rows * cols);
+        matrix.m_owner = false;
+        std::fill_n(matrix.m_matrix, rows * cols, val);
+        return matrix;
     }
 
     BitMatrixView<value_type, false> operator[](size_t row) noexcept
@@ -111,10 +148,16 @@ struct BitMatrix {
         return m_cols;
     }
 
+    const T* data() const noexcept
+    {
+        return m_matrix;
+    }
+
 private:
     size_t m_rows;
     size_t m_cols;
     T* m_matrix;
+    bool m_owner;
 };
 
 template <typename T>
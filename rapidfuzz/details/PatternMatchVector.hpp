@@ -2,13 +2,20 @@
 /* Copyright (c) 2022 Max Bachmann */
 
 #pragma once
+#include <algorithm>
 #include <array>
+#include <limits>
+#include <memory>
+#include <stdexcept>
 #include <stdint.h>
 #include <stdio.h>
+#include <vector>
 
 #include <rapidfuzz/details/GrowingHashmap.hpp>
 #include <rapidfuzz/details/Matrix.hpp>
 #include <rapidfuzz/details/Range.hpp>
+#include <rapidfuzz/details/Serialization.hpp>
+#include <rapidfuzz/details/Workspace.hpp>
 #include <rapidfuzz/details/intrinsics.hpp>
 
 namespace rapidfuzz {
@@ -32,6 +39,27 @@ struct BitvectorHashmap {
         return m_map[i].value;
     }
 
+    /**
+     * call func(key) for every key stored in the hashmap
+     */
+    template <typename Func>
+    void for_each_key(Func&& func) const
+    {
+        for (const auto& elem : m_map)
+            if (elem.value) func(elem.key);
+    }
+
+    /**
+     * number of keys stored in the hashmap
+     */
+    size_t size() const noexcept
+    {
+        size_t count = 0;
+        for (const auto& elem : m_map)
+            count += (elem.value != 0);
+        return count;
+    }
+
 private:
     /**
      * lookup key inside the hashmap using a similar collision resolution
@@ -137,7 +165,8 @@ struct BlockPatternMatchVector {
     BlockPatternMatchVector() = delete;
 
     BlockPatternMatchVector(size_t str_len)
-        : m_block_count(ceil_div(str_len, 64)), m_map(nullptr), m_extendedAscii(256, m_block_count, 0)
+        : m_block_count(ceil_div(str_len, 64)), m_map(nullptr), m_owns_map(true), m_scratch(false),
+          m_extendedAscii(256, m_block_count, 0)
     {}
 
     template <typename InputIt>
@@ -146,9 +175,91 @@ struct BlockPatternMatchVector {
         insert(s);
     }
 
+    BlockPatternMatchVector(const BlockPatternMatchVector& other)
+        : m_block_count(other.m_block_count), m_map(nullptr), m_owns_map(true), m_scratch(false),
+          m_extendedAscii(other.m_extendedAscii)
+    {
+        if (other.m_map) {
+            m_map = new BitvectorHashmap[m_block_count];
+            std::copy(other.m_map, other.m_map + m_block_count, m_map);
+        }
+    }
+
+    BlockPatternMatchVector(BlockPatternMatchVector&& other) noexcept
+        : m_block_count(0), m_map(nullptr), m_owns_map(true), m_scratch(false), m_extendedAscii()
+    {
+        swap(other);
+    }
+
+    BlockPatternMatchVector& operator=(BlockPatternMatchVector other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    void swap(BlockPatternMatchVector& other) noexcept
+    {
+        std::swap(m_block_count, other.m_block_count);
+        std::swap(m_map, other.m_map);
+        std::swap(m_owns_map, other.m_owns_map);
+        std::swap(m_scratch, other.m_scratch);
+        m_extendedAscii.swap(other.m_extendedAscii);
+    }
+
     ~BlockPatternMatchVector()
     {
-        delete[] m_map;
+        if (m_owns_map) delete[] m_map;
+    }
+
+    void serialize(SerializationWriter& writer) const
+    {
+        writer.write(static_cast<uint64_t>(m_block_count));
+        writer.write(static_cast<uint64_t>(m_map != nullptr));
+        writer.write(m_extendedAscii.data(), 256 * m_block_count);
+        if (m_map) writer.write(m_map, m_block_count);
+    }
+
+    /**
+     * creates a read only BlockPatternMatchVector, which uses the bitvectors stored in the buffer of
+     * \p reader in place. Copies of it own their bitvectors
+     */
+    static BlockPatternMatchVector view(SerializationReader& reader)
+    {
+        BlockPatternMatchVector PM(0);
+        PM.m_block_count = static_cast<size_t>(reader.read<uint64_t>());
+        bool has_map = reader.read<uint64_t>() != 0;
+        if (PM.m_block_count > std::numeric_limits<size_t>::max() / 256)
+            throw std::invalid_argument("serialized scorer is corrupted");
+
+        PM.m_extendedAscii =
+            BitMatrix<uint64_t>::view(reader.view<uint64_t>(256 * PM.m_block_count), 256, PM.m_block_count);
+        if (has_map) {
+            PM.m_map = const_cast<BitvectorHashmap*>(reader.view<BitvectorHashmap>(PM.m_block_count));
+            PM.m_owns_map = false;
+
+            /* a block stores at most 64 characters. Fuller maps would make the lookup of missing keys
+             * loop forever */
+            for (size_t block = 0; block < PM.m_block_count; ++block)
+                if (PM.m_map[block].size() > 64)
+                    throw std::invalid_argument("serialized scorer is corrupted");
+        }
+        return PM;
+    }
+
+    /**
+     * creates a BlockPatternMatchVector for \p s, which takes its bitvectors from the bound Workspace.
+     * It is used for the temporary pattern of the uncached scorers, so it must not outlive the current
+     * ScratchFrame. Copies of it own their bitvectors
+     */
+    template <typename InputIt>
+    static BlockPatternMatchVector scratch(const Range<InputIt>& s)
+    {
+        BlockPatternMatchVector PM(0);
+        PM.m_block_count = ceil_div(s.size(), 64);
+        PM.m_extendedAscii = BitMatrix<uint64_t>::scratch(256, PM.m_block_count, 0);
+        PM.m_scratch = true;
+        PM.insert(s);
+        return PM;
     }
 
     size_t size() const noexcept
@@ -188,7 +299,7 @@ struct BlockPatternMatchVector {
         if (key >= 0 && key <= 255)
             m_extendedAscii[static_cast<uint8_t>(key)][block] |= mask;
         else {
-            if (!m_map) m_map = new BitvectorHashmap[m_block_count];
+            if (!m_map) allocate_map();
             m_map[block][key] |= mask;
         }
     }
@@ -215,10 +326,136 @@ struct BlockPatternMatchVector {
     }
 
 private:
+    friend struct CompactBlockPatternMatchVector;
+
+    void allocate_map()
+    {
+        ScratchAllocator<BitvectorHashmap> allocator;
+        if (m_scratch && allocator.uses_workspace()) {
+            m_map = allocator.allocate(m_block_count);
+            std::uninitialized_fill_n(m_map, m_block_count, BitvectorHashmap());
+            m_owns_map = false;
+        }
+        else
+            m_map = new BitvectorHashmap[m_block_count];
+    }
+
     size_t m_block_count;
     BitvectorHashmap* m_map;
+    bool m_owns_map;
+    /* the bitvectors are taken from the bound Workspace */
+    bool m_scratch;
     BitMatrix<uint64_t> m_extendedAscii;
 };
 
+/**
+ * Alternative layout of BlockPatternMatchVector, which only stores the characters occurring in the
+ * pattern. BlockPatternMatchVector stores a bitvector for each of the 256 characters below 256 in every
+ * block (2 KiB per block) and a hashmap of 2 KiB per block for the remaining characters. This layout
+ * maps ASCII characters to a dense row using a table of 128 bytes and finds the row of the remaining
+ * characters using a binary search. It uses a lot less memory, but lookups are slightly slower.
+ */
+struct CompactBlockPatternMatchVector {
+    CompactBlockPatternMatchVector() : m_block_count(0), m_ascii_rows()
+    {}
+
+    explicit CompactBlockPatternMatchVector(const BlockPatternMatchVector& PM)
+        : m_block_count(PM.size()), m_ascii_rows()
+    {
+        auto is_used = [&](size_t ch) {
+            for (size_t block = 0; block < m_block_count; ++block)
+                if (PM.m_extendedAscii[ch][block]) return true;
+            return false;
+        };
+
+        /* row 0 stays zero and is used for ASCII characters which are not part of the pattern */
+        size_t row_count = 1;
+        for (size_t ch = 0; ch < 128; ++ch)
+            if (is_used(ch)) m_ascii_rows[ch] = static_cast<uint8_t>(row_count++);
+
+        for (size_t ch = 128; ch < 256; ++ch)
+            if (is_used(ch)) m_keys.push_back(ch);
+        for (size_t block = 0; PM.m_map && block < m_block_count; ++block)
+            PM.m_map[block].for_each_key([&](uint64_t key) { m_keys.push_back(key); });
+        std::sort(m_keys.begin(), m_keys.end());
+        m_keys.erase(std::unique(m_keys.begin(), m_keys.end()), m_keys.end());
+        m_keys.shrink_to_fit();
+        m_first_key_row = row_count;
+
+        m_matrix = BitMatrix<uint64_t>(row_count + m_keys.size(), m_block_count, 0);
+        for (size_t ch = 0; ch < 128; ++ch) {
+            if (!m_ascii_rows[ch]) continue;
+            for (size_t block = 0; block < m_block_count; ++block)
+                m_matrix[m_ascii_rows[ch]][block] = PM.m_extendedAscii[ch][block];
+        }
+        for (size_t i = 0; i < m_keys.size(); ++i)
+            for (size_t block = 0; block < m_block_count; ++block)
+                m_matrix[m_first_key_row + i][block] = PM.get(block, m_keys[i]);
+    }
+
+    size_t size() const noexcept
+    {
+        return m_block_count;
+    }
+
+    template <typename CharT>
+    uint64_t get(size_t block, CharT key) const noexcept
+    {
+        if (key >= 0 && key <= 127) return m_matrix[m_ascii_rows[static_cast<uint8_t>(key)]][block];
+
+        auto iter = std::lower_bound(m_keys.begin(), m_keys.end(), static_cast<uint64_t>(key));
+        if (iter == m_keys.end() || *iter != static_cast<uint64_t>(key)) return 0;
+
+        return m_matrix[m_first_key_row + static_cast<size_t>(iter - m_keys.begin())][block];
+    }
+
+    uint64_t get(size_t block, char ch) const noexcept
+    {
+        return get(block, static_cast<uint8_t>(ch));
+    }
+
+private:
+    size_t m_block_count;
+    size_t m_first_key_row = 0;
+    std::array<uint8_t, 128> m_ascii_rows;
+    /* sorted characters which are not ASCII */
+    std::vector<uint64_t> m_keys;
+    BitMatrix<uint64_t> m_matrix;
+};
+
+/**
+ * View of the pattern match vector of a pattern with the length len, which returns the bitvectors
+ * of the reversed pattern. The bitvectors are reversed on every lookup, so no second pattern match
+ * vector has to be built for the reversed pattern.
+ */
+template <typename PM_Vec>
+struct ReversedPatternMatchVector {
+    ReversedPatternMatchVector(const PM_Vec& PM, size_t len) : m_PM(PM), m_shift(PM.size() * 64 - len)
+    {
+        assert(len > 0 && m_shift < 64);
+    }
+
+    size_t size() const noexcept
+    {
+        return m_PM.size();
+    }
+
+    template <typename CharT>
+    uint64_t get(size_t block, CharT ch) const noexcept
+    {
+        /* bit i of the reversed pattern is bit len - 1 - i of the pattern. Block b of the reversed
+         * pattern consists of the reversed blocks words - 1 - b and words - 2 - b */
+        size_t words = m_PM.size();
+        uint64_t low = bit_reverse(m_PM.get(words - 1 - block, ch)) >> m_shift;
+        if (m_shift == 0 || block + 1 == words) return low;
+
+        return low | (bit_reverse(m_PM.get(words - 2 - block, ch)) << (64 - m_shift));
+    }
+
+private:
+    const PM_Vec& m_PM;
+    size_t m_shift;
+};
+
 } // namespace detail
 } // namespace rapidfuzz
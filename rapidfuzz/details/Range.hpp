@@ -13,6 +13,7 @@
 #include <sys/types.h>
 #include <vector>
 
+#include <rapidfuzz/details/Workspace.hpp>
 #include <rapidfuzz/details/type_traits.hpp>
 
 namespace rapidfuzz {
@@ -236,7 +237,7 @@ inline bool operator>=(const Range<InputIt1>& a, const Range<InputIt2>& b)
 }
 
 template <typename InputIt>
-using RangeVec = std::vector<Range<InputIt>>;
+using RangeVec = ScratchVector<Range<InputIt>>;
 
 } // namespace detail
 } // namespace rapidfuzz
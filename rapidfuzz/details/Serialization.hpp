@@ -0,0 +1,158 @@
+/* SPDX-License-Identifier: MIT */
+/* Copyright © 2025-present Max Bachmann */
+
+#pragma once
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+#include <stddef.h>
+#include <stdexcept>
+#include <stdint.h>
+
+namespace rapidfuzz {
+namespace detail {
+
+/**
+ * Binary format written by the serialize method of the Multi* scorers
+ *
+ * The format is meant to be written once and mapped read-only (e.g. using mmap) by the processes using
+ * the scorer, so it stores the data in the layout used by the scorers instead of a portable one:
+ *
+ * - all integers are stored in native byte order as uint64_t
+ * - every field starts at a multiple of 8 bytes, so the bitvectors can be used in place
+ * - the layout of the pattern match vectors depends on MaxLen and the SIMD vector size, so both are
+ *   stored in the header and have to match when loading the scorer
+ *
+ * header (48 bytes):
+ *   char[8]   magic "RFSCORER"
+ *   uint64_t  format version
+ *   uint64_t  byte order mark 0x0102030405060708
+ *   uint64_t  scorer kind (SerializedScorer)
+ *   uint64_t  MaxLen
+ *   uint64_t  SIMD vector size
+ *
+ * followed by the fields of the scorer. A BlockPatternMatchVector is stored as:
+ *   uint64_t                block count
+ *   uint64_t                1 if the hashmap for characters above 255 is stored, 0 otherwise
+ *   uint64_t[256][blocks]   bitvectors of the characters below 256
+ *   BitvectorHashmap[blocks] hashmap of every block (only if stored)
+ */
+enum class SerializedScorer : uint32_t {
+    Levenshtein = 1,
+    LCSseq = 2,
+    Indel = 3,
+    OSA = 4,
+    Jaro = 5,
+    JaroWinkler = 6
+};
+
+static constexpr uint64_t serialization_version = 1;
+static constexpr uint64_t serialization_byte_order = UINT64_C(0x0102030405060708);
+
+struct SerializationWriter {
+    explicit SerializationWriter(std::ostream& out) : m_out(out)
+    {}
+
+    template <typename T>
+    void write(const T* data, size_t count)
+    {
+        static const char padding[8] = {};
+        size_t bytes = count * sizeof(T);
+        if (bytes) m_out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+        if (bytes % 8) m_out.write(padding, static_cast<std::streamsize>(8 - bytes % 8));
+    }
+
+    template <typename T>
+    void write(const T& value)
+    {
+        write(&value, 1);
+    }
+
+    /* stores lengths as uint64_t, so the format does not depend on the size of size_t */
+    template <typename T>
+    void write_lengths(const T* lens, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+            write(static_cast<uint64_t>(lens[i]));
+    }
+
+private:
+    std::ostream& m_out;
+};
+
+struct SerializationReader {
+    SerializationReader(const void* data, size_t size)
+        : m_data(static_cast<const char*>(data)), m_size(size), m_offset(0)
+    {
+        if (reinterpret_cast<uintptr_t>(data) % 8)
+            throw std::invalid_argument("serialized scorer has to be 8 byte aligned");
+    }
+
+    /**
+     * returns a pointer to the next \p count elements of the buffer without copying them
+     */
+    template <typename T>
+    const T* view(size_t count)
+    {
+        static_assert(alignof(T) <= 8, "serialized fields are only 8 byte aligned");
+        if (count > (m_size - m_offset) / sizeof(T))
+            throw std::invalid_argument("serialized scorer is truncated");
+
+        const T* data = reinterpret_cast<const T*>(m_data + m_offset);
+        size_t bytes = count * sizeof(T);
+        m_offset = std::min(m_size, m_offset + (bytes + 7) / 8 * 8);
+        return data;
+    }
+
+    template <typename T>
+    T read()
+    {
+        T value;
+        std::memcpy(&value, view<T>(1), sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    void read_lengths(T* lens, size_t count)
+    {
+        const uint64_t* data = view<uint64_t>(count);
+        for (size_t i = 0; i < count; ++i)
+            lens[i] = static_cast<T>(data[i]);
+    }
+
+private:
+    const char* m_data;
+    size_t m_size;
+    size_t m_offset;
+};
+
+static inline void write_serialization_header(SerializationWriter& writer, SerializedScorer kind, int max_len,
+                                              size_t vec_size)
+{
+    writer.write("RFSCORER", 8);
+    writer.write(serialization_version);
+    writer.write(serialization_byte_order);
+    writer.write(static_cast<uint64_t>(kind));
+    writer.write(static_cast<uint64_t>(max_len));
+    writer.write(static_cast<uint64_t>(vec_size));
+}
+
+static inline void read_serialization_header(SerializationReader& reader, SerializedScorer kind, int max_len,
+                                             size_t vec_size)
+{
+    if (std::memcmp(reader.view<char>(8), "RFSCORER", 8) != 0)
+        throw std::invalid_argument("buffer does not contain a serialized scorer");
+    if (reader.read<uint64_t>() != serialization_version)
+        throw std::invalid_argument("unsupported version of the serialization format");
+    if (reader.read<uint64_t>() != serialization_byte_order)
+        throw std::invalid_argument("serialized scorer uses a different byte order");
+    if (reader.read<uint64_t>() != static_cast<uint64_t>(kind))
+        throw std::invalid_argument("serialized scorer has a different type");
+    if (reader.read<uint64_t>() != static_cast<uint64_t>(max_len))
+        throw std::invalid_argument("serialized scorer uses a different MaxLen");
+    if (reader.read<uint64_t>() != static_cast<uint64_t>(vec_size))
+        throw std::invalid_argument("serialized scorer was built for a different SIMD vector size");
+}
+
+} // namespace detail
+} // namespace rapidfuzz
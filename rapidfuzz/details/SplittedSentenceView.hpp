@@ -34,7 +34,8 @@ public:
         return m_sentence.size();
     }
 
-    std::vector<CharT> join() const;
+    template <typename Container = ScratchVector<CharT>>
+    Container join() const;
 
     const RangeVec<InputIt>& words() const
     {
@@ -68,14 +69,15 @@ size_t SplittedSentenceView<InputIt>::size() const
 }
 
 template <typename InputIt>
-auto SplittedSentenceView<InputIt>::join() const -> std::vector<CharT>
+template <typename Container>
+Container SplittedSentenceView<InputIt>::join() const
 {
     if (m_sentence.empty()) {
-        return std::vector<CharT>();
+        return Container();
     }
 
     auto sentence_iter = m_sentence.begin();
-    std::vector<CharT> joined(sentence_iter->begin(), sentence_iter->end());
+    Container joined(sentence_iter->begin(), sentence_iter->end());
     ++sentence_iter;
     for (; sentence_iter != m_sentence.end(); ++sentence_iter) {
         joined.push_back(0x20);
@@ -0,0 +1,237 @@
+/* SPDX-License-Identifier: MIT */
+/* Copyright © 2025-present Max Bachmann */
+
+#pragma once
+#include <array>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace rapidfuzz {
+
+/**
+ * @brief implementations counted when compiling with RAPIDFUZZ_ENABLE_STATS
+ *
+ * The *Filter paths count calls, which returned without running a kernel, e.g. because the
+ * length difference already exceeds the score_cutoff or the strings are empty after removing
+ * their common prefix and suffix. The fuzz scorers count every call, including the ones made by
+ * other scorers (e.g. WRatio calling partial_ratio), and the metrics they use count their own calls.
+ */
+enum class StatsPath : size_t {
+    LevenshteinFilter,
+    LevenshteinMbleven,
+    LevenshteinHyrroe2003,
+    LevenshteinSmallBand,
+    LevenshteinBlock,
+    LevenshteinWagnerFischer,
+    LevenshteinSimd,
+
+    /* Indel uses the LCSseq implementation */
+    LCSseqFilter,
+    LCSseqMbleven,
+    LCSseqUnroll,
+    LCSseqBlockwise,
+    LCSseqSimd,
+
+    OSAFilter,
+    OSAHyrroe2003,
+    OSABlock,
+    OSASimd,
+
+    DamerauLevenshteinFilter,
+    DamerauLevenshteinZhao,
+
+    JaroFilter,
+    JaroSingleWord,
+    JaroBlock,
+    JaroSimd,
+
+    Hamming,
+    Prefix,
+    Postfix,
+
+    FuzzRatio,
+    FuzzPartialRatio,
+    FuzzTokenSortRatio,
+    FuzzTokenSetRatio,
+    FuzzTokenRatio,
+    FuzzPartialTokenSortRatio,
+    FuzzPartialTokenSetRatio,
+    FuzzPartialTokenRatio,
+    FuzzWRatio,
+    FuzzQRatio,
+
+    Count
+};
+
+/**
+ * @brief counters of a single implementation
+ */
+struct PathStats {
+    /* amount of calls of the implementation */
+    uint64_t calls = 0;
+    /**
+     * work done by these calls: 64 bit words processed by the bit-parallel kernels, cells of the
+     * matrix for the dynamic programming implementations, characters for Hamming/Prefix/Postfix and
+     * windows of s2 for partial_ratio. mbleven and the filters do not count any work
+     */
+    uint64_t words = 0;
+    /**
+     * calls which stopped before processing all of s2, since the score_cutoff could not be reached
+     * any more. For partial_ratio these are calls, which stopped after finding a perfect match
+     */
+    uint64_t early_exits = 0;
+};
+
+/**
+ * @brief Snapshot of the counters of a thread
+ *
+ * The counters are only updated when compiling with RAPIDFUZZ_ENABLE_STATS. Otherwise all of them
+ * stay 0 and the instrumentation does not generate any code.
+ *
+ * @code{.cpp}
+ * rapidfuzz::stats_reset();
+ * scorer.distance(s2, score_cutoff);
+ * rapidfuzz::Stats stats = rapidfuzz::stats_snapshot();
+ * uint64_t block_calls = stats[rapidfuzz::StatsPath::LevenshteinBlock].calls;
+ * @endcode
+ */
+class Stats {
+public:
+    const PathStats& operator[](StatsPath path) const noexcept
+    {
+        return m_paths[static_cast<size_t>(path)];
+    }
+
+    PathStats& operator[](StatsPath path) noexcept
+    {
+        return m_paths[static_cast<size_t>(path)];
+    }
+
+    /**
+     * @brief adds the counters of another snapshot, e.g. to combine the snapshots of multiple threads
+     */
+    Stats& operator+=(const Stats& other) noexcept
+    {
+        for (size_t i = 0; i < m_paths.size(); ++i) {
+            m_paths[i].calls += other.m_paths[i].calls;
+            m_paths[i].words += other.m_paths[i].words;
+            m_paths[i].early_exits += other.m_paths[i].early_exits;
+        }
+        return *this;
+    }
+
+private:
+    std::array<PathStats, static_cast<size_t>(StatsPath::Count)> m_paths;
+};
+
+namespace detail {
+
+/* counters of the current thread. This is not static, so all translation units share them */
+inline Stats& thread_stats() noexcept
+{
+    static thread_local Stats stats;
+    return stats;
+}
+
+static inline void stats_call(StatsPath path, uint64_t words = 0) noexcept
+{
+    PathStats& stats = thread_stats()[path];
+    ++stats.calls;
+    stats.words += words;
+}
+
+static inline void stats_words(StatsPath path, uint64_t words) noexcept
+{
+    thread_stats()[path].words += words;
+}
+
+static inline void stats_early_exit(StatsPath path) noexcept
+{
+    ++thread_stats()[path].early_exits;
+}
+
+} // namespace detail
+
+/**
+ * @brief returns a copy of the counters of the calling thread
+ *
+ * Scorers running on other threads update the counters of their own thread. The workers started
+ * by process::cdist add their counters to the ones of the thread calling cdist before it returns.
+ */
+inline Stats stats_snapshot() noexcept
+{
+    return detail::thread_stats();
+}
+
+/**
+ * @brief sets all counters of the calling thread to 0
+ */
+inline void stats_reset() noexcept
+{
+    detail::thread_stats() = Stats();
+}
+
+/**
+ * @brief name of the implementation, e.g. "Levenshtein/small_band"
+ */
+inline const char* to_string(StatsPath path) noexcept
+{
+    switch (path) {
+    case StatsPath::LevenshteinFilter: return "Levenshtein/filter";
+    case StatsPath::LevenshteinMbleven: return "Levenshtein/mbleven";
+    case StatsPath::LevenshteinHyrroe2003: return "Levenshtein/hyrroe2003";
+    case StatsPath::LevenshteinSmallBand: return "Levenshtein/small_band";
+    case StatsPath::LevenshteinBlock: return "Levenshtein/block";
+    case StatsPath::LevenshteinWagnerFischer: return "Levenshtein/wagner_fischer";
+    case StatsPath::LevenshteinSimd: return "Levenshtein/simd";
+    case StatsPath::LCSseqFilter: return "LCSseq/filter";
+    case StatsPath::LCSseqMbleven: return "LCSseq/mbleven";
+    case StatsPath::LCSseqUnroll: return "LCSseq/unroll";
+    case StatsPath::LCSseqBlockwise: return "LCSseq/blockwise";
+    case StatsPath::LCSseqSimd: return "LCSseq/simd";
+    case StatsPath::OSAFilter: return "OSA/filter";
+    case StatsPath::OSAHyrroe2003: return "OSA/hyrroe2003";
+    case StatsPath::OSABlock: return "OSA/block";
+    case StatsPath::OSASimd: return "OSA/simd";
+    case StatsPath::DamerauLevenshteinFilter: return "DamerauLevenshtein/filter";
+    case StatsPath::DamerauLevenshteinZhao: return "DamerauLevenshtein/zhao";
+    case StatsPath::JaroFilter: return "Jaro/filter";
+    case StatsPath::JaroSingleWord: return "Jaro/single_word";
+    case StatsPath::JaroBlock: return "Jaro/block";
+    case StatsPath::JaroSimd: return "Jaro/simd";
+    case StatsPath::Hamming: return "Hamming";
+    case StatsPath::Prefix: return "Prefix";
+    case StatsPath::Postfix: return "Postfix";
+    case StatsPath::FuzzRatio: return "fuzz/ratio";
+    case StatsPath::FuzzPartialRatio: return "fuzz/partial_ratio";
+    case StatsPath::FuzzTokenSortRatio: return "fuzz/token_sort_ratio";
+    case StatsPath::FuzzTokenSetRatio: return "fuzz/token_set_ratio";
+    case StatsPath::FuzzTokenRatio: return "fuzz/token_ratio";
+    case StatsPath::FuzzPartialTokenSortRatio: return "fuzz/partial_token_sort_ratio";
+    case StatsPath::FuzzPartialTokenSetRatio: return "fuzz/partial_token_set_ratio";
+    case StatsPath::FuzzPartialTokenRatio: return "fuzz/partial_token_ratio";
+    case StatsPath::FuzzWRatio: return "fuzz/WRatio";
+    case StatsPath::FuzzQRatio: return "fuzz/QRatio";
+    case StatsPath::Count: break;
+    }
+    return "unknown";
+}
+
+} // namespace rapidfuzz
+
+/*
+ * instrumentation used by the implementations. Without RAPIDFUZZ_ENABLE_STATS the arguments are not
+ * evaluated, so they can be used to calculate the amount of work
+ */
+#ifdef RAPIDFUZZ_ENABLE_STATS
+#    define RAPIDFUZZ_STATS_CALL(path, words)                                                                \
+        ::rapidfuzz::detail::stats_call(::rapidfuzz::StatsPath::path, static_cast<uint64_t>(words))
+#    define RAPIDFUZZ_STATS_WORDS(path, words)                                                               \
+        ::rapidfuzz::detail::stats_words(::rapidfuzz::StatsPath::path, static_cast<uint64_t>(words))
+#    define RAPIDFUZZ_STATS_EARLY_EXIT(path)                                                                 \
+        ::rapidfuzz::detail::stats_early_exit(::rapidfuzz::StatsPath::path)
+#else
+#    define RAPIDFUZZ_STATS_CALL(path, words) ((void)0)
+#    define RAPIDFUZZ_STATS_WORDS(path, words) ((void)0)
+#    define RAPIDFUZZ_STATS_EARLY_EXIT(path) ((void)0)
+#endif
@@ -0,0 +1,267 @@
+/* SPDX-License-Identifier: MIT */
+/* Copyright © 2025-present Max Bachmann */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdint.h>
+#include <type_traits>
+#include <vector>
+
+namespace rapidfuzz {
+
+class Workspace;
+
+namespace detail {
+struct ScratchFrame;
+
+template <typename T>
+struct ScratchAllocator;
+
+/* Workspace bound to the current thread. This is not static, so all translation units share it */
+inline Workspace*& bound_workspace() noexcept
+{
+    static thread_local Workspace* workspace = nullptr;
+    return workspace;
+}
+} // namespace detail
+
+/**
+ * @brief Memory arena for the temporary buffers of the scorers
+ *
+ * While a Workspace is bound to a thread using WorkspaceGuard, the scorers take their temporary
+ * buffers (e.g. the bit vectors of the bit-parallel algorithms, the windows of partial_ratio and the
+ * words of the token based ratios) from it instead of the heap. The memory is handed back to the
+ * Workspace when the scorer returns, so after a few warmup calls scoring does not allocate any more.
+ *
+ * A Workspace must only be used by one thread at a time. The cached scorers do not keep any temporary
+ * state, so they can still be shared between threads which bind their own Workspace:
+ *
+ * @code{.cpp}
+ * // in every worker thread
+ * thread_local rapidfuzz::Workspace workspace;
+ * rapidfuzz::WorkspaceGuard guard(workspace);
+ * double score = shared_scorer.similarity(choice);
+ * @endcode
+ */
+class Workspace {
+public:
+    /**
+     * @param initial_capacity amount of bytes reserved upfront
+     */
+    explicit Workspace(size_t initial_capacity = 0)
+    {
+        if (initial_capacity) add_block(initial_capacity);
+    }
+
+    Workspace(const Workspace&) = delete;
+    Workspace& operator=(const Workspace&) = delete;
+
+    /**
+     * @brief amount of bytes reserved by the Workspace
+     */
+    size_t capacity() const noexcept
+    {
+        size_t capacity = 0;
+        for (const auto& block : m_blocks)
+            capacity += block.size;
+        return capacity;
+    }
+
+    /**
+     * @brief frees the memory reserved by the Workspace. It must not be used by a scorer at the moment
+     */
+    void release() noexcept
+    {
+        m_blocks.clear();
+        m_block = 0;
+        m_offset = 0;
+    }
+
+private:
+    friend struct detail::ScratchFrame;
+    template <typename T>
+    friend struct detail::ScratchAllocator;
+
+    struct Block {
+        std::unique_ptr<std::max_align_t[]> data;
+        size_t size;
+    };
+
+    void* allocate(size_t bytes, size_t alignment)
+    {
+        for (; m_block < m_blocks.size(); ++m_block, m_offset = 0) {
+            size_t offset = (m_offset + alignment - 1) / alignment * alignment;
+            if (offset + bytes <= m_blocks[m_block].size) {
+                m_offset = offset + bytes;
+                return reinterpret_cast<char*>(m_blocks[m_block].data.get()) + offset;
+            }
+        }
+
+        /* the blocks grow geometrically, so the amount of blocks stays small */
+        size_t last_size = m_blocks.empty() ? 0 : m_blocks.back().size;
+        add_block(std::max({bytes, 2 * last_size, size_t(4096)}));
+        m_block = m_blocks.size() - 1;
+        m_offset = bytes;
+        return m_blocks.back().data.get();
+    }
+
+    bool owns(const void* ptr) const noexcept
+    {
+        auto pos = reinterpret_cast<uintptr_t>(ptr);
+        for (const auto& block : m_blocks) {
+            auto start = reinterpret_cast<uintptr_t>(block.data.get());
+            if (pos >= start && pos < start + block.size) return true;
+        }
+        return false;
+    }
+
+    void add_block(size_t size)
+    {
+        size_t elements = (size + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t);
+        m_blocks.push_back(Block{std::unique_ptr<std::max_align_t[]>(new std::max_align_t[elements]),
+                                 elements * sizeof(std::max_align_t)});
+    }
+
+    std::vector<Block> m_blocks;
+    size_t m_block = 0;
+    size_t m_offset = 0;
+    size_t m_frame_depth = 0;
+};
+
+/**
+ * @brief binds a Workspace to the current thread for the lifetime of the guard
+ */
+class WorkspaceGuard {
+public:
+    explicit WorkspaceGuard(Workspace& workspace) noexcept : m_previous(detail::bound_workspace())
+    {
+        detail::bound_workspace() = &workspace;
+    }
+
+    ~WorkspaceGuard()
+    {
+        detail::bound_workspace() = m_previous;
+    }
+
+    WorkspaceGuard(const WorkspaceGuard&) = delete;
+    WorkspaceGuard& operator=(const WorkspaceGuard&) = delete;
+
+private:
+    Workspace* m_previous;
+};
+
+namespace detail {
+
+/**
+ * Scope of a scorer using scratch buffers. Scratch buffers created inside of the frame take their
+ * memory from the bound Workspace, which is rewound when the frame ends. So a scratch buffer must not
+ * outlive the frame it was created in.
+ */
+struct ScratchFrame {
+    ScratchFrame() noexcept : m_workspace(bound_workspace()), m_block(0), m_offset(0)
+    {
+        if (!m_workspace) return;
+
+        m_block = m_workspace->m_block;
+        m_offset = m_workspace->m_offset;
+        ++m_workspace->m_frame_depth;
+    }
+
+    ~ScratchFrame()
+    {
+        if (!m_workspace) return;
+
+        --m_workspace->m_frame_depth;
+        m_workspace->m_block = m_block;
+        m_workspace->m_offset = m_offset;
+    }
+
+    ScratchFrame(const ScratchFrame&) = delete;
+    ScratchFrame& operator=(const ScratchFrame&) = delete;
+
+private:
+    Workspace* m_workspace;
+    size_t m_block;
+    size_t m_offset;
+};
+
+/**
+ * Allocator of the scratch buffers. It uses the bound Workspace when it is created inside of a
+ * ScratchFrame and the heap otherwise. Buffers growing while a nested frame is active use the heap,
+ * since the nested frame rewinds the Workspace behind them.
+ */
+template <typename T>
+struct ScratchAllocator {
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    ScratchAllocator() noexcept : m_workspace(bound_workspace()), m_depth(0)
+    {
+        if (m_workspace && m_workspace->m_frame_depth)
+            m_depth = m_workspace->m_frame_depth;
+        else
+            m_workspace = nullptr;
+    }
+
+    template <typename U>
+    ScratchAllocator(const ScratchAllocator<U>& other) noexcept
+        : m_workspace(other.m_workspace), m_depth(other.m_depth)
+    {}
+
+    /* true when allocate takes the memory from the bound Workspace instead of the heap */
+    bool uses_workspace() const noexcept
+    {
+        return m_workspace && m_workspace->m_frame_depth == m_depth;
+    }
+
+    T* allocate(size_t n)
+    {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) throw std::bad_alloc();
+
+        if (uses_workspace()) return static_cast<T*>(m_workspace->allocate(n * sizeof(T), alignof(T)));
+
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t) noexcept
+    {
+        /* memory of the Workspace is handed back when the frame ends */
+        if (m_workspace && m_workspace->owns(p)) return;
+
+        ::operator delete(p);
+    }
+
+    /* copies are bound to the frame they are created in */
+    ScratchAllocator select_on_container_copy_construction() const noexcept
+    {
+        return ScratchAllocator();
+    }
+
+    friend bool operator==(const ScratchAllocator& a, const ScratchAllocator& b) noexcept
+    {
+        return a.m_workspace == b.m_workspace && a.m_depth == b.m_depth;
+    }
+
+    friend bool operator!=(const ScratchAllocator& a, const ScratchAllocator& b) noexcept
+    {
+        return !(a == b);
+    }
+
+private:
+    template <typename U>
+    friend struct ScratchAllocator;
+
+    Workspace* m_workspace;
+    size_t m_depth;
+};
+
+template <typename T>
+using ScratchVector = std::vector<T, ScratchAllocator<T>>;
+
+} // namespace detail
+} // namespace rapidfuzz
@@ -5,6 +5,7 @@
 #include <cstring>
 #include <rapidfuzz/details/Range.hpp>
 #include <rapidfuzz/details/SplittedSentenceView.hpp>
+#include <rapidfuzz/details/Stats.hpp>
 #include <rapidfuzz/details/intrinsics.hpp>
 #include <rapidfuzz/details/type_traits.hpp>
 #include <rapidfuzz/details/types.hpp>
@@ -34,6 +35,48 @@ static inline size_t abs_diff(size_t a, size_t b)
     return a > b ? a - b : b - a;
 }
 
+/* converts a character to the key used by the pattern match vectors. char is converted as unsigned,
+ * so copies of the strings match characters the same way the pattern match vectors do */
+static inline uint64_t multi_char(char ch)
+{
+    return static_cast<uint64_t>(static_cast<unsigned char>(ch));
+}
+
+template <typename CharT>
+uint64_t multi_char(CharT ch)
+{
+    return static_cast<uint64_t>(ch);
+}
+
+/* compares two characters by their pattern match vector key, so the scalar paths agree with the
+ * bit-parallel ones when e.g. a char query is compared with an unsigned char choice */
+template <typename CharT1, typename CharT2,
+          typename std::enable_if<std::is_integral<CharT1>::value && std::is_integral<CharT2>::value,
+                                  int>::type = 0>
+bool char_equal(CharT1 ch1, CharT2 ch2)
+{
+    return multi_char(ch1) == multi_char(ch2);
+}
+
+template <typename CharT1, typename CharT2,
+          typename std::enable_if<!std::is_integral<CharT1>::value || !std::is_integral<CharT2>::value,
+                                  int>::type = 0>
+bool char_equal(const CharT1& ch1, const CharT2& ch2)
+{
+    return ch1 == ch2;
+}
+
+template <typename InputIt1, typename InputIt2>
+bool range_equal(const Range<InputIt1>& s1, const Range<InputIt2>& s2)
+{
+    if (s1.size() != s2.size()) return false;
+
+    return std::equal(s1.begin(), s1.end(), s2.begin(),
+                      [](const iter_value_t<InputIt1>& ch1, const iter_value_t<InputIt2>& ch2) {
+                          return char_equal(ch1, ch2);
+                      });
+}
+
 template <typename TO, typename FROM>
 TO opt_static_cast(const FROM& value)
 {
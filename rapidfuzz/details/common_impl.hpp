@@ -37,7 +37,7 @@ DecomposedSet<InputIt1, InputIt2, InputIt1> set_decomposition(SplittedSentenceVi
 template <class InputIt1, class InputIt2>
 std::pair<InputIt1, InputIt2> rf_mismatch(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2)
 {
-    while (first1 != last1 && first2 != last2 && *first1 == *first2)
+    while (first1 != last1 && first2 != last2 && char_equal(*first1, *first2))
         ++first1, ++first2;
 
     return std::make_pair(first1, first2);
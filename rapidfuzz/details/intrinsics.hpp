@@ -199,6 +199,19 @@ static inline unsigned int countr_zero(uint8_t x)
     return countr_zero(static_cast<uint32_t>(x));
 }
 
+/*
+ * reverses the order of the bits, so bit 0 becomes bit 63
+ */
+RAPIDFUZZ_CONSTEXPR_CXX14 uint64_t bit_reverse(uint64_t x)
+{
+    x = ((x >> 1) & UINT64_C(0x5555555555555555)) | ((x & UINT64_C(0x5555555555555555)) << 1);
+    x = ((x >> 2) & UINT64_C(0x3333333333333333)) | ((x & UINT64_C(0x3333333333333333)) << 2);
+    x = ((x >> 4) & UINT64_C(0x0F0F0F0F0F0F0F0F)) | ((x & UINT64_C(0x0F0F0F0F0F0F0F0F)) << 4);
+    x = ((x >> 8) & UINT64_C(0x00FF00FF00FF00FF)) | ((x & UINT64_C(0x00FF00FF00FF00FF)) << 8);
+    x = ((x >> 16) & UINT64_C(0x0000FFFF0000FFFF)) | ((x & UINT64_C(0x0000FFFF0000FFFF)) << 16);
+    return (x >> 32) | (x << 32);
+}
+
 template <typename T, T N, T Pos = 0, bool IsEmpty = (N == 0)>
 struct UnrollImpl;
 
@@ -0,0 +1,123 @@
+/* SPDX-License-Identifier: MIT */
+/* Copyright © 2022-present Max Bachmann */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <rapidfuzz/details/Stats.hpp>
+#include <rapidfuzz/details/Workspace.hpp>
+#include <thread>
+#include <vector>
+
+namespace rapidfuzz {
+namespace detail {
+
+/**
+ * @brief resolve the requested worker count
+ *
+ * values < 1 select all available cores. The result is never larger than the
+ * amount of tasks, so no idle threads are started
+ */
+static inline size_t resolve_worker_count(int workers, size_t task_count)
+{
+    size_t worker_count = static_cast<size_t>(workers);
+    if (workers < 1) {
+        worker_count = static_cast<size_t>(std::thread::hardware_concurrency());
+        if (worker_count == 0) worker_count = 1;
+    }
+
+    return std::max<size_t>(1, std::min(worker_count, task_count));
+}
+
+/**
+ * @brief call func(i) for every i in [0, task_count) on up to `workers` threads
+ *
+ * Tasks are handed out one at a time through a shared counter, so uneven task
+ * costs (e.g. queries of very different length) are balanced between the workers.
+ * With a single worker everything runs on the calling thread. The first exception
+ * thrown by func stops the remaining tasks from being started and is rethrown
+ * on the calling thread after all workers joined. Every worker binds its own
+ * Workspace, so the scratch buffers of the scorers are reused between tasks. The
+ * calling thread keeps a Workspace the caller bound.
+ * With RAPIDFUZZ_ENABLE_STATS the counters of the workers are added to the ones of
+ * the calling thread, so they include all tasks.
+ */
+template <typename Func>
+void parallel_for(int workers, size_t task_count, Func&& func)
+{
+    size_t worker_count = resolve_worker_count(workers, task_count);
+    if (worker_count <= 1) {
+        /* keep a Workspace the caller bound */
+        Workspace workspace;
+        WorkspaceGuard guard(bound_workspace() ? *bound_workspace() : workspace);
+        for (size_t i = 0; i < task_count; ++i)
+            func(i);
+        return;
+    }
+
+    std::atomic<size_t> next_task(0);
+    std::atomic<bool> failed(false);
+    std::exception_ptr exception;
+    std::mutex exception_mutex;
+#ifdef RAPIDFUZZ_ENABLE_STATS
+    Stats worker_stats;
+    std::mutex stats_mutex;
+#endif
+
+    Workspace* caller_workspace = bound_workspace();
+    auto worker = [&](bool spawned) {
+        Workspace workspace;
+        WorkspaceGuard guard((!spawned && caller_workspace) ? *caller_workspace : workspace);
+        while (!failed.load(std::memory_order_relaxed)) {
+            size_t i = next_task.fetch_add(1, std::memory_order_relaxed);
+            if (i >= task_count) break;
+
+            try {
+                func(i);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(exception_mutex);
+                if (!exception) exception = std::current_exception();
+                failed.store(true, std::memory_order_relaxed);
+            }
+        }
+
+#ifdef RAPIDFUZZ_ENABLE_STATS
+        /* the counters of the spawned threads are lost when they exit */
+        if (spawned) {
+            std::lock_guard<std::mutex> lock(stats_mutex);
+            worker_stats += thread_stats();
+        }
+#else
+        (void)spawned;
+#endif
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(worker_count - 1);
+    try {
+        for (size_t i = 1; i < worker_count; ++i)
+            threads.emplace_back(worker, true);
+    }
+    catch (...) {
+        /* thread creation failed -> finish the work with the threads we got */
+    }
+
+    worker(false);
+
+    for (auto& thread : threads)
+        thread.join();
+
+#ifdef RAPIDFUZZ_ENABLE_STATS
+    thread_stats() += worker_stats;
+#endif
+
+    if (exception) std::rethrow_exception(exception);
+}
+
+} // namespace detail
+} // namespace rapidfuzz
@@ -1,4 +1,3 @@
-
 /* SPDX-License-Identifier: MIT */
 /* Copyright © 2022 Max Bachmann */
 #pragma once
@@ -6,16 +5,45 @@
 /* RAPIDFUZZ_LTO_HACK is used to differentiate functions between different
  * translation units to avoid warnings when using lto */
 #ifndef RAPIDFUZZ_EXCLUDE_SIMD
-#    if __AVX2__
+#    if defined(__AVX512F__) && defined(__AVX512BW__)
+#        define RAPIDFUZZ_SIMD
+#        define RAPIDFUZZ_AVX512
+#        define RAPIDFUZZ_LTO_HACK 3
+#        include <rapidfuzz/details/simd_avx512.hpp>
+
+#    elif __AVX2__
 #        define RAPIDFUZZ_SIMD
 #        define RAPIDFUZZ_AVX2
 #        define RAPIDFUZZ_LTO_HACK 0
-#        include <rapidfuzz/details/simd_avx2.hpp>
 
 #    elif (defined(_M_AMD64) || defined(_M_X64)) || defined(__SSE2__)
 #        define RAPIDFUZZ_SIMD
 #        define RAPIDFUZZ_SSE2
-#        define RAPIDFUZZ_LTO_HACK 1
 #        include <rapidfuzz/details/simd_sse2.hpp>
+
+/* RAPIDFUZZ_RUNTIME_DISPATCH additionally compiles the AVX2 kernels and
+ * selects them at runtime when the CPU supports AVX2. The Multi* scorers use the
+ * memory layout of AVX2 in this case, which the SSE2 kernels can process as well */
+#        ifdef RAPIDFUZZ_RUNTIME_DISPATCH
+#            define RAPIDFUZZ_AVX2_DISPATCH
+#            define RAPIDFUZZ_LTO_HACK 2
+#        else
+#            define RAPIDFUZZ_LTO_HACK 1
+#        endif
+#    endif
+
+/* simd_avx2.hpp is only included in a single place, since the amalgamation
+ * only expands the first include of each header */
+#    if defined(RAPIDFUZZ_AVX2) || defined(RAPIDFUZZ_AVX2_DISPATCH)
+#        ifdef RAPIDFUZZ_AVX2_DISPATCH
+#            include <rapidfuzz/details/simd_dispatch.hpp>
+#        else
+#            define RAPIDFUZZ_AVX2_TARGET_BEGIN
+#            define RAPIDFUZZ_AVX2_TARGET_END
+#        endif
+
+RAPIDFUZZ_AVX2_TARGET_BEGIN
+#        include <rapidfuzz/details/simd_avx2.hpp>
+RAPIDFUZZ_AVX2_TARGET_END
 #    endif
-#endif
\ No newline at end of file
+#endif
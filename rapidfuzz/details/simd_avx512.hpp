@@ -0,0 +1,760 @@
+/* SPDX-License-Identifier: MIT */
+/* Copyright © 2022-present Max Bachmann */
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <immintrin.h>
+#include <limits>
+#include <ostream>
+#include <rapidfuzz/details/intrinsics.hpp>
+#include <stdint.h>
+
+/* requires AVX512F and AVX512BW. The popcount instructions of AVX512VPOPCNTDQ
+ * and AVX512BITALG are used when they are available.
+ *
+ * Before GCC 13 several of the unmasked AVX512F intrinsics pass _mm512_undefined_epi32()
+ * as source, which triggers -Wmaybe-uninitialized once they are inlined. These use the
+ * zero masked variants with all elements selected instead */
+
+namespace rapidfuzz {
+namespace detail {
+namespace simd_avx512 {
+
+template <typename T>
+class native_simd;
+
+template <>
+class native_simd<uint64_t> {
+public:
+    using value_type = uint64_t;
+    using mask_type = __mmask8;
+
+    static constexpr int alignment = 64;
+    static const int size = 8;
+    __m512i xmm;
+
+    native_simd() noexcept
+    {}
+
+    native_simd(__m512i val) noexcept : xmm(val)
+    {}
+
+    native_simd(uint64_t a) noexcept
+    {
+        xmm = _mm512_set1_epi64(static_cast<long long>(a));
+    }
+
+    native_simd(const uint64_t* p) noexcept
+    {
+        load(p);
+    }
+
+    operator __m512i() const noexcept
+    {
+        return xmm;
+    }
+
+    native_simd load(const uint64_t* p) noexcept
+    {
+        xmm = _mm512_loadu_si512(reinterpret_cast<const void*>(p));
+        return *this;
+    }
+
+    void store(uint64_t* p) const noexcept
+    {
+        _mm512_store_si512(reinterpret_cast<void*>(p), xmm);
+    }
+
+    native_simd operator+(const native_simd b) const noexcept
+    {
+        return _mm512_add_epi64(xmm, b);
+    }
+
+    native_simd& operator+=(const native_simd b) noexcept
+    {
+        xmm = _mm512_add_epi64(xmm, b);
+        return *this;
+    }
+
+    native_simd operator-(const native_simd b) const noexcept
+    {
+        return _mm512_sub_epi64(xmm, b);
+    }
+
+    native_simd operator-() const noexcept
+    {
+        return _mm512_sub_epi64(_mm512_setzero_si512(), xmm);
+    }
+
+    native_simd& operator-=(const native_simd b) noexcept
+    {
+        xmm = _mm512_sub_epi64(xmm, b);
+        return *this;
+    }
+};
+
+template <>
+class native_simd<uint32_t> {
+public:
+    using value_type = uint32_t;
+    using mask_type = __mmask16;
+
+    static constexpr int alignment = 64;
+    static const int size = 16;
+    __m512i xmm;
+
+    native_simd() noexcept
+    {}
+
+    native_simd(__m512i val) noexcept : xmm(val)
+    {}
+
+    native_simd(uint32_t a) noexcept
+    {
+        xmm = _mm512_set1_epi32(static_cast<int>(a));
+    }
+
+    native_simd(const uint64_t* p) noexcept
+    {
+        load(p);
+    }
+
+    operator __m512i() const noexcept
+    {
+        return xmm;
+    }
+
+    native_simd load(const uint64_t* p) noexcept
+    {
+        xmm = _mm512_loadu_si512(reinterpret_cast<const void*>(p));
+        return *this;
+    }
+
+    void store(uint32_t* p) const noexcept
+    {
+        _mm512_store_si512(reinterpret_cast<void*>(p), xmm);
+    }
+
+    native_simd operator+(const native_simd b) const noexcept
+    {
+        return _mm512_add_epi32(xmm, b);
+    }
+
+    native_simd& operator+=(const native_simd b) noexcept
+    {
+        xmm = _mm512_add_epi32(xmm, b);
+        return *this;
+    }
+
+    native_simd operator-(const native_simd b) const noexcept
+    {
+        return _mm512_sub_epi32(xmm, b);
+    }
+
+    native_simd operator-() const noexcept
+    {
+        return _mm512_sub_epi32(_mm512_setzero_si512(), xmm);
+    }
+
+    native_simd& operator-=(const native_simd b) noexcept
+    {
+        xmm = _mm512_sub_epi32(xmm, b);
+        return *this;
+    }
+};
+
+template <>
+class native_simd<uint16_t> {
+public:
+    using value_type = uint16_t;
+    using mask_type = __mmask32;
+
+    static constexpr int alignment = 64;
+    static const int size = 32;
+    __m512i xmm;
+
+    native_simd() noexcept
+    {}
+
+    native_simd(__m512i val) noexcept : xmm(val)
+    {}
+
+    native_simd(uint16_t a) noexcept
+    {
+        xmm = _mm512_set1_epi16(static_cast<short>(a));
+    }
+
+    native_simd(const uint64_t* p) noexcept
+    {
+        load(p);
+    }
+
+    operator __m512i() const noexcept
+    {
+        return xmm;
+    }
+
+    native_simd load(const uint64_t* p) noexcept
+    {
+        xmm = _mm512_loadu_si512(reinterpret_cast<const void*>(p));
+        return *this;
+    }
+
+    void store(uint16_t* p) const noexcept
+    {
+        _mm512_store_si512(reinterpret_cast<void*>(p), xmm);
+    }
+
+    native_simd operator+(const native_simd b) const noexcept
+    {
+        return _mm512_add_epi16(xmm, b);
+    }
+
+    native_simd& operator+=(const native_simd b) noexcept
+    {
+        xmm = _mm512_add_epi16(xmm, b);
+        return *this;
+    }
+
+    native_simd operator-(const native_simd b) const noexcept
+    {
+        return _mm512_sub_epi16(xmm, b);
+    }
+
+    native_simd operator-() const noexcept
+    {
+        return _mm512_sub_epi16(_mm512_setzero_si512(), xmm);
+    }
+
+    native_simd& operator-=(const native_simd b) noexcept
+    {
+        xmm = _mm512_sub_epi16(xmm, b);
+        return *this;
+    }
+};
+
+template <>
+class native_simd<uint8_t> {
+public:
+    using value_type = uint8_t;
+    using mask_type = __mmask64;
+
+    static constexpr int alignment = 64;
+    static const int size = 64;
+    __m512i xmm;
+
+    native_simd() noexcept
+    {}
+
+    native_simd(__m512i val) noexcept : xmm(val)
+    {}
+
+    native_simd(uint8_t a) noexcept
+    {
+        xmm = _mm512_set1_epi8(static_cast<char>(a));
+    }
+
+    native_simd(const uint64_t* p) noexcept
+    {
+        load(p);
+    }
+
+    operator __m512i() const noexcept
+    {
+        return xmm;
+    }
+
+    native_simd load(const uint64_t* p) noexcept
+    {
+        xmm = _mm512_loadu_si512(reinterpret_cast<const void*>(p));
+        return *this;
+    }
+
+    void store(uint8_t* p) const noexcept
+    {
+        _mm512_store_si512(reinterpret_cast<void*>(p), xmm);
+    }
+
+    native_simd operator+(const native_simd b) const noexcept
+    {
+        return _mm512_add_epi8(xmm, b);
+    }
+
+    native_simd& operator+=(const native_simd b) noexcept
+    {
+        xmm = _mm512_add_epi8(xmm, b);
+        return *this;
+    }
+
+    native_simd operator-(const native_simd b) const noexcept
+    {
+        return _mm512_sub_epi8(xmm, b);
+    }
+
+    native_simd operator-() const noexcept
+    {
+        return _mm512_sub_epi8(_mm512_setzero_si512(), xmm);
+    }
+
+    native_simd& operator-=(const native_simd b) noexcept
+    {
+        xmm = _mm512_sub_epi8(xmm, b);
+        return *this;
+    }
+};
+
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const native_simd<T>& a)
+{
+    alignas(native_simd<T>::alignment) std::array<T, native_simd<T>::size> res;
+    a.store(&res[0]);
+
+    for (size_t i = res.size() - 1; i != 0; i--)
+        os << std::bitset<std::numeric_limits<T>::digits>(res[i]) << "|";
+
+    os << std::bitset<std::numeric_limits<T>::digits>(res[0]);
+    return os;
+}
+
+/* converts the result of a mask register compare into a vector with all bits of
+ * the selected elements set, which is what the compare operators of sse2/avx2 return */
+template <typename T>
+native_simd<T> to_vector(typename native_simd<T>::mask_type k) noexcept;
+
+template <>
+inline native_simd<uint8_t> to_vector<uint8_t>(__mmask64 k) noexcept
+{
+    return _mm512_maskz_set1_epi8(k, static_cast<char>(-1));
+}
+
+template <>
+inline native_simd<uint16_t> to_vector<uint16_t>(__mmask32 k) noexcept
+{
+    return _mm512_maskz_set1_epi16(k, static_cast<short>(-1));
+}
+
+template <>
+inline native_simd<uint32_t> to_vector<uint32_t>(__mmask16 k) noexcept
+{
+    return _mm512_maskz_set1_epi32(k, -1);
+}
+
+template <>
+inline native_simd<uint64_t> to_vector<uint64_t>(__mmask8 k) noexcept
+{
+    return _mm512_maskz_set1_epi64(k, -1);
+}
+
+template <typename T>
+__m512i hadd_impl(__m512i x) noexcept;
+
+template <>
+inline __m512i hadd_impl<uint8_t>(__m512i x) noexcept
+{
+    return x;
+}
+
+template <>
+inline __m512i hadd_impl<uint16_t>(__m512i x) noexcept
+{
+    const __m512i mask = _mm512_set1_epi16(0x001f);
+    __m512i y = _mm512_bsrli_epi128(x, 1);
+    x = _mm512_add_epi16(x, y);
+    return _mm512_and_si512(x, mask);
+}
+
+template <>
+inline __m512i hadd_impl<uint32_t>(__m512i x) noexcept
+{
+    const __m512i mask = _mm512_set1_epi32(0x0000003F);
+    x = hadd_impl<uint16_t>(x);
+    __m512i y = _mm512_bsrli_epi128(x, 2);
+    x = _mm512_add_epi32(x, y);
+    return _mm512_and_si512(x, mask);
+}
+
+template <>
+inline __m512i hadd_impl<uint64_t>(__m512i x) noexcept
+{
+    return _mm512_sad_epu8(x, _mm512_setzero_si512());
+}
+
+/* lookup table based popcount from `Faster Population Counts Using AVX2 Instructions`.
+ * Only used when the CPU lacks the AVX512 popcount instructions for the element size */
+template <typename T>
+native_simd<T> popcount_impl(const native_simd<T>& v) noexcept
+{
+    __m512i lookup =
+        _mm512_maskz_broadcast_i32x4(0xFFFF, _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4));
+    const __m512i low_mask = _mm512_set1_epi8(0x0F);
+    __m512i lo = _mm512_and_si512(v, low_mask);
+    __m512i hi = _mm512_and_si512(_mm512_maskz_srli_epi32(0xFFFF, v, 4), low_mask);
+    __m512i popcnt1 = _mm512_shuffle_epi8(lookup, lo);
+    __m512i popcnt2 = _mm512_shuffle_epi8(lookup, hi);
+    __m512i total = _mm512_add_epi8(popcnt1, popcnt2);
+    return hadd_impl<T>(total);
+}
+
+#ifdef __AVX512VPOPCNTDQ__
+static inline native_simd<uint64_t> popcount_impl(const native_simd<uint64_t>& v) noexcept
+{
+    return _mm512_popcnt_epi64(v);
+}
+
+static inline native_simd<uint32_t> popcount_impl(const native_simd<uint32_t>& v) noexcept
+{
+    return _mm512_popcnt_epi32(v);
+}
+#endif
+
+#ifdef __AVX512BITALG__
+static inline native_simd<uint16_t> popcount_impl(const native_simd<uint16_t>& v) noexcept
+{
+    return _mm512_popcnt_epi16(v);
+}
+
+static inline native_simd<uint8_t> popcount_impl(const native_simd<uint8_t>& v) noexcept
+{
+    return _mm512_popcnt_epi8(v);
+}
+#endif
+
+template <typename T>
+std::array<T, native_simd<T>::size> popcount(const native_simd<T>& a) noexcept
+{
+    alignas(native_simd<T>::alignment) std::array<T, native_simd<T>::size> res;
+    popcount_impl(a).store(&res[0]);
+    return res;
+}
+
+// function andnot: a & ~ b
+template <typename T>
+native_simd<T> andnot(const native_simd<T>& a, const native_simd<T>& b)
+{
+    /* 0x30 is the truth table of a & ~b. gcc warns about _mm512_andnot_si512 using an
+     * uninitialized value when it is inlined */
+    return _mm512_ternarylogic_epi64(a, b, b, 0x30);
+}
+
+/* mask of all elements with (a & b) != 0 */
+static inline __mmask64 test_mask(const native_simd<uint8_t>& a, const native_simd<uint8_t>& b) noexcept
+{
+    return _mm512_test_epi8_mask(a, b);
+}
+
+static inline __mmask32 test_mask(const native_simd<uint16_t>& a, const native_simd<uint16_t>& b) noexcept
+{
+    return _mm512_test_epi16_mask(a, b);
+}
+
+static inline __mmask16 test_mask(const native_simd<uint32_t>& a, const native_simd<uint32_t>& b) noexcept
+{
+    return _mm512_test_epi32_mask(a, b);
+}
+
+static inline __mmask8 test_mask(const native_simd<uint64_t>& a, const native_simd<uint64_t>& b) noexcept
+{
+    return _mm512_test_epi64_mask(a, b);
+}
+
+/* a + b for all elements selected by k. The other elements keep the value of a */
+static inline native_simd<uint8_t> mask_add(const native_simd<uint8_t>& a, __mmask64 k,
+                                            const native_simd<uint8_t>& b) noexcept
+{
+    return _mm512_mask_add_epi8(a, k, a, b);
+}
+
+static inline native_simd<uint16_t> mask_add(const native_simd<uint16_t>& a, __mmask32 k,
+                                             const native_simd<uint16_t>& b) noexcept
+{
+    return _mm512_mask_add_epi16(a, k, a, b);
+}
+
+static inline native_simd<uint32_t> mask_add(const native_simd<uint32_t>& a, __mmask16 k,
+                                             const native_simd<uint32_t>& b) noexcept
+{
+    return _mm512_mask_add_epi32(a, k, a, b);
+}
+
+static inline native_simd<uint64_t> mask_add(const native_simd<uint64_t>& a, __mmask8 k,
+                                             const native_simd<uint64_t>& b) noexcept
+{
+    return _mm512_mask_add_epi64(a, k, a, b);
+}
+
+/* a - b for all elements selected by k. The other elements keep the value of a */
+static inline native_simd<uint8_t> mask_sub(const native_simd<uint8_t>& a, __mmask64 k,
+                                            const native_simd<uint8_t>& b) noexcept
+{
+    return _mm512_mask_sub_epi8(a, k, a, b);
+}
+
+static inline native_simd<uint16_t> mask_sub(const native_simd<uint16_t>& a, __mmask32 k,
+                                             const native_simd<uint16_t>& b) noexcept
+{
+    return _mm512_mask_sub_epi16(a, k, a, b);
+}
+
+static inline native_simd<uint32_t> mask_sub(const native_simd<uint32_t>& a, __mmask16 k,
+                                             const native_simd<uint32_t>& b) noexcept
+{
+    return _mm512_mask_sub_epi32(a, k, a, b);
+}
+
+static inline native_simd<uint64_t> mask_sub(const native_simd<uint64_t>& a, __mmask8 k,
+                                             const native_simd<uint64_t>& b) noexcept
+{
+    return _mm512_mask_sub_epi64(a, k, a, b);
+}
+
+static inline native_simd<uint8_t> operator==(const native_simd<uint8_t>& a,
+                                              const native_simd<uint8_t>& b) noexcept
+{
+    return to_vector<uint8_t>(_mm512_cmpeq_epi8_mask(a, b));
+}
+
+static inline native_simd<uint16_t> operator==(const native_simd<uint16_t>& a,
+                                               const native_simd<uint16_t>& b) noexcept
+{
+    return to_vector<uint16_t>(_mm512_cmpeq_epi16_mask(a, b));
+}
+
+static inline native_simd<uint32_t> operator==(const native_simd<uint32_t>& a,
+                                               const native_simd<uint32_t>& b) noexcept
+{
+    return to_vector<uint32_t>(_mm512_cmpeq_epi32_mask(a, b));
+}
+
+static inline native_simd<uint64_t> operator==(const native_simd<uint64_t>& a,
+                                               const native_simd<uint64_t>& b) noexcept
+{
+    return to_vector<uint64_t>(_mm512_cmpeq_epi64_mask(a, b));
+}
+
+template <typename T>
+static inline native_simd<T> operator!=(const native_simd<T>& a, const native_simd<T>& b) noexcept
+{
+    return ~(a == b);
+}
+
+/* the shifts use the count in a register, since the immediate versions require
+ * a compile time constant when compiling without optimizations */
+static inline native_simd<uint8_t> operator<<(const native_simd<uint8_t>& a, int b) noexcept
+{
+    char mask = static_cast<char>(0xFF >> b);
+    __m512i am = _mm512_and_si512(a, _mm512_set1_epi8(mask));
+    return _mm512_sll_epi16(am, _mm_cvtsi32_si128(b));
+}
+
+static inline native_simd<uint16_t> operator<<(const native_simd<uint16_t>& a, int b) noexcept
+{
+    return _mm512_sll_epi16(a, _mm_cvtsi32_si128(b));
+}
+
+static inline native_simd<uint32_t> operator<<(const native_simd<uint32_t>& a, int b) noexcept
+{
+    return _mm512_maskz_sll_epi32(0xFFFF, a, _mm_cvtsi32_si128(b));
+}
+
+static inline native_simd<uint64_t> operator<<(const native_simd<uint64_t>& a, int b) noexcept
+{
+    return _mm512_maskz_sll_epi64(0xFF, a, _mm_cvtsi32_si128(b));
+}
+
+static inline native_simd<uint8_t> operator>>(const native_simd<uint8_t>& a, int b) noexcept
+{
+    char mask = static_cast<char>(0xFF << b);
+    __m512i am = _mm512_and_si512(a, _mm512_set1_epi8(mask));
+    return _mm512_srl_epi16(am, _mm_cvtsi32_si128(b));
+}
+
+static inline native_simd<uint16_t> operator>>(const native_simd<uint16_t>& a, int b) noexcept
+{
+    return _mm512_srl_epi16(a, _mm_cvtsi32_si128(b));
+}
+
+static inline native_simd<uint32_t> operator>>(const native_simd<uint32_t>& a, int b) noexcept
+{
+    return _mm512_maskz_srl_epi32(0xFFFF, a, _mm_cvtsi32_si128(b));
+}
+
+static inline native_simd<uint64_t> operator>>(const native_simd<uint64_t>& a, int b) noexcept
+{
+    return _mm512_maskz_srl_epi64(0xFF, a, _mm_cvtsi32_si128(b));
+}
+
+template <typename T>
+native_simd<T> operator&(const native_simd<T>& a, const native_simd<T>& b) noexcept
+{
+    return _mm512_and_si512(a, b);
+}
+
+template <typename T>
+native_simd<T> operator&=(native_simd<T>& a, const native_simd<T>& b) noexcept
+{
+    a = a & b;
+    return a;
+}
+
+template <typename T>
+native_simd<T> operator|(const native_simd<T>& a, const native_simd<T>& b) noexcept
+{
+    return _mm512_or_si512(a, b);
+}
+
+template <typename T>
+native_simd<T> operator|=(native_simd<T>& a, const native_simd<T>& b) noexcept
+{
+    a = a | b;
+    return a;
+}
+
+template <typename T>
+native_simd<T> operator^(const native_simd<T>& a, const native_simd<T>& b) noexcept
+{
+    return _mm512_xor_si512(a, b);
+}
+
+template <typename T>
+native_simd<T> operator^=(native_simd<T>& a, const native_simd<T>& b) noexcept
+{
+    a = a ^ b;
+    return a;
+}
+
+template <typename T>
+native_simd<T> operator~(const native_simd<T>& a) noexcept
+{
+    return _mm512_xor_si512(a, _mm512_set1_epi32(-1));
+}
+
+static inline native_simd<uint8_t> operator>=(const native_simd<uint8_t>& a,
+                                              const native_simd<uint8_t>& b) noexcept
+{
+    return to_vector<uint8_t>(_mm512_cmpge_epu8_mask(a, b));
+}
+
+static inline native_simd<uint16_t> operator>=(const native_simd<uint16_t>& a,
+                                               const native_simd<uint16_t>& b) noexcept
+{
+    return to_vector<uint16_t>(_mm512_cmpge_epu16_mask(a, b));
+}
+
+static inline native_simd<uint32_t> operator>=(const native_simd<uint32_t>& a,
+                                               const native_simd<uint32_t>& b) noexcept
+{
+    return to_vector<uint32_t>(_mm512_cmpge_epu32_mask(a, b));
+}
+
+static inline native_simd<uint64_t> operator>=(const native_simd<uint64_t>& a,
+                                               const native_simd<uint64_t>& b) noexcept
+{
+    return to_vector<uint64_t>(_mm512_cmpge_epu64_mask(a, b));
+}
+
+template <typename T>
+static inline native_simd<T> operator<=(const native_simd<T>& a, const native_simd<T>& b) noexcept
+{
+    return b >= a;
+}
+
+static inline native_simd<uint8_t> operator>(const native_simd<uint8_t>& a,
+                                             const native_simd<uint8_t>& b) noexcept
+{
+    return to_vector<uint8_t>(_mm512_cmpgt_epu8_mask(a, b));
+}
+
+static inline native_simd<uint16_t> operator>(const native_simd<uint16_t>& a,
+                                              const native_simd<uint16_t>& b) noexcept
+{
+    return to_vector<uint16_t>(_mm512_cmpgt_epu16_mask(a, b));
+}
+
+static inline native_simd<uint32_t> operator>(const native_simd<uint32_t>& a,
+                                              const native_simd<uint32_t>& b) noexcept
+{
+    return to_vector<uint32_t>(_mm512_cmpgt_epu32_mask(a, b));
+}
+
+static inline native_simd<uint64_t> operator>(const native_simd<uint64_t>& a,
+                                              const native_simd<uint64_t>& b) noexcept
+{
+    return to_vector<uint64_t>(_mm512_cmpgt_epu64_mask(a, b));
+}
+
+template <typename T>
+static inline native_simd<T> operator<(const native_simd<T>& a, const native_simd<T>& b) noexcept
+{
+    return b > a;
+}
+
+template <typename T>
+static inline native_simd<T> max8(const native_simd<T>& a, const native_simd<T>& b) noexcept
+{
+    return _mm512_max_epu8(a, b);
+}
+
+template <typename T>
+static inline native_simd<T> max16(const native_simd<T>& a, const native_simd<T>& b) noexcept
+{
+    return _mm512_max_epu16(a, b);
+}
+
+template <typename T>
+static inline native_simd<T> max32(const native_simd<T>& a, const native_simd<T>& b) noexcept
+{
+    return _mm512_maskz_max_epu32(0xFFFF, a, b);
+}
+
+template <typename T>
+static inline native_simd<T> min8(const native_simd<T>& a, const native_simd<T>& b) noexcept
+{
+    return _mm512_min_epu8(a, b);
+}
+
+template <typename T>
+static inline native_simd<T> min16(const native_simd<T>& a, const native_simd<T>& b) noexcept
+{
+    return _mm512_min_epu16(a, b);
+}
+
+template <typename T>
+static inline native_simd<T> min32(const native_simd<T>& a, const native_simd<T>& b) noexcept
+{
+    return _mm512_maskz_min_epu32(0xFFFF, a, b);
+}
+
+/* there is no variable 8 bit shift, so the low and high byte of each 16 bit element are
+ * shifted separately. Counts >= 8 move all bits out of the byte, which results in 0 */
+static inline native_simd<uint8_t> sllv(const native_simd<uint8_t>& a,
+                                        const native_simd<uint8_t>& count) noexcept
+{
+    const __m512i low_byte = _mm512_set1_epi16(0x00FF);
+    const __m512i high_byte = _mm512_set1_epi16(static_cast<short>(0xFF00));
+    __m512i lo = _mm512_and_si512(_mm512_sllv_epi16(a, _mm512_and_si512(count, low_byte)), low_byte);
+    __m512i hi = _mm512_sllv_epi16(_mm512_and_si512(a, high_byte), _mm512_srli_epi16(count, 8));
+    return _mm512_or_si512(lo, hi);
+}
+
+static inline native_simd<uint16_t> sllv(const native_simd<uint16_t>& a,
+                                         const native_simd<uint16_t>& count) noexcept
+{
+    return _mm512_sllv_epi16(a, count);
+}
+
+static inline native_simd<uint32_t> sllv(const native_simd<uint32_t>& a,
+                                         const native_simd<uint32_t>& count) noexcept
+{
+    return _mm512_maskz_sllv_epi32(0xFFFF, a, count);
+}
+
+static inline native_simd<uint64_t> sllv(const native_simd<uint64_t>& a,
+                                         const native_simd<uint64_t>& count) noexcept
+{
+    return _mm512_maskz_sllv_epi64(0xFF, a, count);
+}
+
+} // namespace simd_avx512
+} // namespace detail
+} // namespace rapidfuzz
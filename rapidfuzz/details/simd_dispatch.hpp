@@ -0,0 +1,136 @@
+/* SPDX-License-Identifier: MIT */
+/* Copyright © 2022-present Max Bachmann */
+#pragma once
+
+/* Runtime dispatch between the SSE2 and AVX2 kernels (RAPIDFUZZ_RUNTIME_DISPATCH).
+ * simd.hpp includes simd_avx2.hpp between RAPIDFUZZ_AVX2_TARGET_BEGIN/END, so the AVX2
+ * kernels are compiled with a function level target attribute, while the rest of the
+ * translation unit keeps using the baseline instruction set. Every header required by
+ * simd_avx2.hpp is included here before the target region is entered, so no code outside
+ * of the AVX2 kernels is compiled for AVX2 */
+#include <array>
+#include <immintrin.h>
+#include <ostream>
+#include <rapidfuzz/details/intrinsics.hpp>
+#include <stdint.h>
+#include <utility>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#    include <intrin.h>
+#endif
+
+#if defined(__clang__)
+#    define RAPIDFUZZ_AVX2_TARGET_BEGIN                                                                     \
+        _Pragma("clang attribute push(__attribute__((target(\"avx2\"))), apply_to = function)")
+#    define RAPIDFUZZ_AVX2_TARGET_END _Pragma("clang attribute pop")
+#elif defined(__GNUC__)
+#    define RAPIDFUZZ_AVX2_TARGET_BEGIN _Pragma("GCC push_options") _Pragma("GCC target(\"avx2\")")
+#    define RAPIDFUZZ_AVX2_TARGET_END _Pragma("GCC pop_options")
+#else
+/* msvc allows the usage of AVX2 intrinsics without changing the target */
+#    define RAPIDFUZZ_AVX2_TARGET_BEGIN
+#    define RAPIDFUZZ_AVX2_TARGET_END
+#endif
+
+RAPIDFUZZ_AVX2_TARGET_BEGIN
+namespace rapidfuzz {
+namespace detail {
+namespace avx2 {
+
+/* copies of the generic helpers from intrinsics.hpp used by the AVX2 kernels. The
+ * originals are compiled for the baseline instruction set, so neither the AVX2 lambdas
+ * passed into unroll nor the AVX2 vector operations in blsi/blsr could be inlined */
+template <typename T, T N, T Pos = 0, bool IsEmpty = (N == 0)>
+struct UnrollImpl;
+
+template <typename T, T N, T Pos>
+struct UnrollImpl<T, N, Pos, false> {
+    template <typename F>
+    static void call(F&& f)
+    {
+        f(Pos);
+        UnrollImpl<T, N - 1, Pos + 1>::call(std::forward<F>(f));
+    }
+};
+
+template <typename T, T N, T Pos>
+struct UnrollImpl<T, N, Pos, true> {
+    template <typename F>
+    static void call(F&&)
+    {}
+};
+
+template <typename T, T N, class F>
+RAPIDFUZZ_CONSTEXPR_CXX14 void unroll(F&& f)
+{
+    UnrollImpl<T, N>::call(f);
+}
+
+template <typename T>
+constexpr T blsi(T a)
+{
+#if _MSC_VER && !defined(__clang__)
+#    pragma warning(push)
+/* unary minus operator applied to unsigned type, result still unsigned */
+#    pragma warning(disable : 4146)
+#endif
+    return a & -a;
+#if _MSC_VER && !defined(__clang__)
+#    pragma warning(pop)
+#endif
+}
+
+template <typename T>
+constexpr T blsr(T x)
+{
+    return x & (x - 1);
+}
+
+} // namespace avx2
+} // namespace detail
+} // namespace rapidfuzz
+RAPIDFUZZ_AVX2_TARGET_END
+
+namespace rapidfuzz {
+namespace detail {
+
+static inline bool cpu_supports_avx2_impl()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+
+    /* the OS has to support saving the ymm registers */
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    /* this checks the OS support for the ymm registers as well */
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+/**
+ * @brief returns whether the AVX2 kernels can be used on this CPU
+ *
+ * The cpuid check is only performed on the first call. RAPIDFUZZ_DISPATCH_FORCE_SSE2 selects the
+ * SSE2 kernels on every CPU, so the tests can cover them on machines supporting AVX2
+ */
+static inline bool cpu_supports_avx2()
+{
+#ifdef RAPIDFUZZ_DISPATCH_FORCE_SSE2
+    return false;
+#else
+    static const bool supported = cpu_supports_avx2_impl();
+    return supported;
+#endif
+}
+
+} // namespace detail
+} // namespace rapidfuzz
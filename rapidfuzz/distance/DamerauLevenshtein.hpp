@@ -1,6 +1,7 @@
 /* SPDX-License-Identifier: MIT */
 /* Copyright © 2022-present Max Bachmann */
 
+#pragma once
 #include <algorithm>
 #include <rapidfuzz/distance/DamerauLevenshtein_impl.hpp>
 
@@ -109,6 +110,157 @@ double damerau_levenshtein_normalized_similarity(const Sentence1& s1, const Sent
     return detail::DamerauLevenshtein::normalized_similarity(s1, s2, score_cutoff, score_cutoff);
 }
 
+#ifdef RAPIDFUZZ_SIMD
+/**
+ * @brief Damerau Levenshtein distance between a string and multiple short strings
+ *
+ * The OSA distance of all strings is calculated using SIMD and used as filter.
+ * Only strings with an OSA distance between 3 and 2 * score_cutoff require the banded DP.
+ */
+template <int MaxLen>
+struct MultiDamerauLevenshtein
+    : public detail::MultiDistanceBase<MultiDamerauLevenshtein<MaxLen>, size_t, 0,
+                                       std::numeric_limits<int64_t>::max()> {
+private:
+    friend detail::MultiDistanceBase<MultiDamerauLevenshtein<MaxLen>, size_t, 0,
+                                     std::numeric_limits<int64_t>::max()>;
+    friend detail::MultiNormalizedMetricBase<MultiDamerauLevenshtein<MaxLen>, size_t>;
+
+    RAPIDFUZZ_CONSTEXPR_CXX14 static size_t get_vec_size()
+    {
+#    if defined(RAPIDFUZZ_AVX512)
+        using namespace detail::simd_avx512;
+#    elif defined(RAPIDFUZZ_AVX2) || defined(RAPIDFUZZ_AVX2_DISPATCH)
+        using namespace detail::simd_avx2;
+#    else
+        using namespace detail::simd_sse2;
+#    endif
+        RAPIDFUZZ_IF_CONSTEXPR (MaxLen <= 8)
+            return native_simd<uint8_t>::size;
+        else RAPIDFUZZ_IF_CONSTEXPR (MaxLen <= 16)
+            return native_simd<uint16_t>::size;
+        else RAPIDFUZZ_IF_CONSTEXPR (MaxLen <= 32)
+            return native_simd<uint32_t>::size;
+        else RAPIDFUZZ_IF_CONSTEXPR (MaxLen <= 64)
+            return native_simd<uint64_t>::size;
+
+        static_assert(MaxLen <= 64, "expected MaxLen <= 64");
+    }
+
+    static size_t find_block_count(size_t count)
+    {
+        size_t vec_size = get_vec_size();
+        size_t simd_vec_count = detail::ceil_div(count, vec_size);
+        return detail::ceil_div(simd_vec_count * vec_size * MaxLen, 64);
+    }
+
+public:
+    MultiDamerauLevenshtein(size_t count) : input_count(count), PM(find_block_count(count) * 64)
+    {
+        str_lens.resize(result_count());
+        str_data.resize(result_count() * MaxLen);
+    }
+
+    /**
+     * @brief get minimum size required for result vectors passed into
+     * - distance
+     * - similarity
+     * - normalized_distance
+     * - normalized_similarity
+     *
+     * @return minimum vector size
+     */
+    size_t result_count() const
+    {
+        size_t vec_size = get_vec_size();
+        size_t simd_vec_count = detail::ceil_div(input_count, vec_size);
+        return simd_vec_count * vec_size;
+    }
+
+    template <typename Sentence1>
+    void insert(const Sentence1& s1_)
+    {
+        insert(detail::to_begin(s1_), detail::to_end(s1_));
+    }
+
+    template <typename InputIt1>
+    void insert(InputIt1 first1, InputIt1 last1)
+    {
+        auto len = std::distance(first1, last1);
+        int block_pos = static_cast<int>((pos * MaxLen) % 64);
+        auto block = (pos * MaxLen) / 64;
+        assert(len <= MaxLen);
+
+        if (pos >= input_count) throw std::invalid_argument("out of bounds insert");
+
+        str_lens[pos] = static_cast<size_t>(len);
+        auto data = str_data.begin() + static_cast<ptrdiff_t>(pos * MaxLen);
+        for (; first1 != last1; ++first1) {
+            PM.insert(block, *first1, block_pos);
+            *data++ = detail::multi_char(*first1);
+            block_pos++;
+        }
+        pos++;
+    }
+
+private:
+    template <typename InputIt2>
+    void _distance(size_t* scores, size_t score_count, const detail::Range<InputIt2>& s2,
+                   size_t score_cutoff = std::numeric_limits<size_t>::max()) const
+    {
+        if (score_count < result_count())
+            throw std::invalid_argument("scores has to have >= result_count() elements");
+
+        auto scores_ = detail::make_range(scores, scores + score_count);
+        size_t osa_cutoff = detail::damerau_levenshtein_osa_cutoff(score_cutoff);
+        RAPIDFUZZ_IF_CONSTEXPR (MaxLen == 8)
+            detail::osa_hyrroe2003_simd<uint8_t>(scores_, PM, str_lens, s2, osa_cutoff);
+        else RAPIDFUZZ_IF_CONSTEXPR (MaxLen == 16)
+            detail::osa_hyrroe2003_simd<uint16_t>(scores_, PM, str_lens, s2, osa_cutoff);
+        else RAPIDFUZZ_IF_CONSTEXPR (MaxLen == 32)
+            detail::osa_hyrroe2003_simd<uint32_t>(scores_, PM, str_lens, s2, osa_cutoff);
+        else RAPIDFUZZ_IF_CONSTEXPR (MaxLen == 64)
+            detail::osa_hyrroe2003_simd<uint64_t>(scores_, PM, str_lens, s2, osa_cutoff);
+
+        /* s2 is converted the same way as the stored strings, so both use the keys of the pattern
+         * match vector */
+        detail::ScratchFrame frame;
+        detail::ScratchVector<uint64_t> s2_data;
+        s2_data.reserve(s2.size());
+        for (const auto& ch : s2)
+            s2_data.push_back(detail::multi_char(ch));
+        auto s2_ = detail::make_range(s2_data.data(), s2_data.data() + s2_data.size());
+
+        for (size_t i = 0; i < input_count; ++i) {
+            auto s1 = detail::make_range(&str_data[i * MaxLen], &str_data[i * MaxLen] + str_lens[i]);
+            if (s1.empty() || s2_.empty()) {
+                scores[i] = (scores[i] <= score_cutoff) ? scores[i] : score_cutoff + 1;
+                continue;
+            }
+
+            scores[i] = detail::damerau_levenshtein_distance_from_osa(scores[i], s1, s2_, score_cutoff);
+        }
+    }
+
+    template <typename InputIt2>
+    size_t maximum(size_t s1_idx, const detail::Range<InputIt2>& s2) const
+    {
+        return std::max(str_lens[s1_idx], s2.size());
+    }
+
+    size_t get_input_count() const noexcept
+    {
+        return input_count;
+    }
+
+    size_t input_count;
+    size_t pos = 0;
+    detail::BlockPatternMatchVector PM;
+    std::vector<size_t> str_lens;
+    std::vector<uint64_t> str_data;
+};
+#endif
+
 template <typename CharT1>
 struct CachedDamerauLevenshtein : public detail::CachedDistanceBase<CachedDamerauLevenshtein<CharT1>, size_t,
                                                                     0, std::numeric_limits<int64_t>::max()> {
@@ -118,14 +270,32 @@ struct CachedDamerauLevenshtein : public detail::CachedDistanceBase<CachedDamera
     {}
 
     template <typename InputIt1>
-    CachedDamerauLevenshtein(InputIt1 first1, InputIt1 last1) : s1(first1, last1)
+    CachedDamerauLevenshtein(InputIt1 first1, InputIt1 last1)
+        : s1(first1, last1), PM(detail::make_range(first1, last1))
     {}
 
+    /**
+     * @brief stores the precomputed bitvectors of s1 in a compact layout
+     * (see CachedLevenshtein::shrink_to_fit)
+     */
+    void shrink_to_fit()
+    {
+        if (is_compact() || !PM.size()) return;
+
+        compact_PM = detail::CompactBlockPatternMatchVector(PM);
+        PM = detail::BlockPatternMatchVector(0);
+    }
+
 private:
     friend detail::CachedDistanceBase<CachedDamerauLevenshtein<CharT1>, size_t, 0,
                                       std::numeric_limits<int64_t>::max()>;
     friend detail::CachedNormalizedMetricBase<CachedDamerauLevenshtein<CharT1>>;
 
+    bool is_compact() const noexcept
+    {
+        return compact_PM.size() != 0;
+    }
+
     template <typename InputIt2>
     size_t maximum(const detail::Range<InputIt2>& s2) const
     {
@@ -135,10 +305,18 @@ private:
     template <typename InputIt2>
     size_t _distance(const detail::Range<InputIt2>& s2, size_t score_cutoff, size_t) const
     {
-        return rapidfuzz::experimental::damerau_levenshtein_distance(s1, s2, score_cutoff);
+        size_t res;
+        if (is_compact())
+            res = detail::damerau_levenshtein_distance(compact_PM, detail::make_range(s1), s2, score_cutoff);
+        else
+            res = detail::damerau_levenshtein_distance(PM, detail::make_range(s1), s2, score_cutoff);
+
+        return (res <= score_cutoff) ? res : score_cutoff + 1;
     }
 
     std::vector<CharT1> s1;
+    detail::BlockPatternMatchVector PM;
+    detail::CompactBlockPatternMatchVector compact_PM;
 };
 
 #ifdef RAPIDFUZZ_DEDUCTION_GUIDES
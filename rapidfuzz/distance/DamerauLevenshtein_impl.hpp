@@ -3,6 +3,7 @@
 
 #include <cassert>
 #include <cstddef>
+#include <cstdlib>
 #include <limits>
 #include <numeric>
 #include <rapidfuzz/details/GrowingHashmap.hpp>
@@ -10,6 +11,7 @@
 #include <rapidfuzz/details/Range.hpp>
 #include <rapidfuzz/details/common.hpp>
 #include <rapidfuzz/details/distance.hpp>
+#include <rapidfuzz/distance/OSA_impl.hpp>
 
 namespace rapidfuzz {
 namespace detail {
@@ -32,6 +34,10 @@ struct RowId {
  * based on the paper
  * "Linear space string correction algorithm using the Damerau-Levenshtein distance"
  * from Chunchun Zhao and Sartaj Sahni
+ *
+ * Only the cells inside of the band |i - j| <= max are calculated, since no other cell
+ * can be part of an alignment with a distance <= max. Cells outside of the band are
+ * treated as maxVal
  */
 template <typename IntType, typename InputIt1, typename InputIt2>
 size_t damerau_levenshtein_distance_zhao(const Range<InputIt1>& s1, const Range<InputIt2>& s2, size_t max)
@@ -41,13 +47,21 @@ size_t damerau_levenshtein_distance_zhao(const Range<InputIt1>& s1, const Range<
     IntType len2 = static_cast<IntType>(s2.size());
     IntType maxVal = static_cast<IntType>(std::max(len1, len2) + 1);
     assert(std::numeric_limits<IntType>::max() > maxVal);
+    RAPIDFUZZ_STATS_CALL(DamerauLevenshteinZhao, 0);
+    if (abs_diff(s1.size(), s2.size()) > max) {
+        RAPIDFUZZ_STATS_EARLY_EXIT(DamerauLevenshteinZhao);
+        return max + 1;
+    }
+
+    int64_t band = static_cast<int64_t>(std::min(max, static_cast<size_t>(maxVal)));
 
+    ScratchFrame frame;
     HybridGrowingHashmap<typename Range<InputIt1>::value_type, RowId<IntType>> last_row_id;
     size_t size = s2.size() + 2;
     assume(size != 0);
-    std::vector<IntType> FR_arr(size, maxVal);
-    std::vector<IntType> R1_arr(size, maxVal);
-    std::vector<IntType> R_arr(size);
+    ScratchVector<IntType> FR_arr(size, maxVal);
+    ScratchVector<IntType> R1_arr(size, maxVal);
+    ScratchVector<IntType> R_arr(size);
     R_arr[0] = maxVal;
     std::iota(R_arr.begin() + 1, R_arr.end(), IntType(0));
 
@@ -56,21 +70,30 @@ size_t damerau_levenshtein_distance_zhao(const Range<InputIt1>& s1, const Range<
     IntType* FR = &FR_arr[1];
 
     auto iter_s1 = s1.begin();
+    auto band_start = s2.begin();
     for (IntType i = 1; i <= len1; i++) {
         std::swap(R, R1);
+        IntType first_col = static_cast<IntType>(std::max<int64_t>(1, i - band));
+        IntType last_col = static_cast<IntType>(std::min<int64_t>(len2, i + band));
+        RAPIDFUZZ_STATS_WORDS(DamerauLevenshteinZhao, std::max<int64_t>(0, last_col - first_col + 1));
+
         IntType last_col_id = -1;
-        IntType last_i2l1 = R[0];
+        IntType last_i2l1 = R[first_col - 1];
         R[0] = i;
+        if (first_col > 1) {
+            R[first_col - 1] = maxVal;
+            ++band_start;
+        }
         IntType T = maxVal;
 
-        auto iter_s2 = s2.begin();
-        for (IntType j = 1; j <= len2; j++) {
-            int64_t diag = R1[j - 1] + static_cast<IntType>(*iter_s1 != *iter_s2);
+        auto iter_s2 = band_start;
+        for (IntType j = first_col; j <= last_col; j++) {
+            int64_t diag = R1[j - 1] + static_cast<IntType>(!char_equal(*iter_s1, *iter_s2));
             int64_t left = R[j - 1] + 1;
             int64_t up = R1[j] + 1;
             int64_t temp = std::min({diag, left, up});
 
-            if (*iter_s1 == *iter_s2) {
+            if (char_equal(*iter_s1, *iter_s2)) {
                 last_col_id = j;   // last occurence of s1_i
                 FR[j] = R1[j - 2]; // save H_k-1,j-2
                 T = last_i2l1;     // save H_i-2,l-1
@@ -80,8 +103,12 @@ size_t damerau_levenshtein_distance_zhao(const Range<InputIt1>& s1, const Range<
                 int64_t l = last_col_id;
 
                 if ((j - l) == 1) {
-                    int64_t transpose = FR[j] + (i - k);
-                    temp = std::min(temp, transpose);
+                    /* FR[j] is outdated when column j was outside of the band in row k.
+                     * A transposition starting there exceeds max anyway */
+                    if (std::abs(j - k) <= band) {
+                        int64_t transpose = FR[j] + (i - k);
+                        temp = std::min(temp, transpose);
+                    }
                 }
                 else if ((i - k) == 1) {
                     int64_t transpose = T + (j - l);
@@ -102,14 +129,58 @@ size_t damerau_levenshtein_distance_zhao(const Range<InputIt1>& s1, const Range<
 }
 
 template <typename InputIt1, typename InputIt2>
-size_t damerau_levenshtein_distance(Range<InputIt1> s1, Range<InputIt2> s2, size_t max)
+size_t damerau_levenshtein_osa(const PatternMatchVector& PM, const Range<InputIt1>& s1,
+                               const Range<InputIt2>& s2, size_t max)
 {
-    size_t min_edits = abs_diff(s1.size(), s2.size());
-    if (min_edits > max) return max + 1;
+    return osa_hyrroe2003(PM, s1, s2, max);
+}
 
-    /* common affix does not effect Levenshtein distance */
+template <typename PM_Vec, typename InputIt1, typename InputIt2>
+size_t damerau_levenshtein_osa(const PM_Vec& PM, const Range<InputIt1>& s1,
+                               const Range<InputIt2>& s2, size_t max)
+{
+    if (s1.size() < 64) return osa_hyrroe2003(PM, s1, s2, max);
+
+    return osa_hyrroe2003_block(PM, s1, s2, max);
+}
+
+/**
+ * @brief score_cutoff passed into the OSA filter for a Damerau Levenshtein score_cutoff of max
+ */
+static inline size_t damerau_levenshtein_osa_cutoff(size_t max)
+{
+    return (max >= std::numeric_limits<size_t>::max() / 2) ? std::numeric_limits<size_t>::max() : 2 * max;
+}
+
+/**
+ * @brief Damerau Levenshtein distance using the OSA distance of both strings as filter
+ *
+ * Every alignment allowed in OSA is allowed in Damerau Levenshtein as well and a
+ * transposition can be replaced by two substitutions, so DL <= OSA <= 2 * DL.
+ * In addition a Damerau Levenshtein distance of 1 is always reached by the same edit in OSA,
+ * so both distances are equal for OSA <= 2. The banded DP is only required for the
+ * remaining cases and can use min(max, OSA) as band width. It runs on the strings without their
+ * common prefix and suffix.
+ *
+ * @param osa_dist OSA distance calculated with damerau_levenshtein_osa_cutoff(max)
+ */
+template <typename InputIt1, typename InputIt2>
+size_t damerau_levenshtein_distance_from_osa(size_t osa_dist, Range<InputIt1> s1, Range<InputIt2> s2,
+                                             size_t max)
+{
+    if (osa_dist > damerau_levenshtein_osa_cutoff(max)) {
+        RAPIDFUZZ_STATS_CALL(DamerauLevenshteinFilter, 0);
+        return max + 1;
+    }
+    if (osa_dist <= 2) {
+        RAPIDFUZZ_STATS_CALL(DamerauLevenshteinFilter, 0);
+        return (osa_dist <= max) ? osa_dist : max + 1;
+    }
+
+    /* the cached scorers pass in the whole strings. The common affix does not effect the distance */
     remove_common_affix(s1, s2);
 
+    max = std::min(max, osa_dist);
     size_t maxVal = std::max(s1.size(), s2.size()) + 1;
     if (std::numeric_limits<int16_t>::max() > maxVal)
         return damerau_levenshtein_distance_zhao<int16_t>(s1, s2, max);
@@ -119,6 +190,50 @@ size_t damerau_levenshtein_distance(Range<InputIt1> s1, Range<InputIt2> s2, size
         return damerau_levenshtein_distance_zhao<int64_t>(s1, s2, max);
 }
 
+/**
+ * @brief Damerau Levenshtein distance using the bit-parallel OSA distance as filter
+ *
+ * @param PM pattern match vector of s1
+ */
+template <typename PM_Vec, typename InputIt1, typename InputIt2>
+size_t damerau_levenshtein_distance(const PM_Vec& PM, const Range<InputIt1>& s1, const Range<InputIt2>& s2,
+                                    size_t max)
+{
+    if (abs_diff(s1.size(), s2.size()) > max) {
+        RAPIDFUZZ_STATS_CALL(DamerauLevenshteinFilter, 0);
+        return max + 1;
+    }
+    if (s1.empty() || s2.empty()) {
+        RAPIDFUZZ_STATS_CALL(DamerauLevenshteinFilter, 0);
+        return s1.size() + s2.size();
+    }
+
+    size_t osa_dist = damerau_levenshtein_osa(PM, s1, s2, damerau_levenshtein_osa_cutoff(max));
+    return damerau_levenshtein_distance_from_osa(osa_dist, s1, s2, max);
+}
+
+template <typename InputIt1, typename InputIt2>
+size_t damerau_levenshtein_distance(Range<InputIt1> s1, Range<InputIt2> s2, size_t max)
+{
+    size_t min_edits = abs_diff(s1.size(), s2.size());
+    if (min_edits > max) {
+        RAPIDFUZZ_STATS_CALL(DamerauLevenshteinFilter, 0);
+        return max + 1;
+    }
+
+    /* common affix does not effect Levenshtein distance */
+    remove_common_affix(s1, s2);
+
+    if (s1.empty() || s2.empty()) {
+        RAPIDFUZZ_STATS_CALL(DamerauLevenshteinFilter, 0);
+        return s1.size() + s2.size();
+    }
+    if (s1.size() < 64) return damerau_levenshtein_distance(PatternMatchVector(s1), s1, s2, max);
+
+    ScratchFrame frame;
+    return damerau_levenshtein_distance(BlockPatternMatchVector::scratch(s1), s1, s2, max);
+}
+
 class DamerauLevenshtein
     : public DistanceBase<DamerauLevenshtein, size_t, 0, std::numeric_limits<int64_t>::max()> {
     friend DistanceBase<DamerauLevenshtein, size_t, 0, std::numeric_limits<int64_t>::max()>;
@@ -2,13 +2,55 @@
 /* Copyright © 2021 Max Bachmann */
 
 #pragma once
+#include <rapidfuzz/details/PatternMatchVector.hpp>
 #include <rapidfuzz/details/Range.hpp>
 #include <rapidfuzz/details/distance.hpp>
+#include <rapidfuzz/details/simd.hpp>
 #include <stdexcept>
 
 namespace rapidfuzz {
 namespace detail {
 
+#ifdef RAPIDFUZZ_SIMD
+#    if defined(RAPIDFUZZ_AVX512)
+#        define RAPIDFUZZ_SIMD_ISA_AVX512
+#    elif defined(RAPIDFUZZ_AVX2)
+#        define RAPIDFUZZ_SIMD_ISA_AVX2
+#    endif
+#    include <rapidfuzz/distance/Hamming_simd.impl>
+#    undef RAPIDFUZZ_SIMD_ISA_AVX512
+#    undef RAPIDFUZZ_SIMD_ISA_AVX2
+
+#    ifdef RAPIDFUZZ_AVX2_DISPATCH
+#        define RAPIDFUZZ_SIMD_ISA_AVX2
+RAPIDFUZZ_AVX2_TARGET_BEGIN
+#        include <rapidfuzz/distance/Hamming_simd.impl>
+RAPIDFUZZ_AVX2_TARGET_END
+#        undef RAPIDFUZZ_SIMD_ISA_AVX2
+#    endif
+
+template <typename VecType, typename InputIt, int _lto_hack = RAPIDFUZZ_LTO_HACK>
+void hamming_simd(Range<size_t*> scores, const detail::BlockPatternMatchVector& block,
+                  const std::vector<size_t>& s1_lengths, const Range<InputIt>& s2,
+                  size_t score_cutoff) noexcept
+{
+    RAPIDFUZZ_STATS_CALL(Hamming, s2.size());
+#    ifdef RAPIDFUZZ_AVX2_DISPATCH
+    if (cpu_supports_avx2())
+        return avx2::hamming_simd<VecType>(scores, block, s1_lengths, s2, score_cutoff);
+#    endif
+
+#    if defined(RAPIDFUZZ_AVX512)
+    avx512::hamming_simd<VecType>(scores, block, s1_lengths, s2, score_cutoff);
+#    elif defined(RAPIDFUZZ_AVX2)
+    avx2::hamming_simd<VecType>(scores, block, s1_lengths, s2, score_cutoff);
+#    else
+    sse2::hamming_simd<VecType>(scores, block, s1_lengths, s2, score_cutoff);
+#    endif
+}
+
+#endif
+
 class Hamming : public DistanceBase<Hamming, size_t, 0, std::numeric_limits<int64_t>::max(), bool> {
     friend DistanceBase<Hamming, size_t, 0, std::numeric_limits<int64_t>::max(), bool>;
     friend NormalizedMetricBase<Hamming, bool>;
@@ -26,11 +68,12 @@ class Hamming : public DistanceBase<Hamming, size_t, 0, std::numeric_limits<int6
         if (!pad && s1.size() != s2.size()) throw std::invalid_argument("Sequences are not the same length.");
 
         size_t min_len = std::min(s1.size(), s2.size());
+        RAPIDFUZZ_STATS_CALL(Hamming, min_len);
         size_t dist = std::max(s1.size(), s2.size());
         auto iter_s1 = s1.begin();
         auto iter_s2 = s2.begin();
         for (size_t i = 0; i < min_len; ++i)
-            dist -= bool(*(iter_s1++) == *(iter_s2++));
+            dist -= bool(char_equal(*(iter_s1++), *(iter_s2++)));
 
         return (dist <= score_cutoff) ? dist : score_cutoff + 1;
     }
@@ -45,7 +88,7 @@ Editops hamming_editops(const Range<InputIt1>& s1, const Range<InputIt2>& s2, bo
     size_t min_len = std::min(s1.size(), s2.size());
     size_t i = 0;
     for (; i < min_len; ++i)
-        if (s1[i] != s2[i]) ops.emplace_back(EditType::Replace, i, i);
+        if (!char_equal(s1[i], s2[i])) ops.emplace_back(EditType::Replace, i, i);
 
     for (; i < s1.size(); ++i)
         ops.emplace_back(EditType::Delete, i, s2.size());
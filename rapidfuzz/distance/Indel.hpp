@@ -114,7 +114,41 @@ public:
         str_lens.push_back(static_cast<size_t>(std::distance(first1, last1)));
     }
 
+    /**
+     * @brief writes the scorer into \p out, so it can be loaded using deserialize.
+     * The format is described in rapidfuzz/details/Serialization.hpp
+     */
+    void serialize(std::ostream& out) const
+    {
+        detail::SerializationWriter writer(out);
+        detail::write_serialization_header(writer, detail::SerializedScorer::Indel, MaxLen,
+                                           MultiLCSseq<MaxLen>::get_vec_size());
+        scorer.serialize_fields(writer);
+        writer.write(static_cast<uint64_t>(str_lens.size()));
+        writer.write_lengths(str_lens.data(), str_lens.size());
+    }
+
+    /**
+     * @brief loads a scorer written by serialize. See MultiLevenshtein::deserialize
+     */
+    static MultiIndel deserialize(const void* data, size_t size)
+    {
+        detail::SerializationReader reader(data, size);
+        detail::read_serialization_header(reader, detail::SerializedScorer::Indel, MaxLen,
+                                          MultiLCSseq<MaxLen>::get_vec_size());
+        return MultiIndel(reader);
+    }
+
 private:
+    explicit MultiIndel(detail::SerializationReader& reader) : scorer(reader)
+    {
+        uint64_t count = reader.read<uint64_t>();
+        if (count > scorer.result_count()) throw std::invalid_argument("serialized scorer is corrupted");
+
+        str_lens.resize(static_cast<size_t>(count));
+        reader.read_lengths(str_lens.data(), str_lens.size());
+    }
+
     template <typename InputIt2>
     void _distance(size_t* scores, size_t score_count, const detail::Range<InputIt2>& s2,
                    size_t score_cutoff = std::numeric_limits<size_t>::max()) const
@@ -157,6 +191,72 @@ struct CachedIndel
         : s1_len(static_cast<size_t>(std::distance(first1, last1))), scorer(first1, last1)
     {}
 
+    /**
+     * @brief state of the bit-parallel algorithm after consuming a prefix of s2
+     *
+     * New characters can be appended to the state, so a growing s2 does not have to be
+     * compared with s1 from scratch (see CachedLevenshtein::State).
+     */
+    struct State {
+        /** Indel distance between s1 and the characters appended so far */
+        size_t distance() const
+        {
+            return s1_len + lcs_state.length() - 2 * lcs_state.similarity();
+        }
+
+        size_t similarity() const
+        {
+            return 2 * lcs_state.similarity();
+        }
+
+        /** number of characters appended so far */
+        size_t length() const
+        {
+            return lcs_state.length();
+        }
+
+    private:
+        friend CachedIndel;
+
+        typename CachedLCSseq<CharT1>::State lcs_state;
+        size_t s1_len;
+    };
+
+    /**
+     * @brief creates the state for an empty s2
+     */
+    State make_state() const
+    {
+        State state;
+        state.lcs_state = scorer.make_state();
+        state.s1_len = s1_len;
+        return state;
+    }
+
+    /**
+     * @brief appends the characters [first2, last2) to the string described by state
+     */
+    template <typename InputIt2>
+    void append(State& state, InputIt2 first2, InputIt2 last2) const
+    {
+        scorer.append(state.lcs_state, first2, last2);
+    }
+
+    template <typename Sentence2>
+    void append(State& state, const Sentence2& s2) const
+    {
+        scorer.append(state.lcs_state, s2);
+    }
+
+    /**
+     * @brief stores the precomputed bitvectors of s1 in a compact layout
+     * (see CachedLevenshtein::shrink_to_fit)
+     */
+    void shrink_to_fit()
+    {
+        scorer.shrink_to_fit();
+    }
+
 private:
     friend detail::CachedDistanceBase<CachedIndel<CharT1>, size_t, 0, std::numeric_limits<int64_t>::max()>;
     friend detail::CachedNormalizedMetricBase<CachedIndel<CharT1>>;
@@ -11,8 +11,8 @@
 namespace rapidfuzz {
 namespace detail {
 
-template <typename InputIt1, typename InputIt2>
-size_t indel_distance(const BlockPatternMatchVector& block, const Range<InputIt1>& s1,
+template <typename PM_Vec, typename InputIt1, typename InputIt2>
+size_t indel_distance(const PM_Vec& block, const Range<InputIt1>& s1,
                       const Range<InputIt2>& s2, size_t score_cutoff)
 {
     size_t maximum = s1.size() + s2.size();
@@ -22,8 +22,8 @@ size_t indel_distance(const BlockPatternMatchVector& block, const Range<InputIt1
     return (dist <= score_cutoff) ? dist : score_cutoff + 1;
 }
 
-template <typename InputIt1, typename InputIt2>
-double indel_normalized_distance(const BlockPatternMatchVector& block, const Range<InputIt1>& s1,
+template <typename PM_Vec, typename InputIt1, typename InputIt2>
+double indel_normalized_distance(const PM_Vec& block, const Range<InputIt1>& s1,
                                  const Range<InputIt2>& s2, double score_cutoff)
 {
     size_t maximum = s1.size() + s2.size();
@@ -33,8 +33,8 @@ double indel_normalized_distance(const BlockPatternMatchVector& block, const Ran
     return (norm_dist <= score_cutoff) ? norm_dist : 1.0;
 }
 
-template <typename InputIt1, typename InputIt2>
-double indel_normalized_similarity(const BlockPatternMatchVector& block, const Range<InputIt1>& s1,
+template <typename PM_Vec, typename InputIt1, typename InputIt2>
+double indel_normalized_similarity(const PM_Vec& block, const Range<InputIt1>& s1,
                                    const Range<InputIt2>& s2, double score_cutoff)
 {
     double cutoff_score = NormSim_to_NormDist(score_cutoff);
@@ -80,7 +80,9 @@ private:
 
     constexpr static size_t get_vec_size()
     {
-#    ifdef RAPIDFUZZ_AVX2
+#    if defined(RAPIDFUZZ_AVX512)
+        return detail::simd_avx512::native_simd<VecType>::size;
+#    elif defined(RAPIDFUZZ_AVX2) || defined(RAPIDFUZZ_AVX2_DISPATCH)
         return detail::simd_avx2::native_simd<VecType>::size;
 #    else
         return detail::simd_sse2::native_simd<VecType>::size;
@@ -89,7 +91,9 @@ private:
 
     constexpr static size_t get_vec_alignment()
     {
-#    ifdef RAPIDFUZZ_AVX2
+#    if defined(RAPIDFUZZ_AVX512)
+        return detail::simd_avx512::native_simd<VecType>::alignment;
+#    elif defined(RAPIDFUZZ_AVX2) || defined(RAPIDFUZZ_AVX2_DISPATCH)
         return detail::simd_avx2::native_simd<VecType>::alignment;
 #    else
         return detail::simd_sse2::native_simd<VecType>::alignment;
@@ -114,6 +118,20 @@ public:
         std::fill(str_lens, str_lens + str_lens_size, VecType(0));
     }
 
+    MultiJaro(MultiJaro&& other) noexcept
+        : input_count(other.input_count),
+          pos(other.pos),
+          PM(std::move(other.PM)),
+          str_lens(other.str_lens),
+          str_lens_size(other.str_lens_size)
+    {
+        other.str_lens = nullptr;
+        other.str_lens_size = 0;
+    }
+
+    MultiJaro(const MultiJaro&) = delete;
+    MultiJaro& operator=(const MultiJaro&) = delete;
+
     ~MultiJaro()
     {
         detail::rf_aligned_free(str_lens);
@@ -159,7 +177,55 @@ public:
         pos++;
     }
 
+    /**
+     * @brief writes the scorer into \p out, so it can be loaded using deserialize.
+     * The format is described in rapidfuzz/details/Serialization.hpp
+     */
+    void serialize(std::ostream& out) const
+    {
+        detail::SerializationWriter writer(out);
+        detail::write_serialization_header(writer, detail::SerializedScorer::Jaro, MaxLen, get_vec_size());
+        serialize_fields(writer);
+    }
+
+    /**
+     * @brief loads a scorer written by serialize. See MultiLevenshtein::deserialize
+     */
+    static MultiJaro deserialize(const void* data, size_t size)
+    {
+        detail::SerializationReader reader(data, size);
+        detail::read_serialization_header(reader, detail::SerializedScorer::Jaro, MaxLen, get_vec_size());
+        return MultiJaro(reader);
+    }
+
 private:
+    template <int>
+    friend struct MultiJaroWinkler;
+
+    /* serialized scorers are read only, so they are marked as full */
+    explicit MultiJaro(detail::SerializationReader& reader)
+        : input_count(static_cast<size_t>(reader.read<uint64_t>())),
+          pos(input_count),
+          PM(detail::BlockPatternMatchVector::view(reader)),
+          str_lens(nullptr),
+          str_lens_size(0)
+    {
+        if (PM.size() != find_block_count(input_count))
+            throw std::invalid_argument("serialized scorer is corrupted");
+
+        str_lens_size = result_count();
+        str_lens = static_cast<VecType*>(
+            detail::rf_aligned_alloc(get_vec_alignment(), sizeof(VecType) * str_lens_size));
+        reader.read_lengths(str_lens, str_lens_size);
+    }
+
+    void serialize_fields(detail::SerializationWriter& writer) const
+    {
+        writer.write(static_cast<uint64_t>(input_count));
+        PM.serialize(writer);
+        writer.write_lengths(str_lens, str_lens_size);
+    }
+
     template <typename InputIt2>
     void _similarity(double* scores, size_t score_count, const detail::Range<InputIt2>& s2,
                      double score_cutoff = 0.0) const
@@ -202,10 +268,27 @@ struct CachedJaro : public detail::CachedSimilarityBase<CachedJaro<CharT1>, doub
     CachedJaro(InputIt1 first1, InputIt1 last1) : s1(first1, last1), PM(detail::make_range(first1, last1))
     {}
 
+    /**
+     * @brief stores the precomputed bitvectors of s1 in a compact layout
+     * (see CachedLevenshtein::shrink_to_fit)
+     */
+    void shrink_to_fit()
+    {
+        if (is_compact() || !PM.size()) return;
+
+        compact_PM = detail::CompactBlockPatternMatchVector(PM);
+        PM = detail::BlockPatternMatchVector(0);
+    }
+
 private:
     friend detail::CachedSimilarityBase<CachedJaro<CharT1>, double, 0, 1>;
     friend detail::CachedNormalizedMetricBase<CachedJaro<CharT1>>;
 
+    bool is_compact() const noexcept
+    {
+        return compact_PM.size() != 0;
+    }
+
     template <typename InputIt2>
     double maximum(const detail::Range<InputIt2>&) const
     {
@@ -215,11 +298,15 @@ private:
     template <typename InputIt2>
     double _similarity(const detail::Range<InputIt2>& s2, double score_cutoff, double) const
     {
+        if (is_compact())
+            return detail::jaro_similarity(compact_PM, detail::make_range(s1), s2, score_cutoff);
+
         return detail::jaro_similarity(PM, detail::make_range(s1), s2, score_cutoff);
     }
 
     std::vector<CharT1> s1;
     detail::BlockPatternMatchVector PM;
+    detail::CompactBlockPatternMatchVector compact_PM;
 };
 
 #ifdef RAPIDFUZZ_DEDUCTION_GUIDES
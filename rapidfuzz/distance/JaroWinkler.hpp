@@ -110,7 +110,7 @@ public:
     {
         scorer.insert(first1, last1);
         size_t len = static_cast<size_t>(std::distance(first1, last1));
-        std::array<uint64_t, 4> prefix;
+        std::array<uint64_t, 4> prefix = {};
         for (size_t i = 0; i < std::min(len, size_t(4)); ++i)
             prefix[i] = static_cast<uint64_t>(first1[static_cast<ptrdiff_t>(i)]);
 
@@ -118,7 +118,46 @@ public:
         prefixes.push_back(prefix);
     }
 
+    /**
+     * @brief writes the scorer into \p out, so it can be loaded using deserialize.
+     * The format is described in rapidfuzz/details/Serialization.hpp
+     */
+    void serialize(std::ostream& out) const
+    {
+        detail::SerializationWriter writer(out);
+        detail::write_serialization_header(writer, detail::SerializedScorer::JaroWinkler, MaxLen,
+                                           MultiJaro<MaxLen>::get_vec_size());
+        scorer.serialize_fields(writer);
+        writer.write(prefix_weight);
+        writer.write(static_cast<uint64_t>(str_lens.size()));
+        writer.write_lengths(str_lens.data(), str_lens.size());
+        writer.write(prefixes.data(), prefixes.size());
+    }
+
+    /**
+     * @brief loads a scorer written by serialize. See MultiLevenshtein::deserialize
+     */
+    static MultiJaroWinkler deserialize(const void* data, size_t size)
+    {
+        detail::SerializationReader reader(data, size);
+        detail::read_serialization_header(reader, detail::SerializedScorer::JaroWinkler, MaxLen,
+                                          MultiJaro<MaxLen>::get_vec_size());
+        return MultiJaroWinkler(reader);
+    }
+
 private:
+    explicit MultiJaroWinkler(detail::SerializationReader& reader)
+        : scorer(reader), prefix_weight(reader.read<double>())
+    {
+        uint64_t count = reader.read<uint64_t>();
+        if (count > scorer.result_count()) throw std::invalid_argument("serialized scorer is corrupted");
+
+        str_lens.resize(static_cast<size_t>(count));
+        reader.read_lengths(str_lens.data(), str_lens.size());
+        const std::array<uint64_t, 4>* prefix_data = reader.view<std::array<uint64_t, 4>>(str_lens.size());
+        prefixes.assign(prefix_data, prefix_data + str_lens.size());
+    }
+
     template <typename InputIt2>
     void _similarity(double* scores, size_t score_count, const detail::Range<InputIt2>& s2,
                      double score_cutoff = 0.0) const
@@ -177,10 +216,27 @@ struct CachedJaroWinkler : public detail::CachedSimilarityBase<CachedJaroWinkler
         : prefix_weight(_prefix_weight), s1(first1, last1), PM(detail::make_range(first1, last1))
     {}
 
+    /**
+     * @brief stores the precomputed bitvectors of s1 in a compact layout
+     * (see CachedLevenshtein::shrink_to_fit)
+     */
+    void shrink_to_fit()
+    {
+        if (is_compact() || !PM.size()) return;
+
+        compact_PM = detail::CompactBlockPatternMatchVector(PM);
+        PM = detail::BlockPatternMatchVector(0);
+    }
+
 private:
     friend detail::CachedSimilarityBase<CachedJaroWinkler<CharT1>, double, 0, 1>;
     friend detail::CachedNormalizedMetricBase<CachedJaroWinkler<CharT1>>;
 
+    bool is_compact() const noexcept
+    {
+        return compact_PM.size() != 0;
+    }
+
     template <typename InputIt2>
     double maximum(const detail::Range<InputIt2>&) const
     {
@@ -190,12 +246,17 @@ private:
     template <typename InputIt2>
     double _similarity(const detail::Range<InputIt2>& s2, double score_cutoff, double) const
     {
+        if (is_compact())
+            return detail::jaro_winkler_similarity(compact_PM, detail::make_range(s1), s2, prefix_weight,
+                                                   score_cutoff);
+
         return detail::jaro_winkler_similarity(PM, detail::make_range(s1), s2, prefix_weight, score_cutoff);
     }
 
     double prefix_weight;
     std::vector<CharT1> s1;
     detail::BlockPatternMatchVector PM;
+    detail::CompactBlockPatternMatchVector compact_PM;
 };
 
 #ifdef RAPIDFUZZ_DEDUCTION_GUIDES
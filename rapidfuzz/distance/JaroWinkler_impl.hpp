@@ -17,7 +17,7 @@ double jaro_winkler_similarity(const Range<InputIt1>& P, const Range<InputIt2>&
     size_t max_prefix = std::min(min_len, size_t(4));
 
     for (; prefix < max_prefix; ++prefix)
-        if (T[prefix] != P[prefix]) break;
+        if (!char_equal(T[prefix], P[prefix])) break;
 
     double jaro_score_cutoff = score_cutoff;
     if (jaro_score_cutoff > 0.7) {
@@ -38,8 +38,8 @@ double jaro_winkler_similarity(const Range<InputIt1>& P, const Range<InputIt2>&
     return (Sim >= score_cutoff) ? Sim : 0;
 }
 
-template <typename InputIt1, typename InputIt2>
-double jaro_winkler_similarity(const BlockPatternMatchVector& PM, const Range<InputIt1>& P,
+template <typename PM_Vec, typename InputIt1, typename InputIt2>
+double jaro_winkler_similarity(const PM_Vec& PM, const Range<InputIt1>& P,
                                const Range<InputIt2>& T, double prefix_weight, double score_cutoff)
 {
     size_t P_len = P.size();
@@ -49,7 +49,7 @@ double jaro_winkler_similarity(const BlockPatternMatchVector& PM, const Range<In
     size_t max_prefix = std::min(min_len, size_t(4));
 
     for (; prefix < max_prefix; ++prefix)
-        if (T[prefix] != P[prefix]) break;
+        if (!char_equal(T[prefix], P[prefix])) break;
 
     double jaro_score_cutoff = score_cutoff;
     if (jaro_score_cutoff > 0.7) {
@@ -7,6 +7,7 @@
 #include <rapidfuzz/details/common.hpp>
 #include <rapidfuzz/details/distance.hpp>
 #include <rapidfuzz/details/intrinsics.hpp>
+#include <rapidfuzz/details/simd.hpp>
 #include <vector>
 
 namespace rapidfuzz {
@@ -18,8 +19,8 @@ struct FlaggedCharsWord {
 };
 
 struct FlaggedCharsMultiword {
-    std::vector<uint64_t> P_flag;
-    std::vector<uint64_t> T_flag;
+    ScratchVector<uint64_t> P_flag;
+    ScratchVector<uint64_t> T_flag;
 };
 
 struct SearchBoundMask {
@@ -131,8 +132,8 @@ static inline FlaggedCharsWord flag_similar_characters_word(const PM_Vec& PM,
     return flagged;
 }
 
-template <typename CharT>
-static inline void flag_similar_characters_step(const BlockPatternMatchVector& PM, CharT T_j,
+template <typename PM_Vec, typename CharT>
+static inline void flag_similar_characters_step(const PM_Vec& PM, CharT T_j,
                                                 FlaggedCharsMultiword& flagged, size_t j,
                                                 SearchBoundMask BoundMask)
 {
@@ -210,8 +211,8 @@ static inline void flag_similar_characters_step(const BlockPatternMatchVector& P
     }
 }
 
-template <typename InputIt1, typename InputIt2>
-static inline FlaggedCharsMultiword flag_similar_characters_block(const BlockPatternMatchVector& PM,
+template <typename PM_Vec, typename InputIt1, typename InputIt2>
+static inline FlaggedCharsMultiword flag_similar_characters_block(const PM_Vec& PM,
                                                                   const Range<InputIt1>& P,
                                                                   const Range<InputIt2>& T, size_t Bound)
 {
@@ -275,8 +276,8 @@ static inline size_t count_transpositions_word(const PM_Vec& PM, const Range<Inp
     return Transpositions;
 }
 
-template <typename InputIt1>
-static inline size_t count_transpositions_block(const BlockPatternMatchVector& PM, const Range<InputIt1>& T,
+template <typename PM_Vec, typename InputIt1>
+static inline size_t count_transpositions_block(const PM_Vec& PM, const Range<InputIt1>& T,
                                                 const FlaggedCharsMultiword& flagged, size_t FlaggedChars)
 {
     size_t TextWord = 0;
@@ -364,14 +365,26 @@ static inline double jaro_similarity(Range<InputIt1> P, Range<InputIt2> T, doubl
     size_t P_len = P.size();
     size_t T_len = T.size();
 
-    if (score_cutoff > 1.0) return 0.0;
+    if (score_cutoff > 1.0) {
+        RAPIDFUZZ_STATS_CALL(JaroFilter, 0);
+        return 0.0;
+    }
 
-    if (!P_len && !T_len) return 1.0;
+    if (!P_len && !T_len) {
+        RAPIDFUZZ_STATS_CALL(JaroFilter, 0);
+        return 1.0;
+    }
 
     /* filter out based on the length difference between the two strings */
-    if (!jaro_length_filter(P_len, T_len, score_cutoff)) return 0.0;
+    if (!jaro_length_filter(P_len, T_len, score_cutoff)) {
+        RAPIDFUZZ_STATS_CALL(JaroFilter, 0);
+        return 0.0;
+    }
 
-    if (P_len == 1 && T_len == 1) return static_cast<double>(P.front() == T.front());
+    if (P_len == 1 && T_len == 1) {
+        RAPIDFUZZ_STATS_CALL(JaroFilter, 0);
+        return static_cast<double>(P.front() == T.front());
+    }
 
     size_t Bound = jaro_bounds(P, T);
 
@@ -381,23 +394,34 @@ static inline double jaro_similarity(Range<InputIt1> P, Range<InputIt2> T, doubl
 
     if (P.empty() || T.empty()) {
         /* already has correct number of common chars and transpositions */
+        RAPIDFUZZ_STATS_CALL(JaroFilter, 0);
     }
     else if (P.size() <= 64 && T.size() <= 64) {
         PatternMatchVector PM(P);
+        RAPIDFUZZ_STATS_CALL(JaroSingleWord, T.size());
         auto flagged = flag_similar_characters_word(PM, P, T, Bound);
         CommonChars += count_common_chars(flagged);
 
-        if (!jaro_common_char_filter(P_len, T_len, CommonChars, score_cutoff)) return 0.0;
+        if (!jaro_common_char_filter(P_len, T_len, CommonChars, score_cutoff)) {
+            RAPIDFUZZ_STATS_EARLY_EXIT(JaroSingleWord);
+            return 0.0;
+        }
 
         Transpositions = count_transpositions_word(PM, T, flagged);
     }
     else {
-        BlockPatternMatchVector PM(P);
+        ScratchFrame frame;
+        auto PM = BlockPatternMatchVector::scratch(P);
+        /* only the words inside the search window of a character are processed */
+        RAPIDFUZZ_STATS_CALL(JaroBlock, T.size() * ceil_div(std::min(P.size(), 2 * Bound + 1), 64));
         auto flagged = flag_similar_characters_block(PM, P, T, Bound);
         size_t FlaggedChars = count_common_chars(flagged);
         CommonChars += FlaggedChars;
 
-        if (!jaro_common_char_filter(P_len, T_len, CommonChars, score_cutoff)) return 0.0;
+        if (!jaro_common_char_filter(P_len, T_len, CommonChars, score_cutoff)) {
+            RAPIDFUZZ_STATS_EARLY_EXIT(JaroBlock);
+            return 0.0;
+        }
 
         Transpositions = count_transpositions_block(PM, T, flagged, FlaggedChars);
     }
@@ -406,21 +430,33 @@ static inline double jaro_similarity(Range<InputIt1> P, Range<InputIt2> T, doubl
     return (Sim >= score_cutoff) ? Sim : 0;
 }
 
-template <typename InputIt1, typename InputIt2>
-static inline double jaro_similarity(const BlockPatternMatchVector& PM, Range<InputIt1> P, Range<InputIt2> T,
+template <typename PM_Vec, typename InputIt1, typename InputIt2>
+static inline double jaro_similarity(const PM_Vec& PM, Range<InputIt1> P, Range<InputIt2> T,
                                      double score_cutoff)
 {
     size_t P_len = P.size();
     size_t T_len = T.size();
 
-    if (score_cutoff > 1.0) return 0.0;
+    if (score_cutoff > 1.0) {
+        RAPIDFUZZ_STATS_CALL(JaroFilter, 0);
+        return 0.0;
+    }
 
-    if (!P_len && !T_len) return 1.0;
+    if (!P_len && !T_len) {
+        RAPIDFUZZ_STATS_CALL(JaroFilter, 0);
+        return 1.0;
+    }
 
     /* filter out based on the length difference between the two strings */
-    if (!jaro_length_filter(P_len, T_len, score_cutoff)) return 0.0;
+    if (!jaro_length_filter(P_len, T_len, score_cutoff)) {
+        RAPIDFUZZ_STATS_CALL(JaroFilter, 0);
+        return 0.0;
+    }
 
-    if (P_len == 1 && T_len == 1) return static_cast<double>(P[0] == T[0]);
+    if (P_len == 1 && T_len == 1) {
+        RAPIDFUZZ_STATS_CALL(JaroFilter, 0);
+        return static_cast<double>(char_equal(P[0], T[0]));
+    }
 
     size_t Bound = jaro_bounds(P, T);
 
@@ -430,21 +466,32 @@ static inline double jaro_similarity(const BlockPatternMatchVector& PM, Range<In
 
     if (P.empty() || T.empty()) {
         /* already has correct number of common chars and transpositions */
+        RAPIDFUZZ_STATS_CALL(JaroFilter, 0);
     }
     else if (P.size() <= 64 && T.size() <= 64) {
+        RAPIDFUZZ_STATS_CALL(JaroSingleWord, T.size());
         auto flagged = flag_similar_characters_word(PM, P, T, Bound);
         CommonChars += count_common_chars(flagged);
 
-        if (!jaro_common_char_filter(P_len, T_len, CommonChars, score_cutoff)) return 0.0;
+        if (!jaro_common_char_filter(P_len, T_len, CommonChars, score_cutoff)) {
+            RAPIDFUZZ_STATS_EARLY_EXIT(JaroSingleWord);
+            return 0.0;
+        }
 
         Transpositions = count_transpositions_word(PM, T, flagged);
     }
     else {
+        ScratchFrame frame;
+        /* only the words inside the search window of a character are processed */
+        RAPIDFUZZ_STATS_CALL(JaroBlock, T.size() * ceil_div(std::min(P.size(), 2 * Bound + 1), 64));
         auto flagged = flag_similar_characters_block(PM, P, T, Bound);
         size_t FlaggedChars = count_common_chars(flagged);
         CommonChars += FlaggedChars;
 
-        if (!jaro_common_char_filter(P_len, T_len, CommonChars, score_cutoff)) return 0.0;
+        if (!jaro_common_char_filter(P_len, T_len, CommonChars, score_cutoff)) {
+            RAPIDFUZZ_STATS_EARLY_EXIT(JaroBlock);
+            return 0.0;
+        }
 
         Transpositions = count_transpositions_block(PM, T, flagged, FlaggedChars);
     }
@@ -462,381 +509,42 @@ struct JaroSimilaritySimdBounds {
     VecType boundMask;
 };
 
-template <typename VecType, typename InputIt, int _lto_hack = RAPIDFUZZ_LTO_HACK>
-static inline auto jaro_similarity_prepare_bound_short_s2(const VecType* s1_lengths, Range<InputIt>& s2)
-#    ifdef RAPIDFUZZ_AVX2
-    -> JaroSimilaritySimdBounds<simd_avx2::native_simd<VecType>>
-#    else
-    -> JaroSimilaritySimdBounds<simd_sse2::native_simd<VecType>>
-#    endif
-{
-#    ifdef RAPIDFUZZ_AVX2
-    using namespace simd_avx2;
-#    else
-    using namespace simd_sse2;
-#    endif
-
-#    ifndef RAPIDFUZZ_AVX2
-    static constexpr size_t alignment = native_simd<VecType>::alignment;
-#    endif
-    static constexpr size_t vec_width = native_simd<VecType>::size;
-    assert(s2.size() <= sizeof(VecType) * 8);
-
-    JaroSimilaritySimdBounds<native_simd<VecType>> bounds;
-
-    VecType maxLen = 0;
-    // todo permutate + max to find maxLen
-    // side-note: we know only the first 8 bit are actually used
-    for (size_t i = 0; i < vec_width; ++i)
-        if (s1_lengths[i] > maxLen) maxLen = s1_lengths[i];
-
-#    ifdef RAPIDFUZZ_AVX2
-    native_simd<VecType> zero(VecType(0));
-    native_simd<VecType> one(1);
-
-    native_simd<VecType> s1_lengths_simd(reinterpret_cast<const uint64_t*>(s1_lengths));
-    native_simd<VecType> s2_length_simd(static_cast<VecType>(s2.size()));
-
-    // we always know that the number does not exceed 64, so we can operate on smaller vectors if this
-    // proves to be faster
-    native_simd<VecType> boundSizes = max8(s1_lengths_simd, s2_length_simd) >> 1; // divide by two
-    // todo there could be faster options since comparisions can be relatively expensive for some vector sizes
-    boundSizes -= (boundSizes > zero) & one;
-
-    // this can never overflow even when using larger vectors for shifting here, since in the worst case of
-    // 8bit vectors this shifts by (8/2-1)*2=6 bits todo << 1 performs unneeded masking here sllv is pretty
-    // expensive for 8 / 16 bit since it has to be emulated maybe there is a better solution
-    bounds.boundMaskSize = sllv(one, boundSizes << 1) - one;
-    bounds.boundMask = sllv(one, boundSizes + one) - one;
-
-    bounds.maxBound = (s2.size() > maxLen) ? s2.size() : maxLen;
-    bounds.maxBound /= 2;
-    if (bounds.maxBound > 0) bounds.maxBound--;
-#    else
-    alignas(alignment) std::array<VecType, vec_width> boundMaskSize_;
-    alignas(alignment) std::array<VecType, vec_width> boundMask_;
-
-    // todo try to find a simd implementation for sse2
-    for (size_t i = 0; i < vec_width; ++i) {
-        size_t Bound = jaro_bounds(static_cast<size_t>(s1_lengths[i]), s2.size());
-
-        if (Bound > bounds.maxBound) bounds.maxBound = Bound;
-
-        boundMaskSize_[i] = bit_mask_lsb<VecType>(2 * Bound);
-        boundMask_[i] = bit_mask_lsb<VecType>(Bound + 1);
-    }
-
-    bounds.boundMaskSize = native_simd<VecType>(reinterpret_cast<uint64_t*>(boundMaskSize_.data()));
-    bounds.boundMask = native_simd<VecType>(reinterpret_cast<uint64_t*>(boundMask_.data()));
-#    endif
-
-    size_t lastRelevantChar = static_cast<size_t>(maxLen) + bounds.maxBound;
-    if (s2.size() > lastRelevantChar) s2.remove_suffix(s2.size() - lastRelevantChar);
-
-    return bounds;
-}
-
-template <typename VecType, typename InputIt, int _lto_hack = RAPIDFUZZ_LTO_HACK>
-static inline auto jaro_similarity_prepare_bound_long_s2(const VecType* s1_lengths, Range<InputIt>& s2)
-#    ifdef RAPIDFUZZ_AVX2
-    -> JaroSimilaritySimdBounds<simd_avx2::native_simd<VecType>>
-#    else
-    -> JaroSimilaritySimdBounds<simd_sse2::native_simd<VecType>>
-#    endif
-{
-#    ifdef RAPIDFUZZ_AVX2
-    using namespace simd_avx2;
-#    else
-    using namespace simd_sse2;
-#    endif
-
-    static constexpr size_t vec_width = native_simd<VecType>::size;
-    assert(s2.size() > sizeof(VecType) * 8);
-
-    JaroSimilaritySimdBounds<native_simd<VecType>> bounds;
-
-    VecType maxLen = 0;
-    // todo permutate + max to find maxLen
-    // side-note: we know only the first 8 bit are actually used
-    for (size_t i = 0; i < vec_width; ++i)
-        if (s1_lengths[i] > maxLen) maxLen = s1_lengths[i];
-
-    bounds.maxBound = s2.size() / 2 - 1;
-    bounds.boundMaskSize = native_simd<VecType>(bit_mask_lsb<VecType>(2 * bounds.maxBound));
-    bounds.boundMask = native_simd<VecType>(bit_mask_lsb<VecType>(bounds.maxBound + 1));
-
-    size_t lastRelevantChar = static_cast<size_t>(maxLen) + bounds.maxBound;
-    if (s2.size() > lastRelevantChar) s2.remove_suffix(s2.size() - lastRelevantChar);
-
-    return bounds;
-}
-
-template <typename VecType, typename InputIt, int _lto_hack = RAPIDFUZZ_LTO_HACK>
-static inline void
-jaro_similarity_simd_long_s2(Range<double*> scores, const detail::BlockPatternMatchVector& block,
-                             VecType* s1_lengths, Range<InputIt> s2, double score_cutoff) noexcept
-{
-#    ifdef RAPIDFUZZ_AVX2
-    using namespace simd_avx2;
-#    else
-    using namespace simd_sse2;
+#    if defined(RAPIDFUZZ_AVX512)
+#        define RAPIDFUZZ_SIMD_ISA_AVX512
+#    elif defined(RAPIDFUZZ_AVX2)
+#        define RAPIDFUZZ_SIMD_ISA_AVX2
 #    endif
-
-    static constexpr size_t alignment = native_simd<VecType>::alignment;
-    static constexpr size_t vec_width = native_simd<VecType>::size;
-    static constexpr size_t vecs = native_simd<uint64_t>::size;
-    assert(block.size() % vecs == 0);
-    assert(s2.size() > sizeof(VecType) * 8);
-
-    struct AlignedAlloc {
-        AlignedAlloc(size_t size) : memory(rf_aligned_alloc(native_simd<VecType>::alignment, size))
-        {}
-
-        ~AlignedAlloc()
-        {
-            rf_aligned_free(memory);
-        }
-
-        void* memory = nullptr;
-    };
-
-    native_simd<VecType> zero(VecType(0));
-    native_simd<VecType> one(1);
-    size_t result_index = 0;
-
-    size_t s2_block_count = detail::ceil_div(s2.size(), sizeof(VecType) * 8);
-    AlignedAlloc memory(2 * s2_block_count * sizeof(native_simd<VecType>));
-
-    native_simd<VecType>* T_flag = static_cast<native_simd<VecType>*>(memory.memory);
-    // reuse the same memory since counter is only required in the first half of the algorithm while
-    // T_flags is required in the second half
-    native_simd<VecType>* counter = static_cast<native_simd<VecType>*>(memory.memory) + s2_block_count;
-    VecType* T_flags = static_cast<VecType*>(memory.memory) + s2_block_count * vec_width;
-
-    for (size_t cur_vec = 0; cur_vec < block.size(); cur_vec += vecs) {
-        auto s2_cur = s2;
-        auto bounds = jaro_similarity_prepare_bound_long_s2(s1_lengths + result_index, s2_cur);
-
-        native_simd<VecType> P_flag(VecType(0));
-
-        std::fill(T_flag, T_flag + detail::ceil_div(s2_cur.size(), sizeof(VecType) * 8),
-                  native_simd<VecType>(VecType(0)));
-        std::fill(counter, counter + detail::ceil_div(s2_cur.size(), sizeof(VecType) * 8),
-                  native_simd<VecType>(VecType(1)));
-
-        // In case s2 is longer than all of the elements in s1_lengths boundMaskSize
-        // might have all bits set and therefor the condition ((boundMask <= boundMaskSize) & one)
-        // would incorrectly always set the first bit to 1.
-        // this is solved by splitting the loop into two parts where after this boundary is reached
-        // the first bit inside boundMask is no longer set
-        size_t j = 0;
-        for (; j < std::min(bounds.maxBound, s2_cur.size()); ++j) {
-            alignas(alignment) std::array<uint64_t, vecs> stored;
-            unroll<size_t, vecs>([&](size_t i) { stored[i] = block.get(cur_vec + i, s2_cur[j]); });
-            native_simd<VecType> X(stored.data());
-            native_simd<VecType> PM_j = andnot(X & bounds.boundMask, P_flag);
-
-            P_flag |= blsi(PM_j);
-            size_t T_word_index = j / (sizeof(VecType) * 8);
-            T_flag[T_word_index] |= andnot(counter[T_word_index], (PM_j == zero));
-
-            counter[T_word_index] = counter[T_word_index] << 1;
-            bounds.boundMask = (bounds.boundMask << 1) | ((bounds.boundMask <= bounds.boundMaskSize) & one);
-        }
-
-        for (; j < s2_cur.size(); ++j) {
-            alignas(alignment) std::array<uint64_t, vecs> stored;
-            unroll<size_t, vecs>([&](size_t i) { stored[i] = block.get(cur_vec + i, s2_cur[j]); });
-            native_simd<VecType> X(stored.data());
-            native_simd<VecType> PM_j = andnot(X & bounds.boundMask, P_flag);
-
-            P_flag |= blsi(PM_j);
-            size_t T_word_index = j / (sizeof(VecType) * 8);
-            T_flag[T_word_index] |= andnot(counter[T_word_index], (PM_j == zero));
-
-            counter[T_word_index] = counter[T_word_index] << 1;
-            bounds.boundMask = bounds.boundMask << 1;
-        }
-
-        auto counts = popcount(P_flag);
-        alignas(alignment) std::array<VecType, vec_width> P_flags;
-        P_flag.store(P_flags.data());
-
-        for (size_t i = 0; i < detail::ceil_div(s2_cur.size(), sizeof(VecType) * 8); ++i)
-            T_flag[i].store(T_flags + i * vec_width);
-
-        for (size_t i = 0; i < vec_width; ++i) {
-            size_t CommonChars = static_cast<size_t>(counts[i]);
-            if (!jaro_common_char_filter(static_cast<size_t>(s1_lengths[result_index]), s2.size(),
-                                         CommonChars, score_cutoff))
-            {
-                scores[result_index] = 0.0;
-                result_index++;
-                continue;
-            }
-
-            VecType P_flag_cur = P_flags[i];
-            size_t Transpositions = 0;
-
-            static constexpr size_t vecs_per_word = vec_width / vecs;
-            size_t cur_block = i / vecs_per_word;
-            size_t offset = sizeof(VecType) * 8 * (i % vecs_per_word);
-
-            {
-                size_t T_word_index = 0;
-                VecType T_flag_cur = T_flags[T_word_index * vec_width + i];
-                while (P_flag_cur) {
-                    while (!T_flag_cur) {
-                        ++T_word_index;
-                        T_flag_cur = T_flags[T_word_index * vec_width + i];
-                    }
-
-                    VecType PatternFlagMask = blsi(P_flag_cur);
-
-                    uint64_t PM_j =
-                        block.get(cur_vec + cur_block,
-                                  s2[countr_zero(T_flag_cur) + T_word_index * sizeof(VecType) * 8]);
-                    Transpositions += !(PM_j & (static_cast<uint64_t>(PatternFlagMask) << offset));
-
-                    T_flag_cur = blsr(T_flag_cur);
-                    P_flag_cur ^= PatternFlagMask;
-                }
-            }
-
-            double Sim = jaro_calculate_similarity(static_cast<size_t>(s1_lengths[result_index]), s2.size(),
-                                                   CommonChars, Transpositions);
-
-            scores[result_index] = (Sim >= score_cutoff) ? Sim : 0;
-            result_index++;
-        }
-    }
-}
-
-template <typename VecType, typename InputIt, int _lto_hack = RAPIDFUZZ_LTO_HACK>
-static inline void
-jaro_similarity_simd_short_s2(Range<double*> scores, const detail::BlockPatternMatchVector& block,
-                              VecType* s1_lengths, Range<InputIt> s2, double score_cutoff) noexcept
-{
-#    ifdef RAPIDFUZZ_AVX2
-    using namespace simd_avx2;
-#    else
-    using namespace simd_sse2;
+#    include <rapidfuzz/distance/Jaro_simd.impl>
+#    undef RAPIDFUZZ_SIMD_ISA_AVX512
+#    undef RAPIDFUZZ_SIMD_ISA_AVX2
+
+#    ifdef RAPIDFUZZ_AVX2_DISPATCH
+#        define RAPIDFUZZ_SIMD_ISA_AVX2
+RAPIDFUZZ_AVX2_TARGET_BEGIN
+#        include <rapidfuzz/distance/Jaro_simd.impl>
+RAPIDFUZZ_AVX2_TARGET_END
+#        undef RAPIDFUZZ_SIMD_ISA_AVX2
 #    endif
 
-    static constexpr size_t alignment = native_simd<VecType>::alignment;
-    static constexpr size_t vec_width = native_simd<VecType>::size;
-    static constexpr size_t vecs = native_simd<uint64_t>::size;
-    assert(block.size() % vecs == 0);
-    assert(s2.size() <= sizeof(VecType) * 8);
-
-    native_simd<VecType> zero(VecType(0));
-    native_simd<VecType> one(1);
-    size_t result_index = 0;
-
-    for (size_t cur_vec = 0; cur_vec < block.size(); cur_vec += vecs) {
-        auto s2_cur = s2;
-        auto bounds = jaro_similarity_prepare_bound_short_s2(s1_lengths + result_index, s2_cur);
-
-        native_simd<VecType> P_flag(VecType(0));
-        native_simd<VecType> T_flag(VecType(0));
-        native_simd<VecType> counter(VecType(1));
-
-        // In case s2 is longer than all of the elements in s1_lengths boundMaskSize
-        // might have all bits set and therefor the condition ((boundMask <= boundMaskSize) & one)
-        // would incorrectly always set the first bit to 1.
-        // this is solved by splitting the loop into two parts where after this boundary is reached
-        // the first bit inside boundMask is no longer set
-        size_t j = 0;
-        for (; j < std::min(bounds.maxBound, s2_cur.size()); ++j) {
-            alignas(alignment) std::array<uint64_t, vecs> stored;
-            unroll<size_t, vecs>([&](size_t i) { stored[i] = block.get(cur_vec + i, s2_cur[j]); });
-            native_simd<VecType> X(stored.data());
-            native_simd<VecType> PM_j = andnot(X & bounds.boundMask, P_flag);
-
-            P_flag |= blsi(PM_j);
-            T_flag |= andnot(counter, (PM_j == zero));
-
-            counter = counter << 1;
-            bounds.boundMask = (bounds.boundMask << 1) | ((bounds.boundMask <= bounds.boundMaskSize) & one);
-        }
-
-        for (; j < s2_cur.size(); ++j) {
-            alignas(alignment) std::array<uint64_t, vecs> stored;
-            unroll<size_t, vecs>([&](size_t i) { stored[i] = block.get(cur_vec + i, s2_cur[j]); });
-            native_simd<VecType> X(stored.data());
-            native_simd<VecType> PM_j = andnot(X & bounds.boundMask, P_flag);
-
-            P_flag |= blsi(PM_j);
-            T_flag |= andnot(counter, (PM_j == zero));
-
-            counter = counter << 1;
-            bounds.boundMask = bounds.boundMask << 1;
-        }
-
-        auto counts = popcount(P_flag);
-        alignas(alignment) std::array<VecType, vec_width> P_flags;
-        P_flag.store(P_flags.data());
-        alignas(alignment) std::array<VecType, vec_width> T_flags;
-        T_flag.store(T_flags.data());
-        for (size_t i = 0; i < vec_width; ++i) {
-            size_t CommonChars = static_cast<size_t>(counts[i]);
-            if (!jaro_common_char_filter(static_cast<size_t>(s1_lengths[result_index]), s2.size(),
-                                         CommonChars, score_cutoff))
-            {
-                scores[result_index] = 0.0;
-                result_index++;
-                continue;
-            }
-
-            VecType P_flag_cur = P_flags[i];
-            VecType T_flag_cur = T_flags[i];
-            size_t Transpositions = 0;
-
-            static constexpr size_t vecs_per_word = vec_width / vecs;
-            size_t cur_block = i / vecs_per_word;
-            size_t offset = sizeof(VecType) * 8 * (i % vecs_per_word);
-            while (P_flag_cur) {
-                VecType PatternFlagMask = blsi(P_flag_cur);
-
-                uint64_t PM_j = block.get(cur_vec + cur_block, s2[countr_zero(T_flag_cur)]);
-                Transpositions += !(PM_j & (static_cast<uint64_t>(PatternFlagMask) << offset));
-
-                T_flag_cur = blsr(T_flag_cur);
-                P_flag_cur ^= PatternFlagMask;
-            }
-
-            double Sim = jaro_calculate_similarity(static_cast<size_t>(s1_lengths[result_index]), s2.size(),
-                                                   CommonChars, Transpositions);
-
-            scores[result_index] = (Sim >= score_cutoff) ? Sim : 0;
-            result_index++;
-        }
-    }
-}
-
 template <typename VecType, typename InputIt, int _lto_hack = RAPIDFUZZ_LTO_HACK>
 static inline void jaro_similarity_simd(Range<double*> scores, const detail::BlockPatternMatchVector& block,
                                         VecType* s1_lengths, size_t s1_lengths_size, const Range<InputIt>& s2,
                                         double score_cutoff) noexcept
 {
-    if (score_cutoff > 1.0) {
-        for (size_t i = 0; i < s1_lengths_size; i++)
-            scores[i] = 0.0;
-
-        return;
-    }
-
-    if (s2.empty()) {
-        for (size_t i = 0; i < s1_lengths_size; i++)
-            scores[i] = s1_lengths[i] ? 0.0 : 1.0;
-
-        return;
-    }
+    RAPIDFUZZ_STATS_CALL(JaroSimd, block.size() * s2.size());
+#    ifdef RAPIDFUZZ_AVX2_DISPATCH
+    if (cpu_supports_avx2())
+        return avx2::jaro_similarity_simd<VecType>(scores, block, s1_lengths, s1_lengths_size, s2,
+                                                   score_cutoff);
+#    endif
 
-    if (s2.size() > sizeof(VecType) * 8)
-        return jaro_similarity_simd_long_s2(scores, block, s1_lengths, s2, score_cutoff);
-    else
-        return jaro_similarity_simd_short_s2(scores, block, s1_lengths, s2, score_cutoff);
+#    if defined(RAPIDFUZZ_AVX512)
+    avx512::jaro_similarity_simd<VecType>(scores, block, s1_lengths, s1_lengths_size, s2, score_cutoff);
+#    elif defined(RAPIDFUZZ_AVX2)
+    avx2::jaro_similarity_simd<VecType>(scores, block, s1_lengths, s1_lengths_size, s2, score_cutoff);
+#    else
+    sse2::jaro_similarity_simd<VecType>(scores, block, s1_lengths, s1_lengths_size, s2, score_cutoff);
+#    endif
 }
 
 #endif /* RAPIDFUZZ_SIMD */
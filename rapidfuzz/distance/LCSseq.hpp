@@ -76,16 +76,22 @@ Editops lcs_seq_editops(const Sentence1& s1, const Sentence2& s2)
 
 #ifdef RAPIDFUZZ_SIMD
 namespace experimental {
+template <int MaxLen>
+struct MultiIndel;
+
 template <int MaxLen>
 struct MultiLCSseq : public detail::MultiSimilarityBase<MultiLCSseq<MaxLen>, size_t, 0,
                                                         std::numeric_limits<int64_t>::max()> {
 private:
     friend detail::MultiSimilarityBase<MultiLCSseq<MaxLen>, size_t, 0, std::numeric_limits<int64_t>::max()>;
     friend detail::MultiNormalizedMetricBase<MultiLCSseq<MaxLen>, size_t>;
+    friend struct MultiIndel<MaxLen>;
 
     RAPIDFUZZ_CONSTEXPR_CXX14 static size_t get_vec_size()
     {
-#    ifdef RAPIDFUZZ_AVX2
+#    if defined(RAPIDFUZZ_AVX512)
+        using namespace detail::simd_avx512;
+#    elif defined(RAPIDFUZZ_AVX2) || defined(RAPIDFUZZ_AVX2_DISPATCH)
         using namespace detail::simd_avx2;
 #    else
         using namespace detail::simd_sse2;
@@ -96,10 +102,10 @@ private:
             return native_simd<uint16_t>::size;
         else RAPIDFUZZ_IF_CONSTEXPR (MaxLen <= 32)
             return native_simd<uint32_t>::size;
-        else RAPIDFUZZ_IF_CONSTEXPR (MaxLen <= 64)
+        else
             return native_simd<uint64_t>::size;
 
-        static_assert(MaxLen <= 64, "expected MaxLen <= 64");
+        static_assert(MaxLen <= 64 || MaxLen % 64 == 0, "expected MaxLen <= 64 or a multiple of 64");
     }
 
     static size_t find_block_count(size_t count)
@@ -141,22 +147,72 @@ public:
     void insert(InputIt1 first1, InputIt1 last1)
     {
         auto len = std::distance(first1, last1);
-        int block_pos = static_cast<int>((pos * MaxLen) % 64);
-        auto block = (pos * MaxLen) / 64;
         assert(len <= MaxLen);
 
         if (pos >= input_count) throw std::invalid_argument("out of bounds insert");
 
         str_lens[pos] = static_cast<size_t>(len);
 
-        for (; first1 != last1; ++first1) {
-            PM.insert(block, *first1, block_pos);
-            block_pos++;
+        RAPIDFUZZ_IF_CONSTEXPR (MaxLen > 64) {
+            /* the strings are split into words, which are stored vec_size blocks apart */
+            size_t vec_size = get_vec_size();
+            size_t first_block = (pos / vec_size) * vec_size * (MaxLen / 64) + pos % vec_size;
+            for (size_t i = 0; first1 != last1; ++first1, ++i)
+                PM.insert(first_block + (i / 64) * vec_size, *first1, static_cast<int>(i % 64));
+        }
+        else {
+            int block_pos = static_cast<int>((pos * MaxLen) % 64);
+            auto block = (pos * MaxLen) / 64;
+            for (; first1 != last1; ++first1) {
+                PM.insert(block, *first1, block_pos);
+                block_pos++;
+            }
         }
         pos++;
     }
 
+    /**
+     * @brief writes the scorer into \p out, so it can be loaded using deserialize.
+     * The format is described in rapidfuzz/details/Serialization.hpp
+     */
+    void serialize(std::ostream& out) const
+    {
+        detail::SerializationWriter writer(out);
+        detail::write_serialization_header(writer, detail::SerializedScorer::LCSseq, MaxLen, get_vec_size());
+        serialize_fields(writer);
+    }
+
+    /**
+     * @brief loads a scorer written by serialize. See MultiLevenshtein::deserialize
+     */
+    static MultiLCSseq deserialize(const void* data, size_t size)
+    {
+        detail::SerializationReader reader(data, size);
+        detail::read_serialization_header(reader, detail::SerializedScorer::LCSseq, MaxLen, get_vec_size());
+        return MultiLCSseq(reader);
+    }
+
 private:
+    /* serialized scorers are read only, so they are marked as full */
+    explicit MultiLCSseq(detail::SerializationReader& reader)
+        : input_count(static_cast<size_t>(reader.read<uint64_t>())),
+          pos(input_count),
+          PM(detail::BlockPatternMatchVector::view(reader))
+    {
+        if (PM.size() != find_block_count(input_count))
+            throw std::invalid_argument("serialized scorer is corrupted");
+
+        str_lens.resize(result_count());
+        reader.read_lengths(str_lens.data(), str_lens.size());
+    }
+
+    void serialize_fields(detail::SerializationWriter& writer) const
+    {
+        writer.write(static_cast<uint64_t>(input_count));
+        PM.serialize(writer);
+        writer.write_lengths(str_lens.data(), str_lens.size());
+    }
+
     template <typename InputIt2>
     void _similarity(size_t* scores, size_t score_count, const detail::Range<InputIt2>& s2,
                      size_t score_cutoff = 0) const
@@ -173,6 +229,8 @@ private:
             detail::lcs_simd<uint32_t>(scores_, PM, s2, score_cutoff);
         else RAPIDFUZZ_IF_CONSTEXPR (MaxLen == 64)
             detail::lcs_simd<uint64_t>(scores_, PM, s2, score_cutoff);
+        else
+            detail::lcs_simd_multiword<MaxLen / 64>(scores_, PM, str_lens, s2, score_cutoff, get_vec_size());
     }
 
     template <typename InputIt2>
@@ -205,10 +263,94 @@ struct CachedLCSseq
     CachedLCSseq(InputIt1 first1, InputIt1 last1) : s1(first1, last1), PM(detail::make_range(first1, last1))
     {}
 
+    /**
+     * @brief state of the bit-parallel algorithm after consuming a prefix of s2
+     *
+     * New characters can be appended to the state, so a growing s2 does not have to be
+     * compared with s1 from scratch (see CachedLevenshtein::State).
+     */
+    struct State {
+        /** length of the longest common subsequence of s1 and the characters appended so far */
+        size_t similarity() const
+        {
+            size_t sim = 0;
+            for (uint64_t Stemp : S)
+                sim += detail::popcount(~Stemp);
+            return sim;
+        }
+
+        size_t distance() const
+        {
+            return std::max(len1, len2) - similarity();
+        }
+
+        /** number of characters appended so far */
+        size_t length() const
+        {
+            return len2;
+        }
+
+    private:
+        friend CachedLCSseq;
+
+        std::vector<uint64_t> S;
+        size_t len1;
+        size_t len2;
+    };
+
+    /**
+     * @brief creates the state for an empty s2
+     */
+    State make_state() const
+    {
+        State state;
+        state.S.resize(is_compact() ? compact_PM.size() : PM.size(), ~UINT64_C(0));
+        state.len1 = s1.size();
+        state.len2 = 0;
+        return state;
+    }
+
+    /**
+     * @brief appends the characters [first2, last2) to the string described by state
+     */
+    template <typename InputIt2>
+    void append(State& state, InputIt2 first2, InputIt2 last2) const
+    {
+        auto s2 = detail::make_range(first2, last2);
+        if (is_compact())
+            detail::lcs_blockwise_resume(compact_PM, state.S, s2);
+        else
+            detail::lcs_blockwise_resume(PM, state.S, s2);
+        state.len2 += s2.size();
+    }
+
+    template <typename Sentence2>
+    void append(State& state, const Sentence2& s2) const
+    {
+        append(state, detail::to_begin(s2), detail::to_end(s2));
+    }
+
+    /**
+     * @brief stores the precomputed bitvectors of s1 in a compact layout
+     * (see CachedLevenshtein::shrink_to_fit)
+     */
+    void shrink_to_fit()
+    {
+        if (is_compact() || !PM.size()) return;
+
+        compact_PM = detail::CompactBlockPatternMatchVector(PM);
+        PM = detail::BlockPatternMatchVector(0);
+    }
+
 private:
     friend detail::CachedSimilarityBase<CachedLCSseq<CharT1>, size_t, 0, std::numeric_limits<int64_t>::max()>;
     friend detail::CachedNormalizedMetricBase<CachedLCSseq<CharT1>>;
 
+    bool is_compact() const noexcept
+    {
+        return compact_PM.size() != 0;
+    }
+
     template <typename InputIt2>
     size_t maximum(const detail::Range<InputIt2>& s2) const
     {
@@ -218,11 +360,15 @@ private:
     template <typename InputIt2>
     size_t _similarity(const detail::Range<InputIt2>& s2, size_t score_cutoff, size_t) const
     {
+        if (is_compact())
+            return detail::lcs_seq_similarity(compact_PM, detail::make_range(s1), s2, score_cutoff);
+
         return detail::lcs_seq_similarity(PM, detail::make_range(s1), s2, score_cutoff);
     }
 
     std::vector<CharT1> s1;
     detail::BlockPatternMatchVector PM;
+    detail::CompactBlockPatternMatchVector compact_PM;
 };
 
 #ifdef RAPIDFUZZ_DEDUCTION_GUIDES
@@ -96,6 +96,8 @@ size_t lcs_seq_mbleven2018(const Range<InputIt1>& s1, const Range<InputIt2>& s2,
 
     if (len1 < len2) return lcs_seq_mbleven2018(s2, s1, score_cutoff);
 
+    RAPIDFUZZ_STATS_CALL(LCSseqMbleven, 0);
+
     auto len_diff = len1 - len2;
     size_t max_misses = len1 + len2 - 2 * score_cutoff;
     size_t ops_index = (max_misses + max_misses * max_misses) / 2 + len_diff - 1;
@@ -110,7 +112,7 @@ size_t lcs_seq_mbleven2018(const Range<InputIt1>& s1, const Range<InputIt2>& s2,
         if (!ops) break;
 
         while (iter_s1 != s1.end() && iter_s2 != s2.end()) {
-            if (*iter_s1 != *iter_s2) {
+            if (!char_equal(*iter_s1, *iter_s2)) {
                 if (!ops) break;
                 if (ops & 1)
                     iter_s1++;
@@ -139,65 +141,60 @@ size_t lcs_seq_mbleven2018(const Range<InputIt1>& s1, const Range<InputIt2>& s2,
 }
 
 #ifdef RAPIDFUZZ_SIMD
+#    if defined(RAPIDFUZZ_AVX512)
+#        define RAPIDFUZZ_SIMD_ISA_AVX512
+#    elif defined(RAPIDFUZZ_AVX2)
+#        define RAPIDFUZZ_SIMD_ISA_AVX2
+#    endif
+#    include <rapidfuzz/distance/LCSseq_simd.impl>
+#    undef RAPIDFUZZ_SIMD_ISA_AVX512
+#    undef RAPIDFUZZ_SIMD_ISA_AVX2
+
+#    ifdef RAPIDFUZZ_AVX2_DISPATCH
+#        define RAPIDFUZZ_SIMD_ISA_AVX2
+RAPIDFUZZ_AVX2_TARGET_BEGIN
+#        include <rapidfuzz/distance/LCSseq_simd.impl>
+RAPIDFUZZ_AVX2_TARGET_END
+#        undef RAPIDFUZZ_SIMD_ISA_AVX2
+#    endif
+
 template <typename VecType, typename InputIt, int _lto_hack = RAPIDFUZZ_LTO_HACK>
 void lcs_simd(Range<size_t*> scores, const BlockPatternMatchVector& block, const Range<InputIt>& s2,
               size_t score_cutoff) noexcept
 {
-#    ifdef RAPIDFUZZ_AVX2
-    using namespace simd_avx2;
-#    else
-    using namespace simd_sse2;
+    RAPIDFUZZ_STATS_CALL(LCSseqSimd, block.size() * s2.size());
+#    ifdef RAPIDFUZZ_AVX2_DISPATCH
+    if (cpu_supports_avx2())
+        return avx2::lcs_simd<VecType>(scores, block, s2, score_cutoff);
 #    endif
-    auto score_iter = scores.begin();
-    static constexpr size_t alignment = native_simd<VecType>::alignment;
-    static constexpr size_t vecs = native_simd<uint64_t>::size;
-    assert(block.size() % vecs == 0);
-
-    static constexpr size_t interleaveCount = 3;
-
-    size_t cur_vec = 0;
-    for (; cur_vec + interleaveCount * vecs <= block.size(); cur_vec += interleaveCount * vecs) {
-        std::array<native_simd<VecType>, interleaveCount> S;
-        unroll<size_t, interleaveCount>([&](size_t j) { S[j] = static_cast<VecType>(-1); });
-
-        for (const auto& ch : s2) {
-            unroll<size_t, interleaveCount>([&](size_t j) {
-                alignas(32) std::array<uint64_t, vecs> stored;
-                unroll<size_t, vecs>([&](size_t i) { stored[i] = block.get(cur_vec + j * vecs + i, ch); });
-
-                native_simd<VecType> Matches(stored.data());
-                native_simd<VecType> u = S[j] & Matches;
-                S[j] = (S[j] + u) | (S[j] - u);
-            });
-        }
-
-        unroll<size_t, interleaveCount>([&](size_t j) {
-            auto counts = popcount(~S[j]);
-            unroll<size_t, counts.size()>([&](size_t i) {
-                *score_iter = (counts[i] >= score_cutoff) ? static_cast<size_t>(counts[i]) : 0;
-                score_iter++;
-            });
-        });
-    }
-
-    for (; cur_vec < block.size(); cur_vec += vecs) {
-        native_simd<VecType> S = static_cast<VecType>(-1);
 
-        for (const auto& ch : s2) {
-            alignas(alignment) std::array<uint64_t, vecs> stored;
-            unroll<size_t, vecs>([&](size_t i) { stored[i] = block.get(cur_vec + i, ch); });
+#    if defined(RAPIDFUZZ_AVX512)
+    avx512::lcs_simd<VecType>(scores, block, s2, score_cutoff);
+#    elif defined(RAPIDFUZZ_AVX2)
+    avx2::lcs_simd<VecType>(scores, block, s2, score_cutoff);
+#    else
+    sse2::lcs_simd<VecType>(scores, block, s2, score_cutoff);
+#    endif
+}
 
-            native_simd<VecType> Matches(stored.data());
-            native_simd<VecType> u = S & Matches;
-            S = (S + u) | (S - u);
-        }
+template <size_t Words, typename InputIt, int _lto_hack = RAPIDFUZZ_LTO_HACK>
+void lcs_simd_multiword(Range<size_t*> scores, const BlockPatternMatchVector& block,
+                        const std::vector<size_t>& s1_lengths, const Range<InputIt>& s2, size_t score_cutoff,
+                        size_t group_size) noexcept
+{
+    RAPIDFUZZ_STATS_CALL(LCSseqSimd, block.size() * s2.size());
+#    ifdef RAPIDFUZZ_AVX2_DISPATCH
+    if (cpu_supports_avx2())
+        return avx2::lcs_simd_multiword<Words>(scores, block, s1_lengths, s2, score_cutoff, group_size);
+#    endif
 
-        auto counts = popcount(~S);
-        unroll<size_t, counts.size()>([&](size_t i) {
-            *score_iter = (counts[i] >= score_cutoff) ? static_cast<size_t>(counts[i]) : 0;
-            score_iter++;
-        });
-    }
+#    if defined(RAPIDFUZZ_AVX512)
+    avx512::lcs_simd_multiword<Words>(scores, block, s1_lengths, s2, score_cutoff, group_size);
+#    elif defined(RAPIDFUZZ_AVX2)
+    avx2::lcs_simd_multiword<Words>(scores, block, s1_lengths, s2, score_cutoff, group_size);
+#    else
+    sse2::lcs_simd_multiword<Words>(scores, block, s1_lengths, s2, score_cutoff, group_size);
+#    endif
 }
 
 #endif
@@ -206,6 +203,7 @@ template <size_t N, bool RecordMatrix, typename PMV, typename InputIt1, typename
 auto lcs_unroll(const PMV& block, const Range<InputIt1>&, const Range<InputIt2>& s2,
                 size_t score_cutoff = 0) -> LCSseqResult<RecordMatrix>
 {
+    RAPIDFUZZ_STATS_CALL(LCSseqUnroll, N * s2.size());
     uint64_t S[N];
     unroll<size_t, N>([&](size_t i) { S[i] = ~UINT64_C(0); });
 
@@ -271,10 +269,12 @@ auto lcs_blockwise(const PMV& PM, const Range<InputIt1>& s1, const Range<InputIt
 {
     assert(score_cutoff <= s1.size());
     assert(score_cutoff <= s2.size());
+    RAPIDFUZZ_STATS_CALL(LCSseqBlockwise, 0);
 
+    ScratchFrame frame;
     size_t word_size = sizeof(uint64_t) * 8;
     size_t words = PM.size();
-    std::vector<uint64_t> S(words, ~UINT64_C(0));
+    ScratchVector<uint64_t> S(words, ~UINT64_C(0));
 
     size_t band_width_left = s1.size() - score_cutoff;
     size_t band_width_right = s2.size() - score_cutoff;
@@ -314,6 +314,7 @@ auto lcs_blockwise(const PMV& PM, const Range<InputIt1>& s1, const Range<InputIt
                 res_.S[row][word - first_block] = S[word];
             }
         }
+        RAPIDFUZZ_STATS_WORDS(LCSseqBlockwise, last_block - first_block);
 
         if (row > band_width_right) first_block = (row - band_width_right) / word_size;
 
@@ -332,6 +333,30 @@ auto lcs_blockwise(const PMV& PM, const Range<InputIt1>& s1, const Range<InputIt
     return res;
 }
 
+/**
+ * @brief advances the bit vectors S of the blockwise LCS algorithm by the characters of s2
+ *
+ * This allows resuming the calculation after more characters are appended to s2.
+ * The similarity is the number of unset bits in S.
+ */
+template <typename PMV, typename InputIt2>
+void lcs_blockwise_resume(const PMV& PM, std::vector<uint64_t>& S, const Range<InputIt2>& s2)
+{
+    size_t words = S.size();
+    for (const auto& ch : s2) {
+        uint64_t carry = 0;
+        for (size_t word = 0; word < words; ++word) {
+            const uint64_t Matches = PM.get(word, ch);
+            uint64_t Stemp = S[word];
+
+            uint64_t u = Stemp & Matches;
+
+            uint64_t x = addc64(Stemp, u, carry, &carry);
+            S[word] = x | (Stemp - u);
+        }
+    }
+}
+
 template <typename PMV, typename InputIt1, typename InputIt2>
 size_t longest_common_subsequence(const PMV& PM, const Range<InputIt1>& s1, const Range<InputIt2>& s2,
                                   size_t score_cutoff)
@@ -369,24 +394,34 @@ size_t longest_common_subsequence(const Range<InputIt1>& s1, const Range<InputIt
     if (s1.empty()) return 0;
     if (s1.size() <= 64) return longest_common_subsequence(PatternMatchVector(s1), s1, s2, score_cutoff);
 
-    return longest_common_subsequence(BlockPatternMatchVector(s1), s1, s2, score_cutoff);
+    ScratchFrame frame;
+    return longest_common_subsequence(BlockPatternMatchVector::scratch(s1), s1, s2, score_cutoff);
 }
 
-template <typename InputIt1, typename InputIt2>
-size_t lcs_seq_similarity(const BlockPatternMatchVector& block, Range<InputIt1> s1, Range<InputIt2> s2,
+template <typename PMV, typename InputIt1, typename InputIt2>
+size_t lcs_seq_similarity(const PMV& block, Range<InputIt1> s1, Range<InputIt2> s2,
                           size_t score_cutoff)
 {
     auto len1 = s1.size();
     auto len2 = s2.size();
 
-    if (score_cutoff > len1 || score_cutoff > len2) return 0;
+    if (score_cutoff > len1 || score_cutoff > len2) {
+        RAPIDFUZZ_STATS_CALL(LCSseqFilter, 0);
+        return 0;
+    }
 
     size_t max_misses = len1 + len2 - 2 * score_cutoff;
 
     /* no edits are allowed */
-    if (max_misses == 0 || (max_misses == 1 && len1 == len2)) return s1 == s2 ? len1 : 0;
+    if (max_misses == 0 || (max_misses == 1 && len1 == len2)) {
+        RAPIDFUZZ_STATS_CALL(LCSseqFilter, 0);
+        return range_equal(s1, s2) ? len1 : 0;
+    }
 
-    if (max_misses < abs_diff(len1, len2)) return 0;
+    if (max_misses < abs_diff(len1, len2)) {
+        RAPIDFUZZ_STATS_CALL(LCSseqFilter, 0);
+        return 0;
+    }
 
     // do this first, since we can not remove any affix in encoded form
     if (max_misses >= 5) return longest_common_subsequence(block, s1, s2, score_cutoff);
@@ -398,6 +433,8 @@ size_t lcs_seq_similarity(const BlockPatternMatchVector& block, Range<InputIt1>
         size_t adjusted_cutoff = score_cutoff >= lcs_sim ? score_cutoff - lcs_sim : 0;
         lcs_sim += lcs_seq_mbleven2018(s1, s2, adjusted_cutoff);
     }
+    else
+        RAPIDFUZZ_STATS_CALL(LCSseqFilter, 0);
 
     return (lcs_sim >= score_cutoff) ? lcs_sim : 0;
 }
@@ -411,14 +448,23 @@ size_t lcs_seq_similarity(Range<InputIt1> s1, Range<InputIt2> s2, size_t score_c
     // Swapping the strings so the second string is shorter
     if (len1 < len2) return lcs_seq_similarity(s2, s1, score_cutoff);
 
-    if (score_cutoff > len1 || score_cutoff > len2) return 0;
+    if (score_cutoff > len1 || score_cutoff > len2) {
+        RAPIDFUZZ_STATS_CALL(LCSseqFilter, 0);
+        return 0;
+    }
 
     size_t max_misses = len1 + len2 - 2 * score_cutoff;
 
     /* no edits are allowed */
-    if (max_misses == 0 || (max_misses == 1 && len1 == len2)) return s1 == s2 ? len1 : 0;
+    if (max_misses == 0 || (max_misses == 1 && len1 == len2)) {
+        RAPIDFUZZ_STATS_CALL(LCSseqFilter, 0);
+        return range_equal(s1, s2) ? len1 : 0;
+    }
 
-    if (max_misses < abs_diff(len1, len2)) return 0;
+    if (max_misses < abs_diff(len1, len2)) {
+        RAPIDFUZZ_STATS_CALL(LCSseqFilter, 0);
+        return 0;
+    }
 
     /* common affix does not effect Levenshtein distance */
     StringAffix affix = remove_common_affix(s1, s2);
@@ -430,6 +476,8 @@ size_t lcs_seq_similarity(Range<InputIt1> s1, Range<InputIt2> s2, size_t score_c
         else
             lcs_sim += longest_common_subsequence(s1, s2, adjusted_cutoff);
     }
+    else
+        RAPIDFUZZ_STATS_CALL(LCSseqFilter, 0);
 
     return (lcs_sim >= score_cutoff) ? lcs_sim : 0;
 }
@@ -483,7 +531,7 @@ Editops recover_alignment(const Range<InputIt1>& s1, const Range<InputIt2>& s2,
             /* Match */
             else {
                 col--;
-                assert(s1[col] == s2[row]);
+                assert(char_equal(s1[col], s2[row]));
             }
         }
     }
@@ -510,6 +558,7 @@ Editops recover_alignment(const Range<InputIt1>& s1, const Range<InputIt2>& s2,
 template <typename InputIt1, typename InputIt2>
 LCSseqResult<true> lcs_matrix(const Range<InputIt1>& s1, const Range<InputIt2>& s2)
 {
+    ScratchFrame frame;
     size_t nr = ceil_div(s1.size(), 64);
     switch (nr) {
     case 0:
@@ -519,14 +568,14 @@ LCSseqResult<true> lcs_matrix(const Range<InputIt1>& s1, const Range<InputIt2>&
         return res;
     }
     case 1: return lcs_unroll<1, true>(PatternMatchVector(s1), s1, s2);
-    case 2: return lcs_unroll<2, true>(BlockPatternMatchVector(s1), s1, s2);
-    case 3: return lcs_unroll<3, true>(BlockPatternMatchVector(s1), s1, s2);
-    case 4: return lcs_unroll<4, true>(BlockPatternMatchVector(s1), s1, s2);
-    case 5: return lcs_unroll<5, true>(BlockPatternMatchVector(s1), s1, s2);
-    case 6: return lcs_unroll<6, true>(BlockPatternMatchVector(s1), s1, s2);
-    case 7: return lcs_unroll<7, true>(BlockPatternMatchVector(s1), s1, s2);
-    case 8: return lcs_unroll<8, true>(BlockPatternMatchVector(s1), s1, s2);
-    default: return lcs_blockwise<true>(BlockPatternMatchVector(s1), s1, s2);
+    case 2: return lcs_unroll<2, true>(BlockPatternMatchVector::scratch(s1), s1, s2);
+    case 3: return lcs_unroll<3, true>(BlockPatternMatchVector::scratch(s1), s1, s2);
+    case 4: return lcs_unroll<4, true>(BlockPatternMatchVector::scratch(s1), s1, s2);
+    case 5: return lcs_unroll<5, true>(BlockPatternMatchVector::scratch(s1), s1, s2);
+    case 6: return lcs_unroll<6, true>(BlockPatternMatchVector::scratch(s1), s1, s2);
+    case 7: return lcs_unroll<7, true>(BlockPatternMatchVector::scratch(s1), s1, s2);
+    case 8: return lcs_unroll<8, true>(BlockPatternMatchVector::scratch(s1), s1, s2);
+    default: return lcs_blockwise<true>(BlockPatternMatchVector::scratch(s1), s1, s2);
     }
 }
 
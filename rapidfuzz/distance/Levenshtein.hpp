@@ -3,6 +3,7 @@
 
 #pragma once
 #include <limits>
+#include <stdexcept>
 #include <rapidfuzz/details/Range.hpp>
 #include <rapidfuzz/distance/Levenshtein_impl.hpp>
 
@@ -294,6 +295,45 @@ Editops levenshtein_editops(const Sentence1& s1, const Sentence2& s2,
     return detail::levenshtein_editops(detail::make_range(s1), detail::make_range(s2), score_hint);
 }
 
+/**
+ * @brief Find all occurrences of s1 in s2 with a Levenshtein distance <= max
+ *
+ * The text s2 is processed in a single pass using the search mode of the bit-parallel
+ * Levenshtein algorithm, which allows the occurrence to start at any position of s2.
+ * Every end position with a distance <= max is reported, so an occurrence usually shows
+ * up at multiple neighbouring end positions.
+ *
+ * @param s1
+ *   pattern to search for
+ * @param s2
+ *   text to search in
+ * @param max
+ *   maximum Levenshtein distance of an occurrence
+ * @param find_start
+ *   calculate the start of every occurrence. This compares the reversed pattern with the text
+ *   in front of the end position, so it is more expensive than the search itself when there
+ *   are a lot of matches. When disabled dest_start is set to dest_end.
+ *
+ * @return occurrences in the order of their end position. score is the distance, src_start/src_end
+ *   always cover all of s1 and dest_start/dest_end describe the shortest substring of s2 with this distance
+ */
+template <typename InputIt1, typename InputIt2>
+std::vector<ScoreAlignment<size_t>> levenshtein_find_all(InputIt1 first1, InputIt1 last1, InputIt2 first2,
+                                                         InputIt2 last2, size_t max, bool find_start = true)
+{
+    auto s1 = detail::make_range(first1, last1);
+    return detail::levenshtein_find_all(detail::BlockPatternMatchVector(s1), s1,
+                                        detail::make_range(first2, last2), max, find_start);
+}
+
+template <typename Sentence1, typename Sentence2>
+std::vector<ScoreAlignment<size_t>> levenshtein_find_all(const Sentence1& s1, const Sentence2& s2, size_t max,
+                                                         bool find_start = true)
+{
+    return levenshtein_find_all(detail::to_begin(s1), detail::to_end(s1), detail::to_begin(s2),
+                                detail::to_end(s2), max, find_start);
+}
+
 #ifdef RAPIDFUZZ_SIMD
 namespace experimental {
 template <int MaxLen>
@@ -306,7 +346,9 @@ private:
 
     RAPIDFUZZ_CONSTEXPR_CXX14 static size_t get_vec_size()
     {
-#    ifdef RAPIDFUZZ_AVX2
+#    if defined(RAPIDFUZZ_AVX512)
+        using namespace detail::simd_avx512;
+#    elif defined(RAPIDFUZZ_AVX2) || defined(RAPIDFUZZ_AVX2_DISPATCH)
         using namespace detail::simd_avx2;
 #    else
         using namespace detail::simd_sse2;
@@ -317,10 +359,10 @@ private:
             return native_simd<uint16_t>::size;
         else RAPIDFUZZ_IF_CONSTEXPR (MaxLen <= 32)
             return native_simd<uint32_t>::size;
-        else RAPIDFUZZ_IF_CONSTEXPR (MaxLen <= 64)
+        else
             return native_simd<uint64_t>::size;
 
-        static_assert(MaxLen <= 64, "expected MaxLen <= 64");
+        static_assert(MaxLen <= 64 || MaxLen % 64 == 0, "expected MaxLen <= 64 or a multiple of 64");
     }
 
     static size_t find_block_count(size_t count)
@@ -365,21 +407,87 @@ public:
     void insert(InputIt1 first1, InputIt1 last1)
     {
         auto len = std::distance(first1, last1);
-        int block_pos = static_cast<int>((pos * MaxLen) % 64);
-        auto block = (pos * MaxLen) / 64;
         assert(len <= MaxLen);
 
         if (pos >= input_count) throw std::invalid_argument("out of bounds insert");
 
         str_lens[pos] = static_cast<size_t>(len);
-        for (; first1 != last1; ++first1) {
-            PM.insert(block, *first1, block_pos);
-            block_pos++;
+
+        RAPIDFUZZ_IF_CONSTEXPR (MaxLen > 64) {
+            /* the strings are split into words, which are stored vec_size blocks apart */
+            size_t vec_size = get_vec_size();
+            size_t first_block = (pos / vec_size) * vec_size * (MaxLen / 64) + pos % vec_size;
+            for (size_t i = 0; first1 != last1; ++first1, ++i)
+                PM.insert(first_block + (i / 64) * vec_size, *first1, static_cast<int>(i % 64));
+        }
+        else {
+            int block_pos = static_cast<int>((pos * MaxLen) % 64);
+            auto block = (pos * MaxLen) / 64;
+            for (; first1 != last1; ++first1) {
+                PM.insert(block, *first1, block_pos);
+                block_pos++;
+            }
         }
         pos++;
     }
 
+    /**
+     * @brief writes the scorer into \p out, so it can be loaded using deserialize.
+     * The format is described in rapidfuzz/details/Serialization.hpp
+     */
+    void serialize(std::ostream& out) const
+    {
+        detail::SerializationWriter writer(out);
+        detail::write_serialization_header(writer, detail::SerializedScorer::Levenshtein, MaxLen,
+                                           get_vec_size());
+        writer.write(static_cast<uint64_t>(input_count));
+        PM.serialize(writer);
+        writer.write_lengths(str_lens.data(), str_lens.size());
+        writer.write(static_cast<uint64_t>(weights.insert_cost));
+        writer.write(static_cast<uint64_t>(weights.delete_cost));
+        writer.write(static_cast<uint64_t>(weights.replace_cost));
+    }
+
+    /**
+     * @brief loads a scorer written by serialize
+     *
+     * The bitvectors of the strings are used in place instead of being copied, so loading a scorer
+     * only costs the page faults when the buffer is a memory mapped file and the memory is shared
+     * between all processes mapping it. Only the string lengths (8 bytes per string) are copied.
+     * The loaded scorer is read only, so insert throws.
+     *
+     * @param data buffer containing the serialized scorer. It has to be 8 byte aligned and has to
+     * outlive the scorer
+     * @param size size of the buffer in bytes
+     *
+     * @throws std::invalid_argument if the buffer does not contain a scorer of this type, or the scorer
+     * was serialized with a different MaxLen, SIMD vector size or byte order
+     */
+    static MultiLevenshtein deserialize(const void* data, size_t size)
+    {
+        detail::SerializationReader reader(data, size);
+        detail::read_serialization_header(reader, detail::SerializedScorer::Levenshtein, MaxLen,
+                                          get_vec_size());
+        return MultiLevenshtein(reader);
+    }
+
 private:
+    /* serialized scorers are read only, so they are marked as full */
+    explicit MultiLevenshtein(detail::SerializationReader& reader)
+        : input_count(static_cast<size_t>(reader.read<uint64_t>())),
+          pos(input_count),
+          PM(detail::BlockPatternMatchVector::view(reader))
+    {
+        if (PM.size() != find_block_count(input_count))
+            throw std::invalid_argument("serialized scorer is corrupted");
+
+        str_lens.resize(result_count());
+        reader.read_lengths(str_lens.data(), str_lens.size());
+        weights.insert_cost = static_cast<size_t>(reader.read<uint64_t>());
+        weights.delete_cost = static_cast<size_t>(reader.read<uint64_t>());
+        weights.replace_cost = static_cast<size_t>(reader.read<uint64_t>());
+    }
+
     template <typename InputIt2>
     void _distance(size_t* scores, size_t score_count, const detail::Range<InputIt2>& s2,
                    size_t score_cutoff = std::numeric_limits<size_t>::max()) const
@@ -396,6 +504,9 @@ private:
             detail::levenshtein_hyrroe2003_simd<uint32_t>(scores_, PM, str_lens, s2, score_cutoff);
         else RAPIDFUZZ_IF_CONSTEXPR (MaxLen == 64)
             detail::levenshtein_hyrroe2003_simd<uint64_t>(scores_, PM, str_lens, s2, score_cutoff);
+        else
+            detail::levenshtein_hyrroe2003_simd_multiword<MaxLen / 64>(scores_, PM, str_lens, s2,
+                                                                       score_cutoff, get_vec_size());
     }
 
     template <typename InputIt2>
@@ -431,11 +542,233 @@ struct CachedLevenshtein : public detail::CachedDistanceBase<CachedLevenshtein<C
         : s1(first1, last1), PM(detail::make_range(first1, last1)), weights(aWeights)
     {}
 
+    /**
+     * @brief state of the bit-parallel algorithm after consuming a prefix of s2
+     *
+     * This is used for type-ahead searches: instead of comparing the whole query with s1
+     * on every keystroke, the new characters are appended to the state of the previous
+     * query. States are cheap to copy, so going back to an older prefix only requires
+     * keeping a copy of its state around.
+     *
+     * @code{.cpp}
+     * rapidfuzz::CachedLevenshtein<char> scorer("new york mets");
+     * auto state = scorer.make_state();
+     * scorer.append(state, "new y");
+     * scorer.append(state, "ork mets");
+     * // 0
+     * size_t dist = state.distance();
+     * @endcode
+     */
+    struct State {
+        /** Levenshtein distance between s1 and the characters appended so far */
+        size_t distance() const
+        {
+            return dist * weight;
+        }
+
+        /** number of characters appended so far */
+        size_t length() const
+        {
+            return len2;
+        }
+
+    private:
+        friend CachedLevenshtein;
+
+        std::vector<detail::LevenshteinRow> vecs;
+        size_t dist;
+        size_t len2;
+        size_t weight;
+    };
+
+    /**
+     * @brief creates the state for an empty s2
+     *
+     * Only weights with insert_cost == delete_cost == replace_cost are supported.
+     */
+    State make_state() const
+    {
+        if (weights.insert_cost != weights.delete_cost || weights.insert_cost != weights.replace_cost)
+            throw std::invalid_argument("State requires uniform weights");
+
+        State state;
+        state.vecs.resize(is_compact() ? compact_PM.size() : PM.size());
+        state.dist = s1.size();
+        state.len2 = 0;
+        state.weight = weights.insert_cost;
+        return state;
+    }
+
+    /**
+     * @brief appends the characters [first2, last2) to the string described by state
+     */
+    template <typename InputIt2>
+    void append(State& state, InputIt2 first2, InputIt2 last2) const
+    {
+        auto s2 = detail::make_range(first2, last2);
+        if (is_compact())
+            state.dist =
+                detail::levenshtein_hyrroe2003_resume(compact_PM, s1.size(), state.vecs, state.dist, s2);
+        else
+            state.dist = detail::levenshtein_hyrroe2003_resume(PM, s1.size(), state.vecs, state.dist, s2);
+        state.len2 += s2.size();
+    }
+
+    template <typename Sentence2>
+    void append(State& state, const Sentence2& s2) const
+    {
+        append(state, detail::to_begin(s2), detail::to_end(s2));
+    }
+
+    /**
+     * @brief Find all occurrences of s1 in s2 with a distance <= max (see levenshtein_find_all)
+     *
+     * Only weights with insert_cost == delete_cost == replace_cost are supported.
+     */
+    template <typename InputIt2>
+    std::vector<ScoreAlignment<size_t>> find_all(InputIt2 first2, InputIt2 last2, size_t max,
+                                                 bool find_start = true) const
+    {
+        if (weights.insert_cost != weights.delete_cost || weights.insert_cost != weights.replace_cost)
+            throw std::invalid_argument("find_all requires uniform weights");
+
+        size_t weight = weights.insert_cost;
+        size_t new_max = weight ? max / weight : std::numeric_limits<size_t>::max();
+        auto s2 = detail::make_range(first2, last2);
+        std::vector<ScoreAlignment<size_t>> matches;
+        if (is_compact())
+            matches =
+                detail::levenshtein_find_all(compact_PM, detail::make_range(s1), s2, new_max, find_start);
+        else
+            matches = detail::levenshtein_find_all(PM, detail::make_range(s1), s2, new_max, find_start);
+
+        for (auto& match : matches)
+            match.score *= weight;
+        return matches;
+    }
+
+    template <typename Sentence2>
+    std::vector<ScoreAlignment<size_t>> find_all(const Sentence2& s2, size_t max,
+                                                 bool find_start = true) const
+    {
+        return find_all(detail::to_begin(s2), detail::to_end(s2), max, find_start);
+    }
+
+    /**
+     * @brief state of find_all after searching a prefix of the text
+     *
+     * This is used to search texts, which are not available at once, e.g. files read in chunks.
+     * The bit vectors are carried from one chunk to the next, so searching the chunks finds the
+     * same occurrences as searching the whole text, including occurrences crossing the end of a
+     * chunk. To find their start the state keeps up to 2 * len(s1) characters of the text.
+     *
+     * @code{.cpp}
+     * rapidfuzz::CachedLevenshtein<char> scorer("connection refused");
+     * auto state = scorer.make_search_state(2);
+     * std::string chunk;
+     * while (read_chunk(file, chunk))
+     *     for (const auto& match : scorer.find_all(state, chunk))
+     *         // match.dest_start and match.dest_end are positions in the whole file
+     *         report(match);
+     * @endcode
+     */
+    struct SearchState {
+        /** number of characters searched so far */
+        size_t length() const
+        {
+            return search.len2;
+        }
+
+    private:
+        friend CachedLevenshtein;
+
+        detail::LevenshteinSearchState search;
+        size_t max;
+        bool find_start;
+        size_t weight;
+    };
+
+    /**
+     * @brief creates the state for searching a text in chunks with find_all(state, chunk)
+     *
+     * @param max
+     *   maximum Levenshtein distance of an occurrence
+     * @param find_start
+     *   calculate the start of every occurrence (see levenshtein_find_all)
+     *
+     * Only weights with insert_cost == delete_cost == replace_cost are supported.
+     */
+    SearchState make_search_state(size_t max, bool find_start = true) const
+    {
+        if (weights.insert_cost != weights.delete_cost || weights.insert_cost != weights.replace_cost)
+            throw std::invalid_argument("find_all requires uniform weights");
+
+        SearchState state;
+        size_t words = is_compact() ? compact_PM.size() : PM.size();
+        state.search = detail::LevenshteinSearchState(words, s1.size());
+        state.weight = weights.insert_cost;
+        state.max = state.weight ? max / state.weight : std::numeric_limits<size_t>::max();
+        state.find_start = find_start;
+        return state;
+    }
+
+    /**
+     * @brief Find the occurrences of s1 ending in the next chunk [first2, last2) of the text
+     *
+     * @return occurrences in the order of their end position. dest_start and dest_end are
+     *   positions in the whole text
+     */
+    template <typename InputIt2>
+    std::vector<ScoreAlignment<size_t>> find_all(SearchState& state, InputIt2 first2,
+                                                 InputIt2 last2) const
+    {
+        std::vector<ScoreAlignment<size_t>> matches;
+        auto s2 = detail::make_range(first2, last2);
+        if (is_compact())
+            detail::levenshtein_find_all(compact_PM, s1.size(), state.search, s2, state.max,
+                                         state.find_start, matches);
+        else
+            detail::levenshtein_find_all(PM, s1.size(), state.search, s2, state.max, state.find_start,
+                                         matches);
+
+        for (auto& match : matches)
+            match.score *= state.weight;
+        return matches;
+    }
+
+    template <typename Sentence2>
+    std::vector<ScoreAlignment<size_t>> find_all(SearchState& state, const Sentence2& s2) const
+    {
+        return find_all(state, detail::to_begin(s2), detail::to_end(s2));
+    }
+
+    /**
+     * @brief stores the precomputed bitvectors of s1 in a compact layout
+     *
+     * By default the scorer keeps 2 KiB of bitvectors for every 64 characters of s1, independent
+     * of the amount of distinct characters in s1. The compact layout only stores the characters
+     * occurring in s1, which reduces the memory usage of the scorer about 5x for typical strings. This is
+     * useful when a lot of scorers are kept in memory at the same time. Comparisons are slightly slower,
+     * since the bitvector of a character has to be looked up first.
+     */
+    void shrink_to_fit()
+    {
+        if (is_compact() || !PM.size()) return;
+
+        compact_PM = detail::CompactBlockPatternMatchVector(PM);
+        PM = detail::BlockPatternMatchVector(0);
+    }
+
 private:
     friend detail::CachedDistanceBase<CachedLevenshtein<CharT1>, size_t, 0,
                                       std::numeric_limits<int64_t>::max()>;
     friend detail::CachedNormalizedMetricBase<CachedLevenshtein<CharT1>>;
 
+    bool is_compact() const noexcept
+    {
+        return compact_PM.size() != 0;
+    }
+
     template <typename InputIt2>
     size_t maximum(const detail::Range<InputIt2>& s2) const
     {
@@ -444,6 +777,14 @@ private:
 
     template <typename InputIt2>
     size_t _distance(const detail::Range<InputIt2>& s2, size_t score_cutoff, size_t score_hint) const
+    {
+        if (is_compact()) return _distance_impl(compact_PM, s2, score_cutoff, score_hint);
+        return _distance_impl(PM, s2, score_cutoff, score_hint);
+    }
+
+    template <typename PM_Vec, typename InputIt2>
+    size_t _distance_impl(const PM_Vec& block, const detail::Range<InputIt2>& s2, size_t score_cutoff,
+                          size_t score_hint) const
     {
         if (weights.insert_cost == weights.delete_cost) {
             /* when insertions + deletions operations are free there can not be any edit distance */
@@ -454,7 +795,7 @@ private:
                 // max can make use of the common divisor of the three weights
                 size_t new_score_cutoff = detail::ceil_div(score_cutoff, weights.insert_cost);
                 size_t new_score_hint = detail::ceil_div(score_hint, weights.insert_cost);
-                size_t dist = detail::uniform_levenshtein_distance(PM, detail::make_range(s1), s2,
+                size_t dist = detail::uniform_levenshtein_distance(block, detail::make_range(s1), s2,
                                                                    new_score_cutoff, new_score_hint);
                 dist *= weights.insert_cost;
 
@@ -467,7 +808,7 @@ private:
             else if (weights.replace_cost >= weights.insert_cost + weights.delete_cost) {
                 // max can make use of the common divisor of the three weights
                 size_t new_max = detail::ceil_div(score_cutoff, weights.insert_cost);
-                size_t dist = detail::indel_distance(PM, detail::make_range(s1), s2, new_max);
+                size_t dist = detail::indel_distance(block, detail::make_range(s1), s2, new_max);
                 dist *= weights.insert_cost;
                 return (dist <= score_cutoff) ? dist : score_cutoff + 1;
             }
@@ -478,6 +819,7 @@ private:
 
     std::vector<CharT1> s1;
     detail::BlockPatternMatchVector PM;
+    detail::CompactBlockPatternMatchVector compact_PM;
     LevenshteinWeightTable weights;
 };
 
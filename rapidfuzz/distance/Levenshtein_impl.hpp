@@ -10,6 +10,7 @@
 #include <rapidfuzz/details/common.hpp>
 #include <rapidfuzz/details/distance.hpp>
 #include <rapidfuzz/details/intrinsics.hpp>
+#include <rapidfuzz/details/simd.hpp>
 #include <rapidfuzz/details/type_traits.hpp>
 #include <rapidfuzz/distance/Indel.hpp>
 #include <sys/types.h>
@@ -86,8 +87,10 @@ template <typename InputIt1, typename InputIt2>
 size_t generalized_levenshtein_wagner_fischer(const Range<InputIt1>& s1, const Range<InputIt2>& s2,
                                               LevenshteinWeightTable weights, size_t max)
 {
+    RAPIDFUZZ_STATS_CALL(LevenshteinWagnerFischer, s1.size() * s2.size());
+    ScratchFrame frame;
     size_t cache_size = s1.size() + 1;
-    std::vector<size_t> cache(cache_size);
+    ScratchVector<size_t> cache(cache_size);
     assume(cache_size != 0);
 
     for (size_t i = 0; i < cache_size; ++i)
@@ -99,7 +102,7 @@ size_t generalized_levenshtein_wagner_fischer(const Range<InputIt1>& s1, const R
         *cache_iter += weights.insert_cost;
 
         for (const auto& ch1 : s1) {
-            if (ch1 != ch2)
+            if (!char_equal(ch1, ch2))
                 temp = std::min({*cache_iter + weights.delete_cost, *(cache_iter + 1) + weights.insert_cost,
                                  temp + weights.replace_cost});
             ++cache_iter;
@@ -146,7 +149,10 @@ size_t generalized_levenshtein_distance(Range<InputIt1> s1, Range<InputIt2> s2,
                                         LevenshteinWeightTable weights, size_t max)
 {
     size_t min_edits = levenshtein_min_distance(s1, s2, weights);
-    if (min_edits > max) return max + 1;
+    if (min_edits > max) {
+        RAPIDFUZZ_STATS_CALL(LevenshteinFilter, 0);
+        return max + 1;
+    }
 
     /* common affix does not effect Levenshtein distance */
     remove_common_affix(s1, s2);
@@ -191,11 +197,12 @@ size_t levenshtein_mbleven2018(const Range<InputIt1>& s1, const Range<InputIt2>&
     size_t len2 = s2.size();
     assert(len1 > 0);
     assert(len2 > 0);
-    assert(*s1.begin() != *s2.begin());
+    assert(!char_equal(*s1.begin(), *s2.begin()));
     assert(*std::prev(s1.end()) != *std::prev(s2.end()));
 
     if (len1 < len2) return levenshtein_mbleven2018(s2, s1, max);
 
+    RAPIDFUZZ_STATS_CALL(LevenshteinMbleven, 0);
     size_t len_diff = len1 - len2;
 
     if (max == 1) return max + static_cast<size_t>(len_diff == 1 || len1 != 1);
@@ -212,7 +219,7 @@ size_t levenshtein_mbleven2018(const Range<InputIt1>& s1, const Range<InputIt2>&
         if (!ops) break;
 
         while (iter_s1 != s1.end() && iter_s2 != s2.end()) {
-            if (*iter_s1 != *iter_s2) {
+            if (!char_equal(*iter_s1, *iter_s2)) {
                 cur_dist++;
                 if (!ops) break;
                 if (ops & 1) iter_s1++;
@@ -262,6 +269,7 @@ auto levenshtein_hyrroe2003(const PM_Vec& PM, const Range<InputIt1>& s1, const R
     -> LevenshteinResult<RecordMatrix, RecordBitRow>
 {
     assert(s1.size() != 0);
+    RAPIDFUZZ_STATS_CALL(LevenshteinHyrroe2003, s2.size());
 
     /* VP is set to 1^m. Shifting by bitwidth would be undefined behavior */
     uint64_t VP = ~UINT64_C(0);
@@ -322,104 +330,74 @@ auto levenshtein_hyrroe2003(const PM_Vec& PM, const Range<InputIt1>& s1, const R
 }
 
 #ifdef RAPIDFUZZ_SIMD
+#    if defined(RAPIDFUZZ_AVX512)
+#        define RAPIDFUZZ_SIMD_ISA_AVX512
+#    elif defined(RAPIDFUZZ_AVX2)
+#        define RAPIDFUZZ_SIMD_ISA_AVX2
+#    endif
+#    include <rapidfuzz/distance/Levenshtein_simd.impl>
+#    undef RAPIDFUZZ_SIMD_ISA_AVX512
+#    undef RAPIDFUZZ_SIMD_ISA_AVX2
+
+#    ifdef RAPIDFUZZ_AVX2_DISPATCH
+#        define RAPIDFUZZ_SIMD_ISA_AVX2
+RAPIDFUZZ_AVX2_TARGET_BEGIN
+#        include <rapidfuzz/distance/Levenshtein_simd.impl>
+RAPIDFUZZ_AVX2_TARGET_END
+#        undef RAPIDFUZZ_SIMD_ISA_AVX2
+#    endif
+
 template <typename VecType, typename InputIt, int _lto_hack = RAPIDFUZZ_LTO_HACK>
 void levenshtein_hyrroe2003_simd(Range<size_t*> scores, const detail::BlockPatternMatchVector& block,
                                  const std::vector<size_t>& s1_lengths, const Range<InputIt>& s2,
                                  size_t score_cutoff) noexcept
 {
-#    ifdef RAPIDFUZZ_AVX2
-    using namespace simd_avx2;
-#    else
-    using namespace simd_sse2;
+    RAPIDFUZZ_STATS_CALL(LevenshteinSimd, block.size() * s2.size());
+#    ifdef RAPIDFUZZ_AVX2_DISPATCH
+    if (cpu_supports_avx2())
+        return avx2::levenshtein_hyrroe2003_simd<VecType>(scores, block, s1_lengths, s2, score_cutoff);
 #    endif
-    static constexpr size_t alignment = native_simd<VecType>::alignment;
-    static constexpr size_t vec_width = native_simd<VecType>::size;
-    static constexpr size_t vecs = native_simd<uint64_t>::size;
-    assert(block.size() % vecs == 0);
-
-    native_simd<VecType> zero(VecType(0));
-    native_simd<VecType> one(1);
-    size_t result_index = 0;
-
-    for (size_t cur_vec = 0; cur_vec < block.size(); cur_vec += vecs) {
-        /* VP is set to 1^m */
-        native_simd<VecType> VP(static_cast<VecType>(-1));
-        native_simd<VecType> VN(VecType(0));
-
-        alignas(alignment) std::array<VecType, vec_width> currDist_;
-        unroll<size_t, vec_width>(
-            [&](size_t i) { currDist_[i] = static_cast<VecType>(s1_lengths[result_index + i]); });
-        native_simd<VecType> currDist(reinterpret_cast<uint64_t*>(currDist_.data()));
-        /* mask used when computing D[m,j] in the paper 10^(m-1) */
-        alignas(alignment) std::array<VecType, vec_width> mask_;
-        unroll<size_t, vec_width>([&](size_t i) {
-            if (s1_lengths[result_index + i] == 0)
-                mask_[i] = 0;
-            else
-                mask_[i] = static_cast<VecType>(UINT64_C(1) << (s1_lengths[result_index + i] - 1));
-        });
-        native_simd<VecType> mask(reinterpret_cast<uint64_t*>(mask_.data()));
-
-        for (const auto& ch : s2) {
-            /* Step 1: Computing D0 */
-            alignas(alignment) std::array<uint64_t, vecs> stored;
-            unroll<size_t, vecs>([&](size_t i) { stored[i] = block.get(cur_vec + i, ch); });
-
-            native_simd<VecType> X(stored.data());
-            auto D0 = (((X & VP) + VP) ^ VP) | X | VN;
-
-            /* Step 2: Computing HP and HN */
-            auto HP = VN | ~(D0 | VP);
-            auto HN = D0 & VP;
-
-            /* Step 3: Computing the value D[m,j] */
-            currDist += andnot(one, (HP & mask) == zero);
-            currDist -= andnot(one, (HN & mask) == zero);
-
-            /* Step 4: Computing Vp and VN */
-            HP = (HP << 1) | one;
-            HN = (HN << 1);
 
-            VP = HN | ~(D0 | HP);
-            VN = HP & D0;
-        }
-
-        alignas(alignment) std::array<VecType, vec_width> distances;
-        currDist.store(distances.data());
-
-        unroll<size_t, vec_width>([&](size_t i) {
-            size_t score = 0;
-            /* strings of length 0 are not handled correctly */
-            if (s1_lengths[result_index] == 0) {
-                score = s2.size();
-            }
-            /* calculate score under consideration of wraparounds in parallel counter */
-            else {
-                RAPIDFUZZ_IF_CONSTEXPR (std::numeric_limits<VecType>::max() <
-                                        std::numeric_limits<size_t>::max())
-                {
-                    size_t min_dist = abs_diff(s1_lengths[result_index], s2.size());
-                    size_t wraparound_score = static_cast<size_t>(std::numeric_limits<VecType>::max()) + 1;
-
-                    score = (min_dist / wraparound_score) * wraparound_score;
-                    VecType remainder = static_cast<VecType>(min_dist % wraparound_score);
+#    if defined(RAPIDFUZZ_AVX512)
+    avx512::levenshtein_hyrroe2003_simd<VecType>(scores, block, s1_lengths, s2, score_cutoff);
+#    elif defined(RAPIDFUZZ_AVX2)
+    avx2::levenshtein_hyrroe2003_simd<VecType>(scores, block, s1_lengths, s2, score_cutoff);
+#    else
+    sse2::levenshtein_hyrroe2003_simd<VecType>(scores, block, s1_lengths, s2, score_cutoff);
+#    endif
+}
 
-                    if (distances[i] < remainder) score += wraparound_score;
-                }
+template <size_t Words, typename InputIt, int _lto_hack = RAPIDFUZZ_LTO_HACK>
+void levenshtein_hyrroe2003_simd_multiword(Range<size_t*> scores, const BlockPatternMatchVector& block,
+                                           const std::vector<size_t>& s1_lengths, const Range<InputIt>& s2,
+                                           size_t score_cutoff, size_t group_size) noexcept
+{
+    RAPIDFUZZ_STATS_CALL(LevenshteinSimd, block.size() * s2.size());
+#    ifdef RAPIDFUZZ_AVX2_DISPATCH
+    if (cpu_supports_avx2())
+        return avx2::levenshtein_hyrroe2003_simd_multiword<Words>(scores, block, s1_lengths, s2, score_cutoff,
+                                                                  group_size);
+#    endif
 
-                score += distances[i];
-            }
-            scores[result_index] = (score <= score_cutoff) ? score : score_cutoff + 1;
-            result_index++;
-        });
-    }
+#    if defined(RAPIDFUZZ_AVX512)
+    avx512::levenshtein_hyrroe2003_simd_multiword<Words>(scores, block, s1_lengths, s2, score_cutoff,
+                                                         group_size);
+#    elif defined(RAPIDFUZZ_AVX2)
+    avx2::levenshtein_hyrroe2003_simd_multiword<Words>(scores, block, s1_lengths, s2, score_cutoff,
+                                                       group_size);
+#    else
+    sse2::levenshtein_hyrroe2003_simd_multiword<Words>(scores, block, s1_lengths, s2, score_cutoff,
+                                                       group_size);
+#    endif
 }
+
 #endif
 
-template <typename InputIt1, typename InputIt2>
-size_t levenshtein_hyrroe2003_small_band(const BlockPatternMatchVector& PM, const Range<InputIt1>& s1,
+template <typename PM_Vec, typename InputIt1, typename InputIt2>
+size_t levenshtein_hyrroe2003_small_band(const PM_Vec& PM, const Range<InputIt1>& s1,
                                          const Range<InputIt2>& s2, size_t max)
 {
+    RAPIDFUZZ_STATS_CALL(LevenshteinSmallBand, 0);
     /* VP is set to 1^m. */
     uint64_t VP = ~UINT64_C(0) << (64 - max - 1);
     uint64_t VN = 0;
@@ -460,7 +438,11 @@ size_t levenshtein_hyrroe2003_small_band(const BlockPatternMatchVector& PM, cons
             /* Step 3: Computing the value D[m,j] */
             currDist += !bool(D0 & diagonal_mask);
 
-            if (currDist > break_score) return max + 1;
+            if (currDist > break_score) {
+                RAPIDFUZZ_STATS_WORDS(LevenshteinSmallBand, i + 1);
+                RAPIDFUZZ_STATS_EARLY_EXIT(LevenshteinSmallBand);
+                return max + 1;
+            }
 
             /* Step 4: Computing Vp and VN */
             VP = HN | ~((D0 >> 1) | HP);
@@ -494,13 +476,18 @@ size_t levenshtein_hyrroe2003_small_band(const BlockPatternMatchVector& PM, cons
         currDist -= bool(HN & horizontal_mask);
         horizontal_mask >>= 1;
 
-        if (currDist > break_score) return max + 1;
+        if (currDist > break_score) {
+            RAPIDFUZZ_STATS_WORDS(LevenshteinSmallBand, i + 1);
+            RAPIDFUZZ_STATS_EARLY_EXIT(LevenshteinSmallBand);
+            return max + 1;
+        }
 
         /* Step 4: Computing Vp and VN */
         VP = HN | ~((D0 >> 1) | HP);
         VN = (D0 >> 1) & HP;
     }
 
+    RAPIDFUZZ_STATS_WORDS(LevenshteinSmallBand, s2.size());
     return (currDist <= max) ? currDist : max + 1;
 }
 
@@ -511,6 +498,7 @@ auto levenshtein_hyrroe2003_small_band(const Range<InputIt1>& s1, const Range<In
     assert(max <= s1.size());
     assert(max <= s2.size());
     assert(s2.size() >= s1.size() - max);
+    RAPIDFUZZ_STATS_CALL(LevenshteinSmallBand, 0);
 
     /* VP is set to 1^m. Shifting by bitwidth would be undefined behavior */
     uint64_t VP = ~UINT64_C(0) << (64 - max - 1);
@@ -572,6 +560,8 @@ auto levenshtein_hyrroe2003_small_band(const Range<InputIt1>& s1, const Range<In
         res.dist += !bool(D0 & diagonal_mask);
 
         if (res.dist > break_score) {
+            RAPIDFUZZ_STATS_WORDS(LevenshteinSmallBand, i + 1);
+            RAPIDFUZZ_STATS_EARLY_EXIT(LevenshteinSmallBand);
             res.dist = max + 1;
             return res;
         }
@@ -615,6 +605,8 @@ auto levenshtein_hyrroe2003_small_band(const Range<InputIt1>& s1, const Range<In
         horizontal_mask >>= 1;
 
         if (res.dist > break_score) {
+            RAPIDFUZZ_STATS_WORDS(LevenshteinSmallBand, i + 1);
+            RAPIDFUZZ_STATS_EARLY_EXIT(LevenshteinSmallBand);
             res.dist = max + 1;
             return res;
         }
@@ -630,30 +622,241 @@ auto levenshtein_hyrroe2003_small_band(const Range<InputIt1>& s1, const Range<In
         }
     }
 
+    RAPIDFUZZ_STATS_WORDS(LevenshteinSmallBand, s2.size());
     if (res.dist > max) res.dist = max + 1;
 
     return res;
 }
 
+/**
+ * @brief advances the bit vectors of the blockwise Levenshtein algorithm by one character of s2
+ *
+ * @param HP_carry horizontal delta of the first row. This is 1 for the Levenshtein distance
+ * and 0 when searching s1 in s2, since an occurrence can start at any position of s2
+ *
+ * @return the distance in the last row after consuming ch, when the distance before was dist
+ */
+template <typename PM_Vec, typename Vecs, typename CharT>
+size_t levenshtein_hyrroe2003_step(const PM_Vec& PM, uint64_t Last, Vecs& vecs, size_t dist, CharT ch,
+                                   uint64_t HP_carry)
+{
+    size_t words = vecs.size();
+    uint64_t HN_carry = 0;
+
+    for (size_t word = 0; word < words; ++word) {
+        /* Step 1: Computing D0 */
+        uint64_t PM_j = PM.get(word, ch);
+        uint64_t VN = vecs[word].VN;
+        uint64_t VP = vecs[word].VP;
+
+        uint64_t X = PM_j | HN_carry;
+        uint64_t D0 = (((X & VP) + VP) ^ VP) | X | VN;
+
+        /* Step 2: Computing HP and HN */
+        uint64_t HP = VN | ~(D0 | VP);
+        uint64_t HN = D0 & VP;
+
+        /* Step 3: Computing the value D[m,j] */
+        if (word == words - 1) {
+            dist += bool(HP & Last);
+            dist -= bool(HN & Last);
+        }
+
+        /* Step 4: Computing Vp and VN */
+        uint64_t HP_carry_temp = HP_carry;
+        uint64_t HN_carry_temp = HN_carry;
+        HP_carry = HP >> 63;
+        HN_carry = HN >> 63;
+        HP = (HP << 1) | HP_carry_temp;
+        HN = (HN << 1) | HN_carry_temp;
+
+        vecs[word].VP = HN | ~(D0 | HP);
+        vecs[word].VN = HP & D0;
+    }
+
+    return dist;
+}
+
+/**
+ * @brief advances the bit vectors of the blockwise Levenshtein algorithm by the characters of s2
+ *
+ * This allows resuming the calculation after more characters are appended to s2.
+ *
+ * @return the Levenshtein distance after consuming s2, when the distance before was dist
+ */
+template <typename PM_Vec, typename InputIt2>
+size_t levenshtein_hyrroe2003_resume(const PM_Vec& PM, size_t len1, std::vector<LevenshteinRow>& vecs,
+                                     size_t dist, const Range<InputIt2>& s2)
+{
+    /* every character of s2 has to be inserted */
+    if (len1 == 0) return dist + s2.size();
+
+    uint64_t Last = UINT64_C(1) << ((len1 - 1) % 64);
+    for (const auto& ch : s2)
+        dist = levenshtein_hyrroe2003_step(PM, Last, vecs, dist, ch, 1);
+
+    return dist;
+}
+
+/**
+ * @brief state of levenshtein_find_all after searching a prefix of the text
+ */
+struct LevenshteinSearchState {
+    LevenshteinSearchState() = default;
+
+    LevenshteinSearchState(size_t words, size_t len1) : vecs(words), dist(len1)
+    {}
+
+    std::vector<LevenshteinRow> vecs;
+    /* end of the text searched so far, which is required to find the start of occurrences ending
+     * in the next chunk. The characters are converted using multi_char */
+    std::vector<uint64_t> history;
+    size_t dist = 0;
+    /* amount of characters searched so far */
+    size_t len2 = 0;
+    /* the occurrences ending at position 0 were reported */
+    bool started = false;
+};
+
+/**
+ * @brief finds the start of an occurrence of s1 in the text, which ends at dest_end with the distance dist
+ *
+ * The Levenshtein distance between the reversed s1 and the reversed text in front of dest_end
+ * is calculated one character at a time. The first time it reaches dist is the start of the
+ * shortest occurrence. The text in front of dest_end consists of the history and prefix.
+ */
+template <typename PM_Vec, typename InputIt2>
+size_t levenshtein_find_start(const PM_Vec& PM, size_t len1, const std::vector<uint64_t>& history,
+                              const Range<InputIt2>& prefix, size_t dest_end, size_t dist)
+{
+    if (len1 <= dist) return dest_end;
+
+    ScratchFrame frame;
+    ReversedPatternMatchVector<PM_Vec> PM_reversed(PM, len1);
+    ScratchVector<LevenshteinRow> vecs(PM.size());
+    uint64_t Last = UINT64_C(1) << ((len1 - 1) % 64);
+    size_t limit = std::min(dest_end, len1 + dist);
+    size_t cur_dist = len1;
+    size_t dest_start = dest_end;
+
+    auto step = [&](uint64_t ch) {
+        cur_dist = levenshtein_hyrroe2003_step(PM_reversed, Last, vecs, cur_dist, ch, 1);
+        --dest_start;
+        return cur_dist <= dist || dest_end - dest_start == limit;
+    };
+
+    for (auto iter = prefix.rbegin(); iter != prefix.rend(); ++iter)
+        if (step(multi_char(*iter))) return dest_start;
+
+    for (auto iter = history.rbegin(); iter != history.rend(); ++iter)
+        if (step(*iter)) return dest_start;
+
+    return dest_start;
+}
+
+/**
+ * @brief keeps the last keep characters of the history followed by s2
+ */
+template <typename InputIt2>
+void levenshtein_update_history(std::vector<uint64_t>& history, Range<InputIt2> s2, size_t keep)
+{
+    if (s2.size() >= keep) {
+        history.clear();
+        s2.remove_prefix(s2.size() - keep);
+    }
+    else if (history.size() + s2.size() > keep) {
+        size_t excess = history.size() + s2.size() - keep;
+        history.erase(history.begin(), history.begin() + static_cast<ptrdiff_t>(excess));
+    }
+
+    for (const auto& ch : s2)
+        history.push_back(multi_char(ch));
+}
+
+/**
+ * @brief finds all end positions of occurrences of s1 in the next chunk s2 of the text with a
+ * Levenshtein distance <= max
+ *
+ * This is the search mode of Myers' algorithm: the first row of the matrix is 0, so the
+ * occurrence can start anywhere in the text. The text is processed in a single pass and state
+ * carries the bit vectors from one chunk to the next, so the text can be searched in chunks.
+ * Positions of the matches are relative to the start of the whole text.
+ */
+template <typename PM_Vec, typename InputIt2>
+void levenshtein_find_all(const PM_Vec& PM, size_t len1, LevenshteinSearchState& state,
+                          const Range<InputIt2>& s2, size_t max, bool find_start,
+                          std::vector<ScoreAlignment<size_t>>& matches)
+{
+    size_t chunk_start = state.len2;
+    size_t pos = chunk_start;
+
+    /* the empty string occurs at every position */
+    if (len1 == 0) {
+        for (size_t i = state.started ? 1 : 0; i <= s2.size(); ++i)
+            matches.emplace_back(0, 0, 0, pos + i, pos + i);
+        state.started = true;
+        state.len2 += s2.size();
+        return;
+    }
+
+    uint64_t Last = UINT64_C(1) << ((len1 - 1) % 64);
+    auto add_match = [&](InputIt2 iter_end, size_t dest_end) {
+        size_t dest_start = dest_end;
+        if (find_start)
+            dest_start = levenshtein_find_start(PM, len1, state.history,
+                                                Range<InputIt2>(s2.begin(), iter_end, dest_end - chunk_start),
+                                                dest_end, state.dist);
+        matches.emplace_back(state.dist, 0, len1, dest_start, dest_end);
+    };
+
+    if (!state.started && state.dist <= max) add_match(s2.begin(), pos);
+    state.started = true;
+
+    for (auto iter = s2.begin(); iter != s2.end();) {
+        state.dist = levenshtein_hyrroe2003_step(PM, Last, state.vecs, state.dist, *iter, 0);
+        ++iter;
+        ++pos;
+        if (state.dist <= max) add_match(iter, pos);
+    }
+    state.len2 = pos;
+
+    /* the start of an occurrence is at most len1 + dist characters in front of its end */
+    if (find_start) levenshtein_update_history(state.history, s2, len1 + std::min(len1, max));
+}
+
+template <typename PM_Vec, typename InputIt1, typename InputIt2>
+std::vector<ScoreAlignment<size_t>> levenshtein_find_all(const PM_Vec& PM, const Range<InputIt1>& s1,
+                                                         const Range<InputIt2>& s2, size_t max,
+                                                         bool find_start)
+{
+    std::vector<ScoreAlignment<size_t>> matches;
+    LevenshteinSearchState state(PM.size(), s1.size());
+    levenshtein_find_all(PM, s1.size(), state, s2, max, find_start, matches);
+    return matches;
+}
+
 /**
  * @param stop_row specifies the row to record when using RecordBitRow
  */
-template <bool RecordMatrix, bool RecordBitRow, typename InputIt1, typename InputIt2>
-auto levenshtein_hyrroe2003_block(const BlockPatternMatchVector& PM, const Range<InputIt1>& s1,
+template <bool RecordMatrix, bool RecordBitRow, typename PM_Vec, typename InputIt1, typename InputIt2>
+auto levenshtein_hyrroe2003_block(const PM_Vec& PM, const Range<InputIt1>& s1,
                                   const Range<InputIt2>& s2, size_t max = std::numeric_limits<size_t>::max(),
                                   size_t stop_row = std::numeric_limits<size_t>::max())
     -> LevenshteinResult<RecordMatrix, RecordBitRow>
 {
     LevenshteinResult<RecordMatrix, RecordBitRow> res;
+    RAPIDFUZZ_STATS_CALL(LevenshteinBlock, 0);
     if (max < abs_diff(s1.size(), s2.size())) {
+        RAPIDFUZZ_STATS_EARLY_EXIT(LevenshteinBlock);
         res.dist = max + 1;
         return res;
     }
 
+    ScratchFrame frame;
     size_t word_size = sizeof(uint64_t) * 8;
     size_t words = PM.size();
-    std::vector<LevenshteinRow> vecs(words);
-    std::vector<size_t> scores(words);
+    ScratchVector<LevenshteinRow> vecs(words);
+    ScratchVector<size_t> scores(words);
     uint64_t Last = UINT64_C(1) << ((s1.size() - 1) % word_size);
 
     for (size_t i = 0; i < words - 1; ++i)
@@ -745,6 +948,7 @@ auto levenshtein_hyrroe2003_block(const BlockPatternMatchVector& PM, const Range
             /* Step 3: Computing the value D[m,j] */
             scores[word] = static_cast<size_t>(static_cast<ptrdiff_t>(scores[word]) + advance_block(word));
         }
+        RAPIDFUZZ_STATS_WORDS(LevenshteinBlock, last_block + 1 - first_block);
 
         max = static_cast<size_t>(
             std::min(static_cast<ptrdiff_t>(max),
@@ -812,6 +1016,7 @@ auto levenshtein_hyrroe2003_block(const BlockPatternMatchVector& PM, const Range
 
         /* distance is larger than max, so band stops to exist */
         if (last_block < first_block) {
+            RAPIDFUZZ_STATS_EARLY_EXIT(LevenshteinBlock);
             res.dist = max + 1;
             return res;
         }
@@ -833,7 +1038,7 @@ auto levenshtein_hyrroe2003_block(const BlockPatternMatchVector& PM, const Range
 
                 res_.first_block = first_block;
                 res_.last_block = last_block;
-                res_.vecs = std::move(vecs);
+                res_.vecs.assign(vecs.begin(), vecs.end());
 
                 /* unknown so make sure it is <= max */
                 res_.dist = 0;
@@ -849,8 +1054,8 @@ auto levenshtein_hyrroe2003_block(const BlockPatternMatchVector& PM, const Range
     return res;
 }
 
-template <typename InputIt1, typename InputIt2>
-size_t uniform_levenshtein_distance(const BlockPatternMatchVector& block, Range<InputIt1> s1,
+template <typename PM_Vec, typename InputIt1, typename InputIt2>
+size_t uniform_levenshtein_distance(const PM_Vec& block, Range<InputIt1> s1,
                                     Range<InputIt2> s2, size_t score_cutoff, size_t score_hint)
 {
     /* upper bound */
@@ -858,12 +1063,21 @@ size_t uniform_levenshtein_distance(const BlockPatternMatchVector& block, Range<
     if (score_hint < 31) score_hint = 31;
 
     // when no differences are allowed a direct comparision is sufficient
-    if (score_cutoff == 0) return s1 != s2;
+    if (score_cutoff == 0) {
+        RAPIDFUZZ_STATS_CALL(LevenshteinFilter, 0);
+        return !range_equal(s1, s2);
+    }
 
-    if (score_cutoff < abs_diff(s1.size(), s2.size())) return score_cutoff + 1;
+    if (score_cutoff < abs_diff(s1.size(), s2.size())) {
+        RAPIDFUZZ_STATS_CALL(LevenshteinFilter, 0);
+        return score_cutoff + 1;
+    }
 
     // important to catch, since this causes block to be empty -> raises exception on access
-    if (s1.empty()) return (s2.size() <= score_cutoff) ? s2.size() : score_cutoff + 1;
+    if (s1.empty()) {
+        RAPIDFUZZ_STATS_CALL(LevenshteinFilter, 0);
+        return (s2.size() <= score_cutoff) ? s2.size() : score_cutoff + 1;
+    }
 
     /* do this first, since we can not remove any affix in encoded form
      * todo actually we could at least remove the common prefix and just shift the band
@@ -899,7 +1113,10 @@ size_t uniform_levenshtein_distance(const BlockPatternMatchVector& block, Range<
 
     /* common affix does not effect Levenshtein distance */
     remove_common_affix(s1, s2);
-    if (s1.empty() || s2.empty()) return s1.size() + s2.size();
+    if (s1.empty() || s2.empty()) {
+        RAPIDFUZZ_STATS_CALL(LevenshteinFilter, 0);
+        return s1.size() + s2.size();
+    }
 
     return levenshtein_mbleven2018(s1, s2, score_cutoff);
 }
@@ -916,14 +1133,23 @@ size_t uniform_levenshtein_distance(Range<InputIt1> s1, Range<InputIt2> s2, size
     if (score_hint < 31) score_hint = 31;
 
     // when no differences are allowed a direct comparision is sufficient
-    if (score_cutoff == 0) return s1 != s2;
+    if (score_cutoff == 0) {
+        RAPIDFUZZ_STATS_CALL(LevenshteinFilter, 0);
+        return !range_equal(s1, s2);
+    }
 
     // at least length difference insertions/deletions required
-    if (score_cutoff < (s1.size() - s2.size())) return score_cutoff + 1;
+    if (score_cutoff < (s1.size() - s2.size())) {
+        RAPIDFUZZ_STATS_CALL(LevenshteinFilter, 0);
+        return score_cutoff + 1;
+    }
 
     /* common affix does not effect Levenshtein distance */
     remove_common_affix(s1, s2);
-    if (s1.empty() || s2.empty()) return s1.size() + s2.size();
+    if (s1.empty() || s2.empty()) {
+        RAPIDFUZZ_STATS_CALL(LevenshteinFilter, 0);
+        return s1.size() + s2.size();
+    }
 
     if (score_cutoff < 4) return levenshtein_mbleven2018(s1, s2, score_cutoff);
 
@@ -937,7 +1163,8 @@ size_t uniform_levenshtein_distance(Range<InputIt1> s1, Range<InputIt2> s2, size
     else if (full_band <= 64)
         return levenshtein_hyrroe2003_small_band<false>(s1, s2, score_cutoff).dist;
     else {
-        BlockPatternMatchVector PM(s1);
+        ScratchFrame frame;
+        auto PM = BlockPatternMatchVector::scratch(s1);
         while (score_hint < score_cutoff) {
             // todo use small band implementation if possible
             size_t score = levenshtein_hyrroe2003_block<false, false>(PM, s1, s2, score_hint).dist;
@@ -991,7 +1218,7 @@ void recover_alignment(Editops& editops, const Range<InputIt1>& s1, const Range<
                 col--;
 
                 /* Replace (Matches are not recorded) */
-                if (s1[col] != s2[row]) {
+                if (!char_equal(s1[col], s2[row])) {
                     assert(dist > 0);
                     dist--;
                     editops[editop_pos + dist].type = EditType::Replace;
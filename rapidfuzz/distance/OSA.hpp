@@ -121,7 +121,9 @@ private:
 
     RAPIDFUZZ_CONSTEXPR_CXX14 static size_t get_vec_size()
     {
-#    ifdef RAPIDFUZZ_AVX2
+#    if defined(RAPIDFUZZ_AVX512)
+        using namespace detail::simd_avx512;
+#    elif defined(RAPIDFUZZ_AVX2) || defined(RAPIDFUZZ_AVX2_DISPATCH)
         using namespace detail::simd_avx2;
 #    else
         using namespace detail::simd_sse2;
@@ -191,7 +193,43 @@ public:
         pos++;
     }
 
+    /**
+     * @brief writes the scorer into \p out, so it can be loaded using deserialize.
+     * The format is described in rapidfuzz/details/Serialization.hpp
+     */
+    void serialize(std::ostream& out) const
+    {
+        detail::SerializationWriter writer(out);
+        detail::write_serialization_header(writer, detail::SerializedScorer::OSA, MaxLen, get_vec_size());
+        writer.write(static_cast<uint64_t>(input_count));
+        PM.serialize(writer);
+        writer.write_lengths(str_lens.data(), str_lens.size());
+    }
+
+    /**
+     * @brief loads a scorer written by serialize. See MultiLevenshtein::deserialize
+     */
+    static MultiOSA deserialize(const void* data, size_t size)
+    {
+        detail::SerializationReader reader(data, size);
+        detail::read_serialization_header(reader, detail::SerializedScorer::OSA, MaxLen, get_vec_size());
+        return MultiOSA(reader);
+    }
+
 private:
+    /* serialized scorers are read only, so they are marked as full */
+    explicit MultiOSA(detail::SerializationReader& reader)
+        : input_count(static_cast<size_t>(reader.read<uint64_t>())),
+          pos(input_count),
+          PM(detail::BlockPatternMatchVector::view(reader))
+    {
+        if (PM.size() != find_block_count(input_count))
+            throw std::invalid_argument("serialized scorer is corrupted");
+
+        str_lens.resize(result_count());
+        reader.read_lengths(str_lens.data(), str_lens.size());
+    }
+
     template <typename InputIt2>
     void _distance(size_t* scores, size_t score_count, const detail::Range<InputIt2>& s2,
                    size_t score_cutoff = std::numeric_limits<size_t>::max()) const
@@ -240,10 +278,27 @@ struct CachedOSA
     CachedOSA(InputIt1 first1, InputIt1 last1) : s1(first1, last1), PM(detail::make_range(first1, last1))
     {}
 
+    /**
+     * @brief stores the precomputed bitvectors of s1 in a compact layout
+     * (see CachedLevenshtein::shrink_to_fit)
+     */
+    void shrink_to_fit()
+    {
+        if (is_compact() || !PM.size()) return;
+
+        compact_PM = detail::CompactBlockPatternMatchVector(PM);
+        PM = detail::BlockPatternMatchVector(0);
+    }
+
 private:
     friend detail::CachedDistanceBase<CachedOSA<CharT1>, size_t, 0, std::numeric_limits<int64_t>::max()>;
     friend detail::CachedNormalizedMetricBase<CachedOSA<CharT1>>;
 
+    bool is_compact() const noexcept
+    {
+        return compact_PM.size() != 0;
+    }
+
     template <typename InputIt2>
     size_t maximum(const detail::Range<InputIt2>& s2) const
     {
@@ -254,20 +309,29 @@ private:
     size_t _distance(const detail::Range<InputIt2>& s2, size_t score_cutoff, size_t) const
     {
         size_t res;
-        if (s1.empty())
-            res = s2.size();
-        else if (s2.empty())
-            res = s1.size();
-        else if (s1.size() < 64)
-            res = detail::osa_hyrroe2003(PM, detail::make_range(s1), s2, score_cutoff);
+        if (s1.empty() || s2.empty()) {
+            RAPIDFUZZ_STATS_CALL(OSAFilter, 0);
+            res = s1.size() + s2.size();
+        }
+        else if (is_compact())
+            res = _distance_impl(compact_PM, s2, score_cutoff);
         else
-            res = detail::osa_hyrroe2003_block(PM, detail::make_range(s1), s2, score_cutoff);
+            res = _distance_impl(PM, s2, score_cutoff);
 
         return (res <= score_cutoff) ? res : score_cutoff + 1;
     }
 
+    template <typename PM_Vec, typename InputIt2>
+    size_t _distance_impl(const PM_Vec& block, const detail::Range<InputIt2>& s2, size_t score_cutoff) const
+    {
+        if (s1.size() < 64) return detail::osa_hyrroe2003(block, detail::make_range(s1), s2, score_cutoff);
+
+        return detail::osa_hyrroe2003_block(block, detail::make_range(s1), s2, score_cutoff);
+    }
+
     std::vector<CharT1> s1;
     detail::BlockPatternMatchVector PM;
+    detail::CompactBlockPatternMatchVector compact_PM;
 };
 
 #ifdef RAPIDFUZZ_DEDUCTION_GUIDES
@@ -34,6 +34,7 @@ namespace detail {
 template <typename PM_Vec, typename InputIt1, typename InputIt2>
 size_t osa_hyrroe2003(const PM_Vec& PM, const Range<InputIt1>& s1, const Range<InputIt2>& s2, size_t max)
 {
+    RAPIDFUZZ_STATS_CALL(OSAHyrroe2003, s2.size());
     /* VP is set to 1^m. Shifting by bitwidth would be undefined behavior */
     uint64_t VP = ~UINT64_C(0);
     uint64_t VN = 0;
@@ -74,107 +75,47 @@ size_t osa_hyrroe2003(const PM_Vec& PM, const Range<InputIt1>& s1, const Range<I
 }
 
 #ifdef RAPIDFUZZ_SIMD
+#    if defined(RAPIDFUZZ_AVX512)
+#        define RAPIDFUZZ_SIMD_ISA_AVX512
+#    elif defined(RAPIDFUZZ_AVX2)
+#        define RAPIDFUZZ_SIMD_ISA_AVX2
+#    endif
+#    include <rapidfuzz/distance/OSA_simd.impl>
+#    undef RAPIDFUZZ_SIMD_ISA_AVX512
+#    undef RAPIDFUZZ_SIMD_ISA_AVX2
+
+#    ifdef RAPIDFUZZ_AVX2_DISPATCH
+#        define RAPIDFUZZ_SIMD_ISA_AVX2
+RAPIDFUZZ_AVX2_TARGET_BEGIN
+#        include <rapidfuzz/distance/OSA_simd.impl>
+RAPIDFUZZ_AVX2_TARGET_END
+#        undef RAPIDFUZZ_SIMD_ISA_AVX2
+#    endif
+
 template <typename VecType, typename InputIt, int _lto_hack = RAPIDFUZZ_LTO_HACK>
 void osa_hyrroe2003_simd(Range<size_t*> scores, const detail::BlockPatternMatchVector& block,
                          const std::vector<size_t>& s1_lengths, const Range<InputIt>& s2,
                          size_t score_cutoff) noexcept
 {
-#    ifdef RAPIDFUZZ_AVX2
-    using namespace simd_avx2;
-#    else
-    using namespace simd_sse2;
+    RAPIDFUZZ_STATS_CALL(OSASimd, block.size() * s2.size());
+#    ifdef RAPIDFUZZ_AVX2_DISPATCH
+    if (cpu_supports_avx2())
+        return avx2::osa_hyrroe2003_simd<VecType>(scores, block, s1_lengths, s2, score_cutoff);
 #    endif
-    static constexpr size_t alignment = native_simd<VecType>::alignment;
-    static constexpr size_t vec_width = native_simd<VecType>::size;
-    static constexpr size_t vecs = native_simd<uint64_t>::size;
-    assert(block.size() % vecs == 0);
-
-    native_simd<VecType> zero(VecType(0));
-    native_simd<VecType> one(1);
-    size_t result_index = 0;
-
-    for (size_t cur_vec = 0; cur_vec < block.size(); cur_vec += vecs) {
-        /* VP is set to 1^m */
-        native_simd<VecType> VP(static_cast<VecType>(-1));
-        native_simd<VecType> VN(VecType(0));
-        native_simd<VecType> D0(VecType(0));
-        native_simd<VecType> PM_j_old(VecType(0));
-
-        alignas(alignment) std::array<VecType, vec_width> currDist_;
-        unroll<size_t, vec_width>(
-            [&](size_t i) { currDist_[i] = static_cast<VecType>(s1_lengths[result_index + i]); });
-        native_simd<VecType> currDist(reinterpret_cast<uint64_t*>(currDist_.data()));
-        /* mask used when computing D[m,j] in the paper 10^(m-1) */
-        alignas(alignment) std::array<VecType, vec_width> mask_;
-        unroll<size_t, vec_width>([&](size_t i) {
-            if (s1_lengths[result_index + i] == 0)
-                mask_[i] = 0;
-            else
-                mask_[i] = static_cast<VecType>(UINT64_C(1) << (s1_lengths[result_index + i] - 1));
-        });
-        native_simd<VecType> mask(reinterpret_cast<uint64_t*>(mask_.data()));
-
-        for (const auto& ch : s2) {
-            /* Step 1: Computing D0 */
-            alignas(alignment) std::array<uint64_t, vecs> stored;
-            unroll<size_t, vecs>([&](size_t i) { stored[i] = block.get(cur_vec + i, ch); });
-
-            native_simd<VecType> PM_j(stored.data());
-            auto TR = (andnot(PM_j, D0) << 1) & PM_j_old;
-            D0 = (((PM_j & VP) + VP) ^ VP) | PM_j | VN;
-            D0 = D0 | TR;
-
-            /* Step 2: Computing HP and HN */
-            auto HP = VN | ~(D0 | VP);
-            auto HN = D0 & VP;
-
-            /* Step 3: Computing the value D[m,j] */
-            currDist += andnot(one, (HP & mask) == zero);
-            currDist -= andnot(one, (HN & mask) == zero);
-
-            /* Step 4: Computing Vp and VN */
-            HP = (HP << 1) | one;
-            HN = (HN << 1);
-
-            VP = HN | ~(D0 | HP);
-            VN = HP & D0;
-            PM_j_old = PM_j;
-        }
-
-        alignas(alignment) std::array<VecType, vec_width> distances;
-        currDist.store(distances.data());
-
-        unroll<size_t, vec_width>([&](size_t i) {
-            size_t score = 0;
-            /* strings of length 0 are not handled correctly */
-            if (s1_lengths[result_index] == 0) {
-                score = s2.size();
-            }
-            /* calculate score under consideration of wraparounds in parallel counter */
-            else {
-                RAPIDFUZZ_IF_CONSTEXPR (std::numeric_limits<VecType>::max() <
-                                        std::numeric_limits<size_t>::max())
-                {
-                    size_t min_dist = abs_diff(s1_lengths[result_index], s2.size());
-                    size_t wraparound_score = static_cast<size_t>(std::numeric_limits<VecType>::max()) + 1;
-
-                    score = (min_dist / wraparound_score) * wraparound_score;
-                    VecType remainder = static_cast<VecType>(min_dist % wraparound_score);
 
-                    if (distances[i] < remainder) score += wraparound_score;
-                }
-
-                score += distances[i];
-            }
-            scores[result_index] = (score <= score_cutoff) ? score : score_cutoff + 1;
-            result_index++;
-        });
-    }
+#    if defined(RAPIDFUZZ_AVX512)
+    avx512::osa_hyrroe2003_simd<VecType>(scores, block, s1_lengths, s2, score_cutoff);
+#    elif defined(RAPIDFUZZ_AVX2)
+    avx2::osa_hyrroe2003_simd<VecType>(scores, block, s1_lengths, s2, score_cutoff);
+#    else
+    sse2::osa_hyrroe2003_simd<VecType>(scores, block, s1_lengths, s2, score_cutoff);
+#    endif
 }
+
 #endif
 
-template <typename InputIt1, typename InputIt2>
-size_t osa_hyrroe2003_block(const BlockPatternMatchVector& PM, const Range<InputIt1>& s1,
+template <typename PM_Vec, typename InputIt1, typename InputIt2>
+size_t osa_hyrroe2003_block(const PM_Vec& PM, const Range<InputIt1>& s1,
                             const Range<InputIt2>& s2, size_t max = std::numeric_limits<size_t>::max())
 {
     struct Row {
@@ -190,10 +131,12 @@ size_t osa_hyrroe2003_block(const BlockPatternMatchVector& PM, const Range<Input
     size_t word_size = sizeof(uint64_t) * 8;
     size_t words = PM.size();
     uint64_t Last = UINT64_C(1) << ((s1.size() - 1) % word_size);
+    RAPIDFUZZ_STATS_CALL(OSABlock, words * s2.size());
 
     size_t currDist = s1.size();
-    std::vector<Row> old_vecs(words + 1);
-    std::vector<Row> new_vecs(words + 1);
+    ScratchFrame frame;
+    ScratchVector<Row> old_vecs(words + 1);
+    ScratchVector<Row> new_vecs(words + 1);
 
     /* Searching */
     auto iter_s2 = s2.begin();
@@ -264,12 +207,16 @@ class OSA : public DistanceBase<OSA, size_t, 0, std::numeric_limits<int64_t>::ma
         if (s2.size() < s1.size()) return _distance(s2, s1, score_cutoff, score_hint);
 
         remove_common_affix(s1, s2);
-        if (s1.empty())
+        if (s1.empty()) {
+            RAPIDFUZZ_STATS_CALL(OSAFilter, 0);
             return (s2.size() <= score_cutoff) ? s2.size() : score_cutoff + 1;
+        }
         else if (s1.size() < 64)
             return osa_hyrroe2003(PatternMatchVector(s1), s1, s2, score_cutoff);
-        else
-            return osa_hyrroe2003_block(BlockPatternMatchVector(s1), s1, s2, score_cutoff);
+        else {
+            ScratchFrame frame;
+            return osa_hyrroe2003_block(BlockPatternMatchVector::scratch(s1), s1, s2, score_cutoff);
+        }
     }
 };
 
@@ -23,6 +23,7 @@ class Postfix : public SimilarityBase<Postfix, size_t, 0, std::numeric_limits<in
     static size_t _similarity(Range<InputIt1> s1, Range<InputIt2> s2, size_t score_cutoff, size_t)
     {
         size_t dist = remove_common_suffix(s1, s2);
+        RAPIDFUZZ_STATS_CALL(Postfix, dist);
         return (dist >= score_cutoff) ? dist : 0;
     }
 };
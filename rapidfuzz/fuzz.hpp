@@ -7,6 +7,7 @@
 #include <rapidfuzz/details/PatternMatchVector.hpp>
 #include <rapidfuzz/details/common.hpp>
 #include <rapidfuzz/distance/Indel.hpp>
+#include <rapidfuzz/distance/LCSseq.hpp>
 
 namespace rapidfuzz {
 namespace fuzz {
@@ -113,6 +114,15 @@ struct CachedRatio {
     template <typename Sentence2>
     double similarity(const Sentence2& s2, double score_cutoff = 0.0, double score_hint = 0.0) const;
 
+    /**
+     * @brief stores the precomputed bitvectors of s1 in a compact layout
+     * (see CachedLevenshtein::shrink_to_fit)
+     */
+    void shrink_to_fit()
+    {
+        cached_indel.shrink_to_fit();
+    }
+
     // private:
     CachedIndel<CharT1> cached_indel;
 };
@@ -165,6 +175,74 @@ template <typename InputIt1, typename InputIt2>
 double partial_ratio(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
                      double score_cutoff = 0);
 
+#ifdef RAPIDFUZZ_SIMD
+namespace fuzz_detail {
+/* The Multi* scorers below keep a copy of the inserted strings for the scorers without a SIMD
+ * implementation */
+template <typename Container = std::vector<uint64_t>, typename InputIt>
+Container multi_copy(InputIt first, InputIt last)
+{
+    Container res;
+    for (; first != last; ++first)
+        res.push_back(detail::multi_char(*first));
+
+    return res;
+}
+} // namespace fuzz_detail
+
+namespace experimental {
+/**
+ * @brief partial_ratio between s2 and multiple strings
+ *
+ * The LCS of s2 with all strings is calculated in parallel. It bounds the ratio of the best alignment,
+ * so only strings which can still reach score_cutoff are aligned with partial_ratio.
+ */
+template <int MaxLen>
+struct MultiPartialRatio {
+public:
+    MultiPartialRatio(size_t count) : input_count(count), scorer(count)
+    {
+        strings.reserve(count);
+    }
+
+    size_t result_count() const
+    {
+        return scorer.result_count();
+    }
+
+    template <typename Sentence1>
+    void insert(const Sentence1& s1_)
+    {
+        insert(detail::to_begin(s1_), detail::to_end(s1_));
+    }
+
+    template <typename InputIt1>
+    void insert(InputIt1 first1, InputIt1 last1)
+    {
+        if (strings.size() >= input_count) throw std::invalid_argument("out of bounds insert");
+
+        strings.push_back(fuzz_detail::multi_copy(first1, last1));
+        scorer.insert(strings.back());
+    }
+
+    template <typename InputIt2>
+    void similarity(double* scores, size_t score_count, InputIt2 first2, InputIt2 last2,
+                    double score_cutoff = 0.0) const
+    {
+        similarity(scores, score_count, detail::make_range(first2, last2), score_cutoff);
+    }
+
+    template <typename Sentence2>
+    void similarity(double* scores, size_t score_count, const Sentence2& s2, double score_cutoff = 0) const;
+
+private:
+    size_t input_count;
+    std::vector<std::vector<uint64_t>> strings;
+    rapidfuzz::experimental::MultiLCSseq<MaxLen> scorer;
+};
+} /* namespace experimental */
+#endif
+
 // todo add real implementation
 template <typename CharT1>
 struct CachedPartialRatio {
@@ -262,6 +340,7 @@ public:
     void similarity(double* scores, size_t score_count, InputIt2 first2, InputIt2 last2,
                     double score_cutoff = 0.0) const
     {
+        detail::ScratchFrame frame;
         scorer.similarity(scores, score_count, detail::sorted_split(first2, last2).join(), score_cutoff);
     }
 
@@ -283,7 +362,8 @@ template <typename CharT1>
 struct CachedTokenSortRatio {
     template <typename InputIt1>
     CachedTokenSortRatio(InputIt1 first1, InputIt1 last1)
-        : s1_sorted(detail::sorted_split(first1, last1).join()), cached_ratio(s1_sorted)
+        : s1_sorted(detail::sorted_split(first1, last1).template join<std::vector<CharT1>>()),
+          cached_ratio(s1_sorted)
     {}
 
     template <typename Sentence1>
@@ -343,7 +423,8 @@ template <typename CharT1>
 struct CachedPartialTokenSortRatio {
     template <typename InputIt1>
     CachedPartialTokenSortRatio(InputIt1 first1, InputIt1 last1)
-        : s1_sorted(detail::sorted_split(first1, last1).join()), cached_partial_ratio(s1_sorted)
+        : s1_sorted(detail::sorted_split(first1, last1).template join<std::vector<CharT1>>()),
+          cached_partial_ratio(s1_sorted)
     {}
 
     template <typename Sentence1>
@@ -408,6 +489,73 @@ template <typename InputIt1, typename InputIt2>
 double token_set_ratio(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
                        double score_cutoff = 0);
 
+#ifdef RAPIDFUZZ_SIMD
+namespace experimental {
+/**
+ * @brief token_set_ratio between s2 and multiple strings
+ *
+ * Without shared words token_set_ratio is based on the Indel distance of the sorted and deduplicated
+ * words, which is calculated for all strings in parallel. Only strings sharing words with s2 are
+ * scored separately.
+ */
+template <int MaxLen>
+struct MultiTokenSetRatio {
+public:
+    MultiTokenSetRatio(size_t count) : input_count(count), scorer(count)
+    {
+        strings.reserve(count);
+        tokens.reserve(count);
+    }
+
+    /* tokens points into strings, so a copy would point into the buffers of the source.
+     * Moving keeps the buffers in place */
+    MultiTokenSetRatio(const MultiTokenSetRatio&) = delete;
+    MultiTokenSetRatio& operator=(const MultiTokenSetRatio&) = delete;
+    MultiTokenSetRatio(MultiTokenSetRatio&&) = default;
+    MultiTokenSetRatio& operator=(MultiTokenSetRatio&&) = default;
+
+    size_t result_count() const
+    {
+        return scorer.result_count();
+    }
+
+    template <typename Sentence1>
+    void insert(const Sentence1& s1_)
+    {
+        insert(detail::to_begin(s1_), detail::to_end(s1_));
+    }
+
+    template <typename InputIt1>
+    void insert(InputIt1 first1, InputIt1 last1)
+    {
+        if (strings.size() >= input_count) throw std::invalid_argument("out of bounds insert");
+
+        strings.push_back(fuzz_detail::multi_copy(first1, last1));
+        const auto& s1 = strings.back();
+        tokens.push_back(detail::sorted_split(s1.begin(), s1.end()));
+        tokens.back().dedupe();
+        scorer.insert(tokens.back().join());
+    }
+
+    template <typename InputIt2>
+    void similarity(double* scores, size_t score_count, InputIt2 first2, InputIt2 last2,
+                    double score_cutoff = 0.0) const
+    {
+        similarity(scores, score_count, detail::make_range(first2, last2), score_cutoff);
+    }
+
+    template <typename Sentence2>
+    void similarity(double* scores, size_t score_count, const Sentence2& s2, double score_cutoff = 0) const;
+
+private:
+    size_t input_count;
+    std::vector<std::vector<uint64_t>> strings;
+    std::vector<detail::SplittedSentenceView<std::vector<uint64_t>::const_iterator>> tokens;
+    rapidfuzz::experimental::MultiIndel<MaxLen> scorer;
+};
+} /* namespace experimental */
+#endif
+
 // TODO documentation
 template <typename CharT1>
 struct CachedTokenSetRatio {
@@ -533,7 +681,7 @@ struct CachedTokenRatio {
     CachedTokenRatio(InputIt1 first1, InputIt1 last1)
         : s1(first1, last1),
           s1_tokens(detail::sorted_split(std::begin(s1), std::end(s1))),
-          s1_sorted(s1_tokens.join()),
+          s1_sorted(s1_tokens.template join<std::vector<CharT1>>()),
           cached_ratio_s1_sorted(s1_sorted)
     {}
 
@@ -598,7 +746,7 @@ struct CachedPartialTokenRatio {
     CachedPartialTokenRatio(InputIt1 first1, InputIt1 last1)
         : s1(first1, last1),
           tokens_s1(detail::sorted_split(std::begin(s1), std::end(s1))),
-          s1_sorted(tokens_s1.join())
+          cached_partial_ratio_s1_sorted(tokens_s1.join())
     {}
 
     template <typename Sentence1>
@@ -616,7 +764,7 @@ struct CachedPartialTokenRatio {
 private:
     std::vector<CharT1> s1;
     detail::SplittedSentenceView<typename std::vector<CharT1>::iterator> tokens_s1;
-    std::vector<CharT1> s1_sorted;
+    CachedPartialRatio<CharT1> cached_partial_ratio_s1_sorted;
 };
 
 #ifdef RAPIDFUZZ_DEDUCTION_GUIDES
@@ -654,7 +802,60 @@ double WRatio(const Sentence1& s1, const Sentence2& s2, double score_cutoff = 0)
 template <typename InputIt1, typename InputIt2>
 double WRatio(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, double score_cutoff = 0);
 
-// todo add real implementation
+#ifdef RAPIDFUZZ_SIMD
+namespace experimental {
+/**
+ * @brief WRatio between s2 and multiple strings
+ *
+ * The ratio is calculated for all strings in parallel. The token and partial ratios are scaled down
+ * by WRatio, so they are only calculated for strings where they can still improve the result.
+ */
+template <int MaxLen>
+struct MultiWRatio {
+public:
+    MultiWRatio(size_t count) : input_count(count), scorer(count)
+    {
+        strings.reserve(count);
+    }
+
+    size_t result_count() const
+    {
+        return scorer.result_count();
+    }
+
+    template <typename Sentence1>
+    void insert(const Sentence1& s1_)
+    {
+        insert(detail::to_begin(s1_), detail::to_end(s1_));
+    }
+
+    template <typename InputIt1>
+    void insert(InputIt1 first1, InputIt1 last1)
+    {
+        if (strings.size() >= input_count) throw std::invalid_argument("out of bounds insert");
+
+        strings.push_back(fuzz_detail::multi_copy(first1, last1));
+        scorer.insert(strings.back());
+    }
+
+    template <typename InputIt2>
+    void similarity(double* scores, size_t score_count, InputIt2 first2, InputIt2 last2,
+                    double score_cutoff = 0.0) const
+    {
+        similarity(scores, score_count, detail::make_range(first2, last2), score_cutoff);
+    }
+
+    template <typename Sentence2>
+    void similarity(double* scores, size_t score_count, const Sentence2& s2, double score_cutoff = 0) const;
+
+private:
+    size_t input_count;
+    std::vector<std::vector<uint64_t>> strings;
+    MultiRatio<MaxLen> scorer;
+};
+} /* namespace experimental */
+#endif
+
 template <typename CharT1>
 struct CachedWRatio {
     template <typename InputIt1>
@@ -672,13 +873,12 @@ struct CachedWRatio {
     double similarity(const Sentence2& s2, double score_cutoff = 0.0, double score_hint = 0.0) const;
 
 private:
-    // todo somehow implement this using other ratios with creating PatternMatchVector
-    // multiple times
     std::vector<CharT1> s1;
     CachedPartialRatio<CharT1> cached_partial_ratio;
     detail::SplittedSentenceView<typename std::vector<CharT1>::iterator> tokens_s1;
-    std::vector<CharT1> s1_sorted;
-    rapidfuzz::detail::BlockPatternMatchVector blockmap_s1_sorted;
+    /* used by token_ratio and partial_token_ratio. The ratio of the sorted tokens
+     * reuses the pattern match vector of the partial ratio */
+    CachedPartialRatio<CharT1> cached_partial_ratio_s1_sorted;
 };
 
 #ifdef RAPIDFUZZ_DEDUCTION_GUIDES
@@ -790,6 +990,15 @@ struct CachedQRatio {
     template <typename Sentence2>
     double similarity(const Sentence2& s2, double score_cutoff = 0.0, double score_hint = 0.0) const;
 
+    /**
+     * @brief stores the precomputed bitvectors of s1 in a compact layout
+     * (see CachedLevenshtein::shrink_to_fit)
+     */
+    void shrink_to_fit()
+    {
+        cached_ratio.shrink_to_fit();
+    }
+
 private:
     std::vector<CharT1> s1;
     CachedRatio<CharT1> cached_ratio;
@@ -28,6 +28,7 @@ double ratio(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, d
 template <typename Sentence1, typename Sentence2>
 double ratio(const Sentence1& s1, const Sentence2& s2, const double score_cutoff)
 {
+    RAPIDFUZZ_STATS_CALL(FuzzRatio, 0);
     return indel_normalized_similarity(s1, s2, score_cutoff / 100) * 100;
 }
 
@@ -43,6 +44,7 @@ template <typename CharT1>
 template <typename Sentence2>
 double CachedRatio<CharT1>::similarity(const Sentence2& s2, double score_cutoff, double score_hint) const
 {
+    RAPIDFUZZ_STATS_CALL(FuzzRatio, 0);
     return cached_indel.normalized_similarity(s2, score_cutoff / 100, score_hint / 100) * 100;
 }
 
@@ -65,12 +67,47 @@ static inline size_t score_cutoff_to_distance(double score_cutoff, size_t lensum
     return static_cast<size_t>(std::ceil(static_cast<double>(lensum) * (1.0 - score_cutoff / 100)));
 }
 
-template <typename InputIt1, typename InputIt2, typename CachedCharT1>
+/**
+ * Replaces CachedRatio for the temporary scorers of partial_ratio. The bitvectors of s1 are taken
+ * from the bound Workspace, so it must not outlive the current ScratchFrame
+ */
+template <typename InputIt1>
+struct ScratchRatio {
+    explicit ScratchRatio(const detail::Range<InputIt1>& s1_)
+        : s1(s1_), PM(detail::BlockPatternMatchVector::scratch(s1_))
+    {}
+
+    template <typename Sentence2>
+    double similarity(const Sentence2& s2, double score_cutoff) const
+    {
+        RAPIDFUZZ_STATS_CALL(FuzzRatio, 0);
+        return detail::indel_normalized_similarity(PM, s1, detail::make_range(s2), score_cutoff / 100) * 100;
+    }
+
+    detail::Range<InputIt1> s1;
+    detail::BlockPatternMatchVector PM;
+};
+
+template <typename CharT1, typename InputIt2>
+size_t ratio_indel_distance(const CachedRatio<CharT1>& scorer, const detail::Range<InputIt2>& s2, size_t max)
+{
+    return scorer.cached_indel.distance(s2, max);
+}
+
+template <typename InputIt1, typename InputIt2>
+size_t ratio_indel_distance(const ScratchRatio<InputIt1>& scorer, const detail::Range<InputIt2>& s2,
+                            size_t max)
+{
+    return detail::indel_distance(scorer.PM, scorer.s1, s2, max);
+}
+
+template <typename InputIt1, typename InputIt2, typename RatioScorer>
 ScoreAlignment<double>
 partial_ratio_impl(const detail::Range<InputIt1>& s1, const detail::Range<InputIt2>& s2,
-                   const CachedRatio<CachedCharT1>& cached_ratio,
+                   const RatioScorer& cached_ratio,
                    const detail::CharSet<iter_value_t<InputIt1>>& s1_char_set, double score_cutoff)
 {
+    detail::ScratchFrame frame;
     ScoreAlignment<double> res;
     size_t len1 = s1.size();
     size_t len2 = s2.size();
@@ -84,54 +121,71 @@ partial_ratio_impl(const detail::Range<InputIt1>& s1, const detail::Range<InputI
         double norm_cutoff_sim = rapidfuzz::detail::NormSim_to_NormDist(score_cutoff / 100);
         size_t cutoff_dist = static_cast<size_t>(std::ceil(static_cast<double>(maximum) * norm_cutoff_sim));
         size_t best_dist = std::numeric_limits<size_t>::max();
-        std::vector<size_t> scores(len2 - len1, std::numeric_limits<size_t>::max());
-        std::vector<std::pair<size_t, size_t>> windows = {{0, len2 - len1 - 1}};
-        std::vector<std::pair<size_t, size_t>> new_windows;
+        detail::ScratchVector<size_t> scores(len2 - len1, std::numeric_limits<size_t>::max());
+        detail::ScratchVector<std::pair<size_t, size_t>> windows = {{0, len2 - len1 - 1}};
+        detail::ScratchVector<std::pair<size_t, size_t>> new_windows;
+
+        /* Windows are only used to improve the result or to prune ranges of at most span windows
+         * next to them. A window with a distance above cutoff_dist + 2 * span can do neither, since the
+         * distance of neighbouring windows differs by at most 2. So the exact distance is not needed
+         * and the calculation can stop early. The distance between strings of the same length is
+         * always even, so the lower bound is rounded up to the next even number */
+        auto window_dist = [&](size_t pos, size_t span) {
+            size_t max = cutoff_dist + 2 * span;
+            RAPIDFUZZ_STATS_WORDS(FuzzPartialRatio, 1);
+            auto subseq_first = s2.begin() + static_cast<ptrdiff_t>(pos);
+            auto subseq = detail::make_range(subseq_first, subseq_first + static_cast<ptrdiff_t>(len1));
+            size_t dist = ratio_indel_distance(cached_ratio, subseq, max);
+            return (dist > max) ? (max + 2) / 2 * 2 : dist;
+        };
 
         while (!windows.empty()) {
             for (const auto& window : windows) {
-                auto subseq1_first = s2.begin() + static_cast<ptrdiff_t>(window.first);
-                auto subseq2_first = s2.begin() + static_cast<ptrdiff_t>(window.second);
-                auto subseq1 =
-                    detail::make_range(subseq1_first, subseq1_first + static_cast<ptrdiff_t>(len1));
-                auto subseq2 =
-                    detail::make_range(subseq2_first, subseq2_first + static_cast<ptrdiff_t>(len1));
-
+                size_t cell_diff = window.second - window.first;
                 if (scores[window.first] == std::numeric_limits<size_t>::max()) {
-                    scores[window.first] = cached_ratio.cached_indel.distance(subseq1);
+                    scores[window.first] = window_dist(window.first, cell_diff);
                     if (scores[window.first] < cutoff_dist) {
                         cutoff_dist = best_dist = scores[window.first];
                         res.dest_start = window.first;
                         res.dest_end = window.first + len1;
                         if (best_dist == 0) {
+                            RAPIDFUZZ_STATS_EARLY_EXIT(FuzzPartialRatio);
                             res.score = 100;
                             return res;
                         }
                     }
                 }
                 if (scores[window.second] == std::numeric_limits<size_t>::max()) {
-                    scores[window.second] = cached_ratio.cached_indel.distance(subseq2);
+                    scores[window.second] = window_dist(window.second, cell_diff);
                     if (scores[window.second] < cutoff_dist) {
                         cutoff_dist = best_dist = scores[window.second];
                         res.dest_start = window.second;
                         res.dest_end = window.second + len1;
                         if (best_dist == 0) {
+                            RAPIDFUZZ_STATS_EARLY_EXIT(FuzzPartialRatio);
                             res.score = 100;
                             return res;
                         }
                     }
                 }
 
-                size_t cell_diff = window.second - window.first;
                 if (cell_diff == 1) continue;
 
                 /* find the minimum score possible in the range first <-> last */
                 size_t known_edits = detail::abs_diff(scores[window.first], scores[window.second]);
-                /* half of the cells that are not needed for known_edits can lead to a better score */
-                size_t max_score_improvement = (cell_diff - known_edits / 2) / 2 * 2;
-                ptrdiff_t min_score =
-                    static_cast<ptrdiff_t>(std::min(scores[window.first], scores[window.second])) -
-                    static_cast<ptrdiff_t>(max_score_improvement);
+                ptrdiff_t min_score;
+                /* only possible when one of the scores is a lower bound */
+                if (known_edits >= 2 * cell_diff) {
+                    size_t max_known = std::max(scores[window.first], scores[window.second]);
+                    min_score = static_cast<ptrdiff_t>(max_known) - static_cast<ptrdiff_t>(2 * cell_diff);
+                }
+                else {
+                    /* half of the cells that are not needed for known_edits can lead to a better score */
+                    size_t max_score_improvement = (cell_diff - known_edits / 2) / 2 * 2;
+                    size_t min_known = std::min(scores[window.first], scores[window.second]);
+                    min_score =
+                        static_cast<ptrdiff_t>(min_known) - static_cast<ptrdiff_t>(max_score_improvement);
+                }
                 if (min_score < static_cast<ptrdiff_t>(cutoff_dist)) {
                     size_t center = cell_diff / 2;
                     new_windows.emplace_back(window.first, window.first + center);
@@ -152,6 +206,7 @@ partial_ratio_impl(const detail::Range<InputIt1>& s1, const detail::Range<InputI
         auto subseq = rapidfuzz::detail::make_range(s2.begin(), s2.begin() + static_cast<ptrdiff_t>(i));
         if (!s1_char_set.find(subseq.back())) continue;
 
+        RAPIDFUZZ_STATS_WORDS(FuzzPartialRatio, 1);
         double ls_ratio = cached_ratio.similarity(subseq, score_cutoff);
         if (ls_ratio > res.score) {
             score_cutoff = res.score = ls_ratio;
@@ -165,6 +220,7 @@ partial_ratio_impl(const detail::Range<InputIt1>& s1, const detail::Range<InputI
         auto subseq = rapidfuzz::detail::make_range(s2.begin() + static_cast<ptrdiff_t>(i), s2.end());
         if (!s1_char_set.find(subseq.front())) continue;
 
+        RAPIDFUZZ_STATS_WORDS(FuzzPartialRatio, 1);
         double ls_ratio = cached_ratio.similarity(subseq, score_cutoff);
         if (ls_ratio > res.score) {
             score_cutoff = res.score = ls_ratio;
@@ -181,15 +237,65 @@ template <typename InputIt1, typename InputIt2, typename CharT1 = iter_value_t<I
 ScoreAlignment<double> partial_ratio_impl(const detail::Range<InputIt1>& s1,
                                           const detail::Range<InputIt2>& s2, double score_cutoff)
 {
-    CachedRatio<CharT1> cached_ratio(s1);
+    detail::ScratchFrame frame;
+    ScratchRatio<InputIt1> scratch_ratio(s1);
 
     detail::CharSet<CharT1> s1_char_set;
     for (auto ch : s1)
         s1_char_set.insert(ch);
 
-    return partial_ratio_impl(s1, s2, cached_ratio, s1_char_set, score_cutoff);
+    return partial_ratio_impl(s1, s2, scratch_ratio, s1_char_set, score_cutoff);
 }
 
+/* partial_ratio using the preprocessed s1 of a cached scorer */
+template <typename InputIt1, typename InputIt2, typename RatioScorer>
+double cached_partial_ratio(const detail::Range<InputIt1>& s1, const detail::Range<InputIt2>& s2,
+                            const RatioScorer& cached_ratio,
+                            const detail::CharSet<iter_value_t<InputIt1>>& s1_char_set, double score_cutoff)
+{
+    size_t len1 = s1.size();
+    size_t len2 = s2.size();
+
+    if (len1 > len2) return partial_ratio(s1.begin(), s1.end(), s2.begin(), s2.end(), score_cutoff);
+
+    RAPIDFUZZ_STATS_CALL(FuzzPartialRatio, 0);
+    if (score_cutoff > 100) return 0;
+
+    if (!len1 || !len2) return static_cast<double>(len1 == len2) * 100.0;
+
+    double score = partial_ratio_impl(s1, s2, cached_ratio, s1_char_set, score_cutoff).score;
+    if (score != 100 && len1 == len2) {
+        score_cutoff = std::max(score_cutoff, score);
+        double score2 = partial_ratio_impl(s2, s1, score_cutoff).score;
+        if (score2 > score) return score2;
+    }
+
+    return score;
+}
+
+/**
+ * Replaces CachedPartialRatio for the temporary scorers of the Multi* scorers. It must not outlive the
+ * current ScratchFrame
+ */
+template <typename InputIt1>
+struct ScratchPartialRatio {
+    explicit ScratchPartialRatio(const detail::Range<InputIt1>& s1_) : s1(s1_), cached_ratio(s1_)
+    {
+        for (const auto& ch : s1)
+            s1_char_set.insert(ch);
+    }
+
+    template <typename Sentence2>
+    double similarity(const Sentence2& s2, double score_cutoff) const
+    {
+        return cached_partial_ratio(s1, detail::make_range(s2), cached_ratio, s1_char_set, score_cutoff);
+    }
+
+    detail::Range<InputIt1> s1;
+    detail::CharSet<iter_value_t<InputIt1>> s1_char_set;
+    ScratchRatio<InputIt1> cached_ratio;
+};
+
 } // namespace fuzz_detail
 
 template <typename InputIt1, typename InputIt2>
@@ -206,6 +312,7 @@ ScoreAlignment<double> partial_ratio_alignment(InputIt1 first1, InputIt1 last1,
         return result;
     }
 
+    RAPIDFUZZ_STATS_CALL(FuzzPartialRatio, 0);
     if (score_cutoff > 100) return ScoreAlignment<double>(0, 0, len1, 0, len1);
 
     if (!len1 || !len2)
@@ -261,27 +368,8 @@ template <typename InputIt2>
 double CachedPartialRatio<CharT1>::similarity(InputIt2 first2, InputIt2 last2, double score_cutoff,
                                               double) const
 {
-    size_t len1 = s1.size();
-    size_t len2 = static_cast<size_t>(std::distance(first2, last2));
-
-    if (len1 > len2)
-        return partial_ratio(detail::to_begin(s1), detail::to_end(s1), first2, last2, score_cutoff);
-
-    if (score_cutoff > 100) return 0;
-
-    if (!len1 || !len2) return static_cast<double>(len1 == len2) * 100.0;
-
-    auto s1_ = detail::make_range(s1);
-    auto s2 = detail::make_range(first2, last2);
-
-    double score = fuzz_detail::partial_ratio_impl(s1_, s2, cached_ratio, s1_char_set, score_cutoff).score;
-    if (score != 100 && s1_.size() == s2.size()) {
-        score_cutoff = std::max(score_cutoff, score);
-        double score2 = fuzz_detail::partial_ratio_impl(s2, s1_, score_cutoff).score;
-        if (score2 > score) return score2;
-    }
-
-    return score;
+    return fuzz_detail::cached_partial_ratio(detail::make_range(s1), detail::make_range(first2, last2),
+                                             cached_ratio, s1_char_set, score_cutoff);
 }
 
 template <typename CharT1>
@@ -291,12 +379,55 @@ double CachedPartialRatio<CharT1>::similarity(const Sentence2& s2, double score_
     return similarity(detail::to_begin(s2), detail::to_end(s2), score_cutoff);
 }
 
+#ifdef RAPIDFUZZ_SIMD
+namespace experimental {
+template <int MaxLen>
+template <typename Sentence2>
+void MultiPartialRatio<MaxLen>::similarity(double* scores, size_t score_count, const Sentence2& s2,
+                                           double score_cutoff) const
+{
+    detail::ScratchFrame frame;
+    if (score_count < result_count())
+        throw std::invalid_argument("scores has to have >= result_count() elements");
+
+    auto s2_ = detail::make_range(s2);
+    auto s2_copy = fuzz_detail::multi_copy<detail::ScratchVector<uint64_t>>(s2_.begin(), s2_.end());
+
+    detail::ScratchVector<size_t> lcs(result_count());
+    scorer.similarity(lcs.data(), lcs.size(), s2_copy);
+
+    /* partial_ratio is symmetric, so s2 can be preprocessed once for all alignments */
+    auto s2_range = detail::make_range(s2_copy);
+    fuzz_detail::ScratchPartialRatio<decltype(s2_range.begin())> cached_partial_ratio(s2_range);
+
+    for (size_t i = 0; i < input_count; ++i) {
+        size_t min_len = std::min(strings[i].size(), s2_copy.size());
+        if (min_len) {
+            /* an alignment shares at most lcs[i] characters with the shorter string and its best
+             * ratio is reached when it has no other characters. The small tolerance keeps scores
+             * rounding to score_cutoff */
+            double max_score =
+                100.0 * static_cast<double>(2 * lcs[i]) / static_cast<double>(min_len + lcs[i]);
+            if (!lcs[i] || max_score + 1e-9 < score_cutoff) {
+                scores[i] = 0;
+                continue;
+            }
+        }
+
+        scores[i] = cached_partial_ratio.similarity(strings[i], score_cutoff);
+    }
+}
+} /* namespace experimental */
+#endif
+
 /**********************************************
  *             token_sort_ratio
  *********************************************/
 template <typename InputIt1, typename InputIt2>
 double token_sort_ratio(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, double score_cutoff)
 {
+    RAPIDFUZZ_STATS_CALL(FuzzTokenSortRatio, 0);
+    detail::ScratchFrame frame;
     if (score_cutoff > 100) return 0;
 
     return ratio(detail::sorted_split(first1, last1).join(), detail::sorted_split(first2, last2).join(),
@@ -315,6 +446,8 @@ template <typename InputIt2>
 double CachedTokenSortRatio<CharT1>::similarity(InputIt2 first2, InputIt2 last2, double score_cutoff,
                                                 double) const
 {
+    RAPIDFUZZ_STATS_CALL(FuzzTokenSortRatio, 0);
+    detail::ScratchFrame frame;
     if (score_cutoff > 100) return 0;
 
     return cached_ratio.similarity(detail::sorted_split(first2, last2).join(), score_cutoff);
@@ -335,6 +468,8 @@ template <typename InputIt1, typename InputIt2>
 double partial_token_sort_ratio(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
                                 double score_cutoff)
 {
+    RAPIDFUZZ_STATS_CALL(FuzzPartialTokenSortRatio, 0);
+    detail::ScratchFrame frame;
     if (score_cutoff > 100) return 0;
 
     return partial_ratio(detail::sorted_split(first1, last1).join(),
@@ -353,6 +488,8 @@ template <typename InputIt2>
 double CachedPartialTokenSortRatio<CharT1>::similarity(InputIt2 first2, InputIt2 last2, double score_cutoff,
                                                        double) const
 {
+    RAPIDFUZZ_STATS_CALL(FuzzPartialTokenSortRatio, 0);
+    detail::ScratchFrame frame;
     if (score_cutoff > 100) return 0;
 
     return cached_partial_ratio.similarity(detail::sorted_split(first2, last2).join(), score_cutoff);
@@ -423,6 +560,8 @@ double token_set_ratio(const rapidfuzz::detail::SplittedSentenceView<InputIt1>&
 template <typename InputIt1, typename InputIt2>
 double token_set_ratio(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, double score_cutoff)
 {
+    RAPIDFUZZ_STATS_CALL(FuzzTokenSetRatio, 0);
+    detail::ScratchFrame frame;
     if (score_cutoff > 100) return 0;
 
     return fuzz_detail::token_set_ratio(detail::sorted_split(first1, last1),
@@ -441,6 +580,8 @@ template <typename InputIt2>
 double CachedTokenSetRatio<CharT1>::similarity(InputIt2 first2, InputIt2 last2, double score_cutoff,
                                                double) const
 {
+    RAPIDFUZZ_STATS_CALL(FuzzTokenSetRatio, 0);
+    detail::ScratchFrame frame;
     if (score_cutoff > 100) return 0;
 
     return fuzz_detail::token_set_ratio(tokens_s1, detail::sorted_split(first2, last2), score_cutoff);
@@ -453,6 +594,56 @@ double CachedTokenSetRatio<CharT1>::similarity(const Sentence2& s2, double score
     return similarity(detail::to_begin(s2), detail::to_end(s2), score_cutoff);
 }
 
+#ifdef RAPIDFUZZ_SIMD
+namespace experimental {
+template <int MaxLen>
+template <typename Sentence2>
+void MultiTokenSetRatio<MaxLen>::similarity(double* scores, size_t score_count, const Sentence2& s2,
+                                            double score_cutoff) const
+{
+    detail::ScratchFrame frame;
+    if (score_count < result_count())
+        throw std::invalid_argument("scores has to have >= result_count() elements");
+
+    auto s2_ = detail::make_range(s2);
+    auto s2_copy = fuzz_detail::multi_copy<detail::ScratchVector<uint64_t>>(s2_.begin(), s2_.end());
+    auto tokens_b = detail::sorted_split(s2_copy.begin(), s2_copy.end());
+    tokens_b.dedupe();
+
+    detail::ScratchVector<size_t> dist(result_count());
+    scorer.distance(dist.data(), dist.size(), tokens_b.join());
+
+    const auto& words_b = tokens_b.words();
+    for (size_t i = 0; i < input_count; ++i) {
+        /* in FuzzyWuzzy this returns 0. For sake of compatibility return 0 here as well
+         * see https://github.com/rapidfuzz/RapidFuzz/issues/110 */
+        if (tokens[i].empty() || tokens_b.empty() || score_cutoff > 100) {
+            scores[i] = 0;
+            continue;
+        }
+
+        bool shares_word = false;
+        for (const auto& word : tokens[i].words()) {
+            if (std::binary_search(words_b.begin(), words_b.end(), word)) {
+                shares_word = true;
+                break;
+            }
+        }
+
+        if (shares_word) {
+            scores[i] = fuzz_detail::token_set_ratio(tokens[i], tokens_b, score_cutoff);
+            continue;
+        }
+
+        size_t lensum = tokens[i].length() + tokens_b.length();
+        size_t cutoff_distance = fuzz_detail::score_cutoff_to_distance(score_cutoff, lensum);
+        scores[i] = (dist[i] <= cutoff_distance) ? fuzz_detail::norm_distance(dist[i], lensum, score_cutoff)
+                                                 : 0;
+    }
+}
+} /* namespace experimental */
+#endif
+
 /**********************************************
  *          partial_token_set_ratio
  *********************************************/
@@ -481,6 +672,8 @@ template <typename InputIt1, typename InputIt2>
 double partial_token_set_ratio(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
                                double score_cutoff)
 {
+    RAPIDFUZZ_STATS_CALL(FuzzPartialTokenSetRatio, 0);
+    detail::ScratchFrame frame;
     if (score_cutoff > 100) return 0;
 
     return fuzz_detail::partial_token_set_ratio(detail::sorted_split(first1, last1),
@@ -499,6 +692,8 @@ template <typename InputIt2>
 double CachedPartialTokenSetRatio<CharT1>::similarity(InputIt2 first2, InputIt2 last2, double score_cutoff,
                                                       double) const
 {
+    RAPIDFUZZ_STATS_CALL(FuzzPartialTokenSetRatio, 0);
+    detail::ScratchFrame frame;
     if (score_cutoff > 100) return 0;
 
     return fuzz_detail::partial_token_set_ratio(tokens_s1, detail::sorted_split(first2, last2), score_cutoff);
@@ -518,6 +713,8 @@ double CachedPartialTokenSetRatio<CharT1>::similarity(const Sentence2& s2, doubl
 template <typename InputIt1, typename InputIt2>
 double token_ratio(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, double score_cutoff)
 {
+    RAPIDFUZZ_STATS_CALL(FuzzTokenRatio, 0);
+    detail::ScratchFrame frame;
     if (score_cutoff > 100) return 0;
 
     auto tokens_a = detail::sorted_split(first1, last1);
@@ -571,15 +768,13 @@ double token_ratio(const Sentence1& s1, const Sentence2& s2, double score_cutoff
 }
 
 namespace fuzz_detail {
-template <typename CharT1, typename CachedCharT1, typename InputIt2>
-double token_ratio(const rapidfuzz::detail::SplittedSentenceView<CharT1>& s1_tokens,
-                   const CachedRatio<CachedCharT1>& cached_ratio_s1_sorted, InputIt2 first2, InputIt2 last2,
-                   double score_cutoff)
+template <typename InputIt1, typename RatioScorer, typename InputIt2>
+double token_ratio(const rapidfuzz::detail::SplittedSentenceView<InputIt1>& s1_tokens,
+                   const RatioScorer& cached_ratio_s1_sorted,
+                   const rapidfuzz::detail::SplittedSentenceView<InputIt2>& s2_tokens, double score_cutoff)
 {
     if (score_cutoff > 100) return 0;
 
-    auto s2_tokens = detail::sorted_split(first2, last2);
-
     auto decomposition = detail::set_decomposition(s1_tokens, s2_tokens);
     auto intersect = decomposition.intersection;
     auto diff_ab = decomposition.difference_ab;
@@ -587,56 +782,25 @@ double token_ratio(const rapidfuzz::detail::SplittedSentenceView<CharT1>& s1_tok
 
     if (!intersect.empty() && (diff_ab.empty() || diff_ba.empty())) return 100;
 
-    auto diff_ab_joined = diff_ab.join();
-    auto diff_ba_joined = diff_ba.join();
-
-    size_t ab_len = diff_ab_joined.size();
-    size_t ba_len = diff_ba_joined.size();
-    size_t sect_len = intersect.length();
-
-    double result = cached_ratio_s1_sorted.similarity(s2_tokens.join(), score_cutoff);
-
-    // string length sect+ab <-> sect and sect+ba <-> sect
-    size_t sect_ab_len = sect_len + bool(sect_len) + ab_len;
-    size_t sect_ba_len = sect_len + bool(sect_len) + ba_len;
-
-    size_t cutoff_distance = score_cutoff_to_distance(score_cutoff, sect_ab_len + sect_ba_len);
-    size_t dist = indel_distance(diff_ab_joined, diff_ba_joined, cutoff_distance);
-    if (dist <= cutoff_distance)
-        result = std::max(result, norm_distance(dist, sect_ab_len + sect_ba_len, score_cutoff));
-
-    // exit early since the other ratios are 0
-    if (!sect_len) return result;
-
-    // levenshtein distance sect+ab <-> sect and sect+ba <-> sect
-    // since only sect is similar in them the distance can be calculated based on
-    // the length difference
-    size_t sect_ab_dist = bool(sect_len) + ab_len;
-    double sect_ab_ratio = norm_distance(sect_ab_dist, sect_len + sect_ab_len, score_cutoff);
-
-    size_t sect_ba_dist = bool(sect_len) + ba_len;
-    double sect_ba_ratio = norm_distance(sect_ba_dist, sect_len + sect_ba_len, score_cutoff);
-
-    return std::max({result, sect_ab_ratio, sect_ba_ratio});
-}
-
-// todo this is a temporary solution until WRatio is properly implemented using other scorers
-template <typename CharT1, typename InputIt1, typename InputIt2>
-double token_ratio(const std::vector<CharT1>& s1_sorted,
-                   const rapidfuzz::detail::SplittedSentenceView<InputIt1>& tokens_s1,
-                   const detail::BlockPatternMatchVector& blockmap_s1_sorted, InputIt2 first2, InputIt2 last2,
-                   double score_cutoff)
-{
-    if (score_cutoff > 100) return 0;
-
-    auto tokens_b = detail::sorted_split(first2, last2);
-
-    auto decomposition = detail::set_decomposition(tokens_s1, tokens_b);
-    auto intersect = decomposition.intersection;
-    auto diff_ab = decomposition.difference_ab;
-    auto diff_ba = decomposition.difference_ba;
+    auto s2_sorted = s2_tokens.join();
+
+    // the differences are the sorted strings, so a single distance calculation is enough.
+    // Both the rounding of ratio and the one of the differences are used, so the result
+    // matches token_ratio exactly
+    if (s1_tokens.word_count() == diff_ab.word_count() && s2_tokens.word_count() == diff_ba.word_count()) {
+        size_t lensum = s1_tokens.length() + s2_sorted.size();
+        auto cutoff_distance = static_cast<size_t>(
+            std::ceil(static_cast<double>(lensum) * detail::NormSim_to_NormDist(score_cutoff / 100)));
+        size_t dist =
+            ratio_indel_distance(cached_ratio_s1_sorted, detail::make_range(s2_sorted), cutoff_distance);
+        if (dist > cutoff_distance) return 0;
+
+        double norm_sim = (lensum > 0) ? 1.0 - static_cast<double>(dist) / static_cast<double>(lensum) : 1.0;
+        double result = (norm_sim >= score_cutoff / 100) ? norm_sim * 100 : 0;
+        return std::max(result, norm_distance(dist, lensum, score_cutoff));
+    }
 
-    if (!intersect.empty() && (diff_ab.empty() || diff_ba.empty())) return 100;
+    double result = cached_ratio_s1_sorted.similarity(s2_sorted, score_cutoff);
 
     auto diff_ab_joined = diff_ab.join();
     auto diff_ba_joined = diff_ba.join();
@@ -645,18 +809,6 @@ double token_ratio(const std::vector<CharT1>& s1_sorted,
     size_t ba_len = diff_ba_joined.size();
     size_t sect_len = intersect.length();
 
-    double result = 0;
-    auto s2_sorted = tokens_b.join();
-    if (s1_sorted.size() < 65) {
-        double norm_sim =
-            detail::indel_normalized_similarity(blockmap_s1_sorted, detail::make_range(s1_sorted),
-                                                detail::make_range(s2_sorted), score_cutoff / 100);
-        result = norm_sim * 100;
-    }
-    else {
-        result = fuzz::ratio(s1_sorted, s2_sorted, score_cutoff);
-    }
-
     // string length sect+ab <-> sect and sect+ba <-> sect
     size_t sect_ab_len = sect_len + bool(sect_len) + ab_len;
     size_t sect_ba_len = sect_len + bool(sect_len) + ba_len;
@@ -680,6 +832,7 @@ double token_ratio(const std::vector<CharT1>& s1_sorted,
 
     return std::max({result, sect_ab_ratio, sect_ba_ratio});
 }
+
 } // namespace fuzz_detail
 
 template <typename CharT1>
@@ -687,7 +840,12 @@ template <typename InputIt2>
 double CachedTokenRatio<CharT1>::similarity(InputIt2 first2, InputIt2 last2, double score_cutoff,
                                             double) const
 {
-    return fuzz_detail::token_ratio(s1_tokens, cached_ratio_s1_sorted, first2, last2, score_cutoff);
+    RAPIDFUZZ_STATS_CALL(FuzzTokenRatio, 0);
+    detail::ScratchFrame frame;
+    if (score_cutoff > 100) return 0;
+
+    return fuzz_detail::token_ratio(s1_tokens, cached_ratio_s1_sorted, detail::sorted_split(first2, last2),
+                                    score_cutoff);
 }
 
 template <typename CharT1>
@@ -705,6 +863,8 @@ template <typename InputIt1, typename InputIt2>
 double partial_token_ratio(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
                            double score_cutoff)
 {
+    RAPIDFUZZ_STATS_CALL(FuzzPartialTokenRatio, 0);
+    detail::ScratchFrame frame;
     if (score_cutoff > 100) return 0;
 
     auto tokens_a = detail::sorted_split(first1, last1);
@@ -737,15 +897,14 @@ double partial_token_ratio(const Sentence1& s1, const Sentence2& s2, double scor
 }
 
 namespace fuzz_detail {
-template <typename CharT1, typename InputIt1, typename InputIt2>
-double partial_token_ratio(const std::vector<CharT1>& s1_sorted,
+template <typename PartialRatioScorer, typename InputIt1, typename InputIt2>
+double partial_token_ratio(const PartialRatioScorer& cached_partial_ratio_s1_sorted,
                            const rapidfuzz::detail::SplittedSentenceView<InputIt1>& tokens_s1,
-                           InputIt2 first2, InputIt2 last2, double score_cutoff)
+                           const rapidfuzz::detail::SplittedSentenceView<InputIt2>& tokens_b,
+                           double score_cutoff)
 {
     if (score_cutoff > 100) return 0;
 
-    auto tokens_b = detail::sorted_split(first2, last2);
-
     auto decomposition = detail::set_decomposition(tokens_s1, tokens_b);
 
     // exit early when there is a common word in both sequences
@@ -754,7 +913,7 @@ double partial_token_ratio(const std::vector<CharT1>& s1_sorted,
     auto diff_ab = decomposition.difference_ab;
     auto diff_ba = decomposition.difference_ba;
 
-    double result = partial_ratio(s1_sorted, tokens_b.join(), score_cutoff);
+    double result = cached_partial_ratio_s1_sorted.similarity(tokens_b.join(), score_cutoff);
 
     // do not calculate the same partial_ratio twice
     if (tokens_s1.word_count() == diff_ab.word_count() && tokens_b.word_count() == diff_ba.word_count()) {
@@ -772,7 +931,12 @@ template <typename InputIt2>
 double CachedPartialTokenRatio<CharT1>::similarity(InputIt2 first2, InputIt2 last2, double score_cutoff,
                                                    double) const
 {
-    return fuzz_detail::partial_token_ratio(s1_sorted, tokens_s1, first2, last2, score_cutoff);
+    RAPIDFUZZ_STATS_CALL(FuzzPartialTokenRatio, 0);
+    detail::ScratchFrame frame;
+    if (score_cutoff > 100) return 0;
+
+    return fuzz_detail::partial_token_ratio(cached_partial_ratio_s1_sorted, tokens_s1,
+                                            detail::sorted_split(first2, last2), score_cutoff);
 }
 
 template <typename CharT1>
@@ -789,6 +953,8 @@ double CachedPartialTokenRatio<CharT1>::similarity(const Sentence2& s2, double s
 template <typename InputIt1, typename InputIt2>
 double WRatio(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, double score_cutoff)
 {
+    RAPIDFUZZ_STATS_CALL(FuzzWRatio, 0);
+    detail::ScratchFrame frame;
     if (score_cutoff > 100) return 0;
 
     constexpr double UNBASE_SCALE = 0.95;
@@ -834,20 +1000,26 @@ CachedWRatio<Sentence1>::CachedWRatio(InputIt1 first1, InputIt1 last1)
     : s1(first1, last1),
       cached_partial_ratio(first1, last1),
       tokens_s1(detail::sorted_split(std::begin(s1), std::end(s1))),
-      s1_sorted(tokens_s1.join()),
-      blockmap_s1_sorted(detail::make_range(s1_sorted))
+      cached_partial_ratio_s1_sorted(tokens_s1.join())
 {}
 
-template <typename CharT1>
-template <typename InputIt2>
-double CachedWRatio<CharT1>::similarity(InputIt2 first2, InputIt2 last2, double score_cutoff, double) const
+namespace fuzz_detail {
+/* WRatio using the preprocessed s1 of a cached scorer */
+template <typename Ratio, typename PartialRatio, typename InputIt1, typename SortedRatio,
+          typename SortedPartialRatio, typename InputIt2>
+double cached_wratio(size_t len1, const Ratio& cached_ratio, const PartialRatio& cached_partial_ratio,
+                     const detail::SplittedSentenceView<InputIt1>& tokens_s1,
+                     const SortedRatio& cached_ratio_s1_sorted,
+                     const SortedPartialRatio& cached_partial_ratio_s1_sorted,
+                     const detail::Range<InputIt2>& s2, double score_cutoff)
 {
+    RAPIDFUZZ_STATS_CALL(FuzzWRatio, 0);
+    detail::ScratchFrame frame;
     if (score_cutoff > 100) return 0;
 
     constexpr double UNBASE_SCALE = 0.95;
 
-    size_t len1 = s1.size();
-    size_t len2 = static_cast<size_t>(std::distance(first2, last2));
+    size_t len2 = s2.size();
 
     /* in FuzzyWuzzy this returns 0. For sake of compatibility return 0 here as well
      * see https://github.com/rapidfuzz/RapidFuzz/issues/110 */
@@ -856,27 +1028,71 @@ double CachedWRatio<CharT1>::similarity(InputIt2 first2, InputIt2 last2, double
     double len_ratio = (len1 > len2) ? static_cast<double>(len1) / static_cast<double>(len2)
                                      : static_cast<double>(len2) / static_cast<double>(len1);
 
-    double end_ratio = cached_partial_ratio.cached_ratio.similarity(first2, last2, score_cutoff);
+    double end_ratio = cached_ratio.similarity(s2, score_cutoff);
 
     if (len_ratio < 1.5) {
         score_cutoff = std::max(score_cutoff, end_ratio) / UNBASE_SCALE;
-        // use pre calculated values
-        auto r =
-            fuzz_detail::token_ratio(s1_sorted, tokens_s1, blockmap_s1_sorted, first2, last2, score_cutoff);
+        auto r = token_ratio(tokens_s1, cached_ratio_s1_sorted, detail::sorted_split(s2.begin(), s2.end()),
+                             score_cutoff);
         return std::max(end_ratio, r * UNBASE_SCALE);
     }
 
     const double PARTIAL_SCALE = (len_ratio <= 8.0) ? 0.9 : 0.6;
 
     score_cutoff = std::max(score_cutoff, end_ratio) / PARTIAL_SCALE;
-    end_ratio =
-        std::max(end_ratio, cached_partial_ratio.similarity(first2, last2, score_cutoff) * PARTIAL_SCALE);
+    end_ratio = std::max(end_ratio, cached_partial_ratio.similarity(s2, score_cutoff) * PARTIAL_SCALE);
 
     score_cutoff = std::max(score_cutoff, end_ratio) / UNBASE_SCALE;
-    auto r = fuzz_detail::partial_token_ratio(s1_sorted, tokens_s1, first2, last2, score_cutoff);
+    auto r = partial_token_ratio(cached_partial_ratio_s1_sorted, tokens_s1,
+                                 detail::sorted_split(s2.begin(), s2.end()), score_cutoff);
     return std::max(end_ratio, r * UNBASE_SCALE * PARTIAL_SCALE);
 }
 
+/**
+ * Replaces CachedWRatio for the temporary scorer of MultiWRatio. It must not outlive the current
+ * ScratchFrame and can't be copied, since the scorer of the sorted tokens points into s1_sorted
+ */
+template <typename InputIt1>
+struct ScratchWRatio {
+    using SortedIt = typename detail::ScratchVector<iter_value_t<InputIt1>>::iterator;
+
+    explicit ScratchWRatio(const detail::Range<InputIt1>& s1_)
+        : s1(s1_),
+          cached_partial_ratio(s1_),
+          tokens_s1(detail::sorted_split(s1_.begin(), s1_.end())),
+          s1_sorted(tokens_s1.join()),
+          cached_partial_ratio_s1_sorted(detail::make_range(s1_sorted))
+    {}
+
+    ScratchWRatio(const ScratchWRatio&) = delete;
+    ScratchWRatio& operator=(const ScratchWRatio&) = delete;
+
+    template <typename Sentence2>
+    double similarity(const Sentence2& s2, double score_cutoff) const
+    {
+        return cached_wratio(s1.size(), cached_partial_ratio.cached_ratio, cached_partial_ratio, tokens_s1,
+                             cached_partial_ratio_s1_sorted.cached_ratio, cached_partial_ratio_s1_sorted,
+                             detail::make_range(s2), score_cutoff);
+    }
+
+    detail::Range<InputIt1> s1;
+    ScratchPartialRatio<InputIt1> cached_partial_ratio;
+    detail::SplittedSentenceView<InputIt1> tokens_s1;
+    detail::ScratchVector<iter_value_t<InputIt1>> s1_sorted;
+    ScratchPartialRatio<SortedIt> cached_partial_ratio_s1_sorted;
+};
+} // namespace fuzz_detail
+
+template <typename CharT1>
+template <typename InputIt2>
+double CachedWRatio<CharT1>::similarity(InputIt2 first2, InputIt2 last2, double score_cutoff, double) const
+{
+    return fuzz_detail::cached_wratio(s1.size(), cached_partial_ratio.cached_ratio, cached_partial_ratio,
+                                      tokens_s1, cached_partial_ratio_s1_sorted.cached_ratio,
+                                      cached_partial_ratio_s1_sorted, detail::make_range(first2, last2),
+                                      score_cutoff);
+}
+
 template <typename CharT1>
 template <typename Sentence2>
 double CachedWRatio<CharT1>::similarity(const Sentence2& s2, double score_cutoff, double) const
@@ -884,6 +1100,54 @@ double CachedWRatio<CharT1>::similarity(const Sentence2& s2, double score_cutoff
     return similarity(detail::to_begin(s2), detail::to_end(s2), score_cutoff);
 }
 
+#ifdef RAPIDFUZZ_SIMD
+namespace experimental {
+template <int MaxLen>
+template <typename Sentence2>
+void MultiWRatio<MaxLen>::similarity(double* scores, size_t score_count, const Sentence2& s2,
+                                     double score_cutoff) const
+{
+    detail::ScratchFrame frame;
+    constexpr double UNBASE_SCALE = 0.95;
+
+    auto s2_ = detail::make_range(s2);
+    auto s2_copy = fuzz_detail::multi_copy<detail::ScratchVector<uint64_t>>(s2_.begin(), s2_.end());
+
+    scorer.similarity(scores, score_count, s2_copy, score_cutoff);
+
+    /* WRatio is symmetric, so s2 can be preprocessed once for the remaining ratios */
+    auto s2_range = detail::make_range(s2_copy);
+    fuzz_detail::ScratchWRatio<decltype(s2_range.begin())> cached_wratio(s2_range);
+
+    for (size_t i = 0; i < input_count; ++i) {
+        size_t len1 = strings[i].size();
+        size_t len2 = s2_copy.size();
+
+        /* in FuzzyWuzzy this returns 0. For sake of compatibility return 0 here as well
+         * see https://github.com/rapidfuzz/RapidFuzz/issues/110 */
+        if (!len1 || !len2 || score_cutoff > 100) {
+            scores[i] = 0;
+            continue;
+        }
+
+        double len_ratio = (len1 > len2) ? static_cast<double>(len1) / static_cast<double>(len2)
+                                         : static_cast<double>(len2) / static_cast<double>(len1);
+
+        /* highest score the scaled token and partial ratios can reach */
+        double max_scaled_score;
+        if (len_ratio < 1.5)
+            max_scaled_score = 100.0 * UNBASE_SCALE;
+        else
+            max_scaled_score = (len_ratio <= 8.0) ? 100.0 * 0.9 : 100.0 * 0.6;
+
+        if (scores[i] >= max_scaled_score || max_scaled_score < score_cutoff) continue;
+
+        scores[i] = cached_wratio.similarity(strings[i], score_cutoff);
+    }
+}
+} /* namespace experimental */
+#endif
+
 /**********************************************
  *                QRatio
  *********************************************/
@@ -891,6 +1155,7 @@ double CachedWRatio<CharT1>::similarity(const Sentence2& s2, double score_cutoff
 template <typename InputIt1, typename InputIt2>
 double QRatio(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, double score_cutoff)
 {
+    RAPIDFUZZ_STATS_CALL(FuzzQRatio, 0);
     ptrdiff_t len1 = std::distance(first1, last1);
     ptrdiff_t len2 = std::distance(first2, last2);
 
@@ -912,6 +1177,7 @@ template <typename CharT1>
 template <typename InputIt2>
 double CachedQRatio<CharT1>::similarity(InputIt2 first2, InputIt2 last2, double score_cutoff, double) const
 {
+    RAPIDFUZZ_STATS_CALL(FuzzQRatio, 0);
     auto len2 = std::distance(first2, last2);
 
     /* in FuzzyWuzzy this returns 0. For sake of compatibility return 0 here as well
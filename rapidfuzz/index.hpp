@@ -0,0 +1,456 @@
+/* SPDX-License-Identifier: MIT */
+/* Copyright © 2022-present Max Bachmann */
+
+#pragma once
+#include <rapidfuzz/details/PatternMatchVector.hpp>
+#include <rapidfuzz/details/common.hpp>
+#include <rapidfuzz/distance/DamerauLevenshtein.hpp>
+#include <rapidfuzz/distance/Hamming.hpp>
+#include <rapidfuzz/distance/Indel.hpp>
+#include <rapidfuzz/distance/Levenshtein.hpp>
+#include <rapidfuzz/distance/OSA.hpp>
+#include <rapidfuzz/process.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace rapidfuzz {
+namespace index {
+
+/**
+ * @defgroup Index Index
+ * Data structures built over a fixed list of choices, which find the choices within a
+ * maximum distance of a query without comparing the query with every choice
+ * @{
+ */
+
+namespace index_detail {
+
+/* cached scorers whose distance is never smaller than the uniform Levenshtein distance */
+template <template <typename> class CachedScorer>
+struct is_levenshtein_bounded : std::false_type {};
+
+template <>
+struct is_levenshtein_bounded<CachedLevenshtein> : std::true_type {};
+
+template <>
+struct is_levenshtein_bounded<CachedIndel> : std::true_type {};
+
+/* cached scorers whose distance fulfills the triangle inequality. OSA does not, since
+ * e.g. OSA("ca", "ac") + OSA("ac", "abc") = 2 < OSA("ca", "abc") = 3 */
+template <template <typename> class CachedScorer>
+struct is_metric : std::false_type {};
+
+template <>
+struct is_metric<CachedLevenshtein> : std::true_type {};
+
+template <>
+struct is_metric<experimental::CachedDamerauLevenshtein> : std::true_type {};
+
+template <>
+struct is_metric<CachedIndel> : std::true_type {};
+
+template <>
+struct is_metric<CachedHamming> : std::true_type {};
+
+/* cached scorers whose distance is never smaller than the OSA distance */
+template <template <typename> class CachedScorer>
+struct is_osa_bounded : std::false_type {};
+
+template <>
+struct is_osa_bounded<CachedLevenshtein> : std::true_type {};
+
+template <>
+struct is_osa_bounded<CachedOSA> : std::true_type {};
+
+template <>
+struct is_osa_bounded<CachedIndel> : std::true_type {};
+
+template <>
+struct is_osa_bounded<CachedHamming> : std::true_type {};
+
+} // namespace index_detail
+
+/**
+ * @brief inverted index over the q-grams of a list of choices
+ *
+ * @details
+ * A single edit operation changes at most q of the q-grams of a string. So two strings
+ * with a Levenshtein distance <= k share at least max(len1, len2) - q + 1 - k * q q-grams
+ * (q-gram lemma). The index counts the shared q-grams of the query and every choice with a
+ * similar length and only compares the choices, which pass this count filter, using the
+ * cached scorer. This is useful for small distances, where the overwhelming majority of
+ * choices share too few q-grams with the query.
+ *
+ * @code{.cpp}
+ * std::vector<std::string> choices = {"new york yankees", "new york mets", "atlanta"};
+ * QGramIndex<char> index(choices, 2);
+ *
+ * // {{1, 1}}
+ * auto results = index.search("new york met", 2);
+ * @endcode
+ *
+ * @tparam CharT1 character type of the choices
+ */
+template <typename CharT1>
+class QGramIndex {
+public:
+    /**
+     * @param choices range of strings
+     * @param q length of the q-grams. Smaller values keep the filter effective for larger
+     * distances, larger values produce fewer candidates for small distances
+     *
+     * @throws std::invalid_argument when q is 0
+     */
+    template <typename Choices>
+    explicit QGramIndex(const Choices& choices, size_t q = 3);
+
+    /**
+     * @brief number of choices
+     */
+    size_t size() const
+    {
+        return lengths.size();
+    }
+
+    /**
+     * @brief length of the q-grams
+     */
+    size_t qgram_size() const
+    {
+        return q;
+    }
+
+    /**
+     * @brief finds all choices, which could have a Levenshtein distance <= max to query
+     *
+     * @return indices of the candidates in ascending order. This includes every choice with a
+     * Levenshtein distance <= max, but can include choices with a larger distance as well
+     */
+    template <typename Sentence>
+    std::vector<size_t> candidates(const Sentence& query, size_t max) const;
+
+    /**
+     * @brief finds all choices with a distance <= max to query
+     *
+     * @tparam CachedScorer CachedLevenshtein or CachedIndel. The q-gram lemma only holds
+     * for scorers whose distance is never smaller than the Levenshtein distance
+     *
+     * @return results sorted by distance. Choices with the same distance are sorted by index
+     */
+    template <template <typename> class CachedScorer = CachedLevenshtein, typename Sentence>
+    std::vector<process::ExtractResult<size_t>> search(const Sentence& query, size_t max) const;
+
+private:
+    struct Posting {
+        size_t index; /**< position of the choice */
+        size_t count; /**< number of occurrences of the q-gram in the choice */
+    };
+
+    /* q-grams of a string as sorted list of (hash, number of occurrences) */
+    template <typename InputIt>
+    static std::vector<std::pair<uint64_t, size_t>> qgram_profile(InputIt first, InputIt last, size_t q);
+
+    size_t q;
+    /* choices stored back to back */
+    std::vector<CharT1> data;
+    std::vector<size_t> offsets;
+    std::vector<size_t> lengths;
+    /* indices of the choices sorted by length. The choices of length L are stored
+     * in [length_offsets[L], length_offsets[L + 1]) */
+    std::vector<size_t> length_order;
+    std::vector<size_t> length_offsets;
+    std::unordered_map<uint64_t, std::vector<Posting>> postings;
+};
+
+/**
+ * @brief BK-tree over a list of choices for a distance metric
+ *
+ * @details
+ * Every child of a node is stored under its distance to the node. Because of the triangle
+ * inequality, only children with a key in [d - max, d + max] can contain strings within max
+ * of a query with the distance d to the node. The maximum key of a node plus max is passed to
+ * the scorer as score_cutoff, so the distance to a node is only calculated exactly when it
+ * is required for the traversal.
+ *
+ * @code{.cpp}
+ * std::vector<std::string> words = {"book", "books", "cake", "boo", "cape", "cart"};
+ * MetricTree<CachedLevenshtein, char> tree(words);
+ *
+ * // {{1, 0}, {1, 3}}
+ * auto results = tree.search("boot", 1);
+ * // {{1, 0}, {1, 3}, {2, 1}}
+ * auto nearest = tree.nearest("boot", 3);
+ * @endcode
+ *
+ * @tparam CachedScorer cached scorer of a metric: CachedLevenshtein,
+ * experimental::CachedDamerauLevenshtein, CachedIndel or CachedHamming.
+ * CachedOSA is not supported, since OSA does not fulfill the triangle inequality
+ * @tparam CharT1 character type of the choices
+ */
+template <template <typename> class CachedScorer, typename CharT1>
+class MetricTree {
+    static_assert(index_detail::is_metric<CachedScorer>::value,
+                  "MetricTree requires a scorer which fulfills the triangle inequality");
+
+public:
+    MetricTree()
+    {}
+
+    /**
+     * @brief builds the tree by inserting all choices
+     *
+     * @param choices range of strings
+     */
+    template <typename Choices>
+    explicit MetricTree(const Choices& choices);
+
+    /**
+     * @brief number of strings in the tree
+     */
+    size_t size() const
+    {
+        return nodes.size();
+    }
+
+    /**
+     * @brief inserts a string into the tree. Its index in the results is the number of
+     * strings inserted before it
+     */
+    template <typename Sentence>
+    void insert(const Sentence& s);
+
+    /**
+     * @brief finds all strings with a distance <= max to query
+     *
+     * @return results sorted by distance. Strings with the same distance are sorted by index
+     */
+    template <typename Sentence>
+    std::vector<process::ExtractResult<size_t>> search(const Sentence& query, size_t max) const;
+
+    /**
+     * @brief finds the k strings with the smallest distance to query
+     *
+     * @details
+     * The distance of the k-th best result found so far is used as search radius, so the
+     * search becomes more selective while the tree is traversed.
+     *
+     * @return results sorted by distance. Strings with the same distance are sorted by index
+     */
+    template <typename Sentence>
+    std::vector<process::ExtractResult<size_t>> nearest(const Sentence& query, size_t k) const;
+
+private:
+    struct Node {
+        /* (distance to this node, node id) sorted by distance */
+        std::vector<std::pair<size_t, size_t>> children;
+    };
+
+    template <typename Scorer>
+    size_t node_distance(const Scorer& scorer, size_t node, size_t score_cutoff) const;
+
+    std::vector<CharT1> data;
+    std::vector<size_t> offsets;
+    std::vector<size_t> lengths;
+    /* node i stores the string with index i. Node 0 is the root */
+    std::vector<Node> nodes;
+};
+
+/**
+ * @brief index over the deletion neighbourhood of a list of choices (SymSpell)
+ *
+ * @details
+ * Two strings with an OSA distance <= k can be turned into the same string by deleting at
+ * most k characters from each of them. This holds for the prefixes of both strings as well.
+ * The index stores every string, which can be created by deleting up to max_depth characters
+ * from the prefix of a choice. A query only generates the deletion variants of its own
+ * prefix and looks them up, so the lookup time does not depend on the number of choices.
+ * The candidates are verified using the cached scorer, which uses mbleven for Levenshtein
+ * distances <= 3.
+ *
+ * The number of stored variants grows with prefix_length^max_depth, so this is meant for
+ * tiny distances. A shorter prefix uses less memory, but produces more candidates.
+ *
+ * @code{.cpp}
+ * std::vector<std::string> words = {"book", "books", "cake", "boo", "cape", "cart"};
+ * DeletionIndex<char> index(words, 2);
+ *
+ * // {{1, 0}, {1, 3}}
+ * auto results = index.search("boot", 1);
+ * @endcode
+ *
+ * @tparam CharT1 character type of the choices
+ */
+template <typename CharT1>
+class DeletionIndex {
+public:
+    /**
+     * @param choices range of strings
+     * @param max_depth maximum number of deletions stored per choice. This is the
+     * maximum distance supported by search
+     * @param prefix_length only the deletion variants of the first prefix_length
+     * characters of each choice are stored
+     *
+     * @throws std::invalid_argument when prefix_length is 0
+     */
+    template <typename Choices>
+    explicit DeletionIndex(const Choices& choices, size_t max_depth = 2, size_t prefix_length = 7);
+
+    /**
+     * @brief number of choices
+     */
+    size_t size() const
+    {
+        return lengths.size();
+    }
+
+    size_t max_depth() const
+    {
+        return depth;
+    }
+
+    size_t prefix_length() const
+    {
+        return prefix_len;
+    }
+
+    /**
+     * @brief number of distinct deletion variants stored in the index
+     */
+    size_t variant_count() const
+    {
+        return postings.size();
+    }
+
+    /**
+     * @brief finds all choices, which could have an OSA distance <= max to query
+     *
+     * @return indices of the candidates in ascending order
+     *
+     * @throws std::invalid_argument when max is larger than max_depth()
+     */
+    template <typename Sentence>
+    std::vector<size_t> candidates(const Sentence& query, size_t max) const;
+
+    /**
+     * @brief finds all choices with a distance <= max to query
+     *
+     * @tparam CachedScorer CachedLevenshtein, CachedOSA, CachedIndel or CachedHamming.
+     * The index only finds all results for scorers whose distance is never smaller
+     * than the OSA distance
+     *
+     * @return results sorted by distance. Choices with the same distance are sorted by index
+     *
+     * @throws std::invalid_argument when max is larger than max_depth()
+     */
+    template <template <typename> class CachedScorer = CachedLevenshtein, typename Sentence>
+    std::vector<process::ExtractResult<size_t>> search(const Sentence& query, size_t max) const;
+
+private:
+    /* adds the hashes of all strings created by deleting up to depth characters from s */
+    static void deletion_variants(std::vector<uint64_t>& s, size_t depth,
+                                  std::unordered_set<uint64_t>& variants);
+
+    template <typename InputIt>
+    std::unordered_set<uint64_t> prefix_variants(InputIt first, InputIt last, size_t max) const;
+
+    size_t depth;
+    size_t prefix_len;
+    /* choices stored back to back */
+    std::vector<CharT1> data;
+    std::vector<size_t> offsets;
+    std::vector<size_t> lengths;
+    std::unordered_map<uint64_t, std::vector<size_t>> postings;
+};
+
+/**
+ * @brief trie over a list of choices for Levenshtein searches
+ *
+ * @details
+ * The search walks the trie depth first and advances the bit-parallel Levenshtein state
+ * (VP / VN of Hyyrö's algorithm for the query) by one character per edge. Words with a
+ * common prefix share the state of this prefix, so each trie node is processed only once.
+ * Since the distance never decreases along an alignment, the minimum of the current
+ * DP column is a lower bound for every word below a node. Subtrees where this bound
+ * exceeds max are skipped.
+ *
+ * @code{.cpp}
+ * std::vector<std::string> words = {"book", "books", "cake", "boo", "cape", "cart"};
+ * Trie<char> trie(words);
+ *
+ * // {{1, 0}, {1, 3}}
+ * auto results = trie.search("boot", 1);
+ * @endcode
+ *
+ * @tparam CharT1 character type of the choices
+ */
+template <typename CharT1>
+class Trie {
+public:
+    Trie() : nodes(1), word_count(0)
+    {}
+
+    /**
+     * @param choices range of strings
+     */
+    template <typename Choices>
+    explicit Trie(const Choices& choices);
+
+    /**
+     * @brief number of words in the trie
+     */
+    size_t size() const
+    {
+        return word_count;
+    }
+
+    /**
+     * @brief number of trie nodes including the root
+     */
+    size_t node_count() const
+    {
+        return nodes.size();
+    }
+
+    /**
+     * @brief inserts a word into the trie. Its index in the results is the number of
+     * words inserted before it
+     */
+    template <typename Sentence>
+    void insert(const Sentence& s);
+
+    /**
+     * @brief finds all words with a Levenshtein distance <= max to query
+     *
+     * @return results sorted by distance. Words with the same distance are sorted by index
+     */
+    template <typename Sentence>
+    std::vector<process::ExtractResult<size_t>> search(const Sentence& query, size_t max) const;
+
+private:
+    struct Node {
+        /* (character, node id) sorted by character */
+        std::vector<std::pair<CharT1, size_t>> children;
+        /* indices of the words ending in this node */
+        std::vector<size_t> indices;
+    };
+
+    /* minimum of the DP column after depth characters, only considering the rows which
+     * can be <= max. Returns max + 1 when no row can be <= max */
+    static size_t column_min(const std::vector<detail::LevenshteinRow>& vecs, size_t len1, size_t depth,
+                             size_t max);
+
+    std::vector<Node> nodes;
+    size_t word_count;
+};
+
+/**@}*/
+
+} // namespace index
+} // namespace rapidfuzz
+
+#include <rapidfuzz/index_impl.hpp>
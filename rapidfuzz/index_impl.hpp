@@ -0,0 +1,549 @@
+/* SPDX-License-Identifier: MIT */
+/* Copyright © 2022-present Max Bachmann */
+
+#include <rapidfuzz/details/type_traits.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+namespace rapidfuzz {
+namespace index {
+namespace index_detail {
+
+/* FNV-1a over the characters of a string. Hash collisions can only add candidates,
+ * since they make strings look more similar. The characters are converted like in the
+ * pattern match vectors, so strings of different character types get the same hash */
+template <typename InputIt>
+uint64_t hash_chars(InputIt first, InputIt last)
+{
+    uint64_t hash = UINT64_C(0xcbf29ce484222325);
+    for (; first != last; ++first) {
+        hash ^= detail::multi_char(*first);
+        hash *= UINT64_C(0x100000001b3);
+    }
+    return hash;
+}
+
+static inline size_t saturating_add(size_t a, size_t b)
+{
+    return (a > std::numeric_limits<size_t>::max() - b) ? std::numeric_limits<size_t>::max() : a + b;
+}
+
+static inline bool result_less(const process::ExtractResult<size_t>& a,
+                               const process::ExtractResult<size_t>& b)
+{
+    return (a.score != b.score) ? a.score < b.score : a.index < b.index;
+}
+
+} // namespace index_detail
+
+template <typename CharT1>
+template <typename Choices>
+QGramIndex<CharT1>::QGramIndex(const Choices& choices, size_t q_) : q(q_)
+{
+    if (q == 0) throw std::invalid_argument("q has to be > 0");
+
+    size_t max_len = 0;
+    for (const auto& choice : choices) {
+        size_t index = lengths.size();
+        offsets.push_back(data.size());
+        data.insert(data.end(), detail::to_begin(choice), detail::to_end(choice));
+        size_t len = data.size() - offsets.back();
+        lengths.push_back(len);
+        max_len = std::max(max_len, len);
+
+        for (const auto& qgram : qgram_profile(detail::to_begin(choice), detail::to_end(choice), q))
+            postings[qgram.first].push_back({index, qgram.second});
+    }
+
+    /* counting sort of the choices by length */
+    length_offsets.assign(max_len + 2, 0);
+    for (size_t len : lengths)
+        length_offsets[len + 1]++;
+    for (size_t len = 1; len < length_offsets.size(); ++len)
+        length_offsets[len] += length_offsets[len - 1];
+
+    length_order.resize(lengths.size());
+    std::vector<size_t> insert_pos(length_offsets.begin(), length_offsets.end() - 1);
+    for (size_t i = 0; i < lengths.size(); ++i)
+        length_order[insert_pos[lengths[i]]++] = i;
+}
+
+template <typename CharT1>
+template <typename InputIt>
+std::vector<std::pair<uint64_t, size_t>> QGramIndex<CharT1>::qgram_profile(InputIt first, InputIt last,
+                                                                           size_t q)
+{
+    std::vector<uint64_t> hashes;
+    std::vector<uint64_t> window;
+    for (; first != last; ++first) {
+        window.push_back(detail::multi_char(*first));
+        if (window.size() < q) continue;
+
+        hashes.push_back(index_detail::hash_chars(window.end() - static_cast<ptrdiff_t>(q), window.end()));
+    }
+
+    std::sort(hashes.begin(), hashes.end());
+    std::vector<std::pair<uint64_t, size_t>> profile;
+    for (uint64_t hash : hashes) {
+        if (!profile.empty() && profile.back().first == hash)
+            profile.back().second++;
+        else
+            profile.emplace_back(hash, 1);
+    }
+    return profile;
+}
+
+template <typename CharT1>
+template <typename Sentence>
+std::vector<size_t> QGramIndex<CharT1>::candidates(const Sentence& query, size_t max) const
+{
+    auto query_first = detail::to_begin(query);
+    auto query_last = detail::to_end(query);
+    size_t len1 = static_cast<size_t>(std::distance(query_first, query_last));
+
+    /* only choices with a length in [min_len, max_len] can be within max */
+    size_t min_len = (len1 > max) ? len1 - max : 0;
+    size_t max_len = std::min(length_offsets.size() - 2, (len1 > SIZE_MAX - max) ? SIZE_MAX : len1 + max);
+    if (lengths.empty() || min_len > max_len) return {};
+
+    /* minimum number of shared q-grams required for a choice of length len2. When
+     * this is <= 0 the count filter can't exclude any choice of this length */
+    auto min_shared = [&](size_t len2) -> int64_t {
+        size_t longest = std::max(len1, len2);
+        if (max >= longest) return 0;
+        return static_cast<int64_t>(longest + 1) - static_cast<int64_t>(q * (max + 1));
+    };
+
+    std::vector<size_t> result;
+    std::vector<std::pair<size_t, size_t>> hits;
+    for (const auto& qgram : qgram_profile(query_first, query_last, q)) {
+        auto iter = postings.find(qgram.first);
+        if (iter == postings.end()) continue;
+
+        for (const auto& posting : iter->second) {
+            size_t len2 = lengths[posting.index];
+            if (len2 < min_len || len2 > max_len || min_shared(len2) <= 0) continue;
+            hits.emplace_back(posting.index, std::min(qgram.second, posting.count));
+        }
+    }
+
+    std::sort(hits.begin(), hits.end());
+    for (size_t i = 0; i < hits.size();) {
+        size_t index = hits[i].first;
+        size_t shared = 0;
+        for (; i < hits.size() && hits[i].first == index; ++i)
+            shared += hits[i].second;
+
+        if (static_cast<int64_t>(shared) >= min_shared(lengths[index])) result.push_back(index);
+    }
+
+    for (size_t len2 = min_len; len2 <= max_len; ++len2) {
+        if (min_shared(len2) > 0) continue;
+        result.insert(result.end(), length_order.begin() + static_cast<ptrdiff_t>(length_offsets[len2]),
+                      length_order.begin() + static_cast<ptrdiff_t>(length_offsets[len2 + 1]));
+    }
+
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+template <typename CharT1>
+template <template <typename> class CachedScorer, typename Sentence>
+std::vector<process::ExtractResult<size_t>> QGramIndex<CharT1>::search(const Sentence& query,
+                                                                       size_t max) const
+{
+    static_assert(index_detail::is_levenshtein_bounded<CachedScorer>::value,
+                  "the q-gram filter only supports CachedLevenshtein and CachedIndel");
+
+    CachedScorer<char_type<Sentence>> scorer(query);
+    std::vector<process::ExtractResult<size_t>> results;
+    for (size_t index : candidates(query, max)) {
+        auto first2 = data.begin() + static_cast<ptrdiff_t>(offsets[index]);
+        size_t dist = scorer.distance(first2, first2 + static_cast<ptrdiff_t>(lengths[index]), max);
+        if (dist <= max) results.push_back({dist, index});
+    }
+
+    std::sort(results.begin(), results.end(), index_detail::result_less);
+    return results;
+}
+
+template <template <typename> class CachedScorer, typename CharT1>
+template <typename Choices>
+MetricTree<CachedScorer, CharT1>::MetricTree(const Choices& choices)
+{
+    for (const auto& choice : choices)
+        insert(choice);
+}
+
+template <template <typename> class CachedScorer, typename CharT1>
+template <typename Scorer>
+size_t MetricTree<CachedScorer, CharT1>::node_distance(const Scorer& scorer, size_t node,
+                                                       size_t score_cutoff) const
+{
+    auto first2 = data.begin() + static_cast<ptrdiff_t>(offsets[node]);
+    return scorer.distance(first2, first2 + static_cast<ptrdiff_t>(lengths[node]), score_cutoff);
+}
+
+template <template <typename> class CachedScorer, typename CharT1>
+template <typename Sentence>
+void MetricTree<CachedScorer, CharT1>::insert(const Sentence& s)
+{
+    size_t index = nodes.size();
+    offsets.push_back(data.size());
+    data.insert(data.end(), detail::to_begin(s), detail::to_end(s));
+    lengths.push_back(data.size() - offsets.back());
+    nodes.emplace_back();
+    if (index == 0) return;
+
+    CachedScorer<char_type<Sentence>> scorer(s);
+    size_t node = 0;
+    while (true) {
+        size_t dist = node_distance(scorer, node, std::numeric_limits<size_t>::max());
+        auto& children = nodes[node].children;
+        auto iter = std::lower_bound(children.begin(), children.end(), std::make_pair(dist, size_t(0)));
+        if (iter == children.end() || iter->first != dist) {
+            children.insert(iter, std::make_pair(dist, index));
+            return;
+        }
+        node = iter->second;
+    }
+}
+
+template <template <typename> class CachedScorer, typename CharT1>
+template <typename Sentence>
+std::vector<process::ExtractResult<size_t>> MetricTree<CachedScorer, CharT1>::search(const Sentence& query,
+                                                                                     size_t max) const
+{
+    std::vector<process::ExtractResult<size_t>> results;
+    if (nodes.empty()) return results;
+
+    CachedScorer<char_type<Sentence>> scorer(query);
+    std::vector<size_t> stack = {0};
+    while (!stack.empty()) {
+        size_t node = stack.back();
+        stack.pop_back();
+
+        const auto& children = nodes[node].children;
+        size_t max_key = children.empty() ? 0 : children.back().first;
+        /* no child can be within max when the distance exceeds this */
+        size_t score_cutoff = index_detail::saturating_add(max_key, max);
+        size_t dist = node_distance(scorer, node, score_cutoff);
+        if (dist <= max) results.push_back({dist, node});
+        if (dist > score_cutoff) continue;
+
+        size_t lower = (dist > max) ? dist - max : 0;
+        size_t upper = index_detail::saturating_add(dist, max);
+        auto iter = std::lower_bound(children.begin(), children.end(), std::make_pair(lower, size_t(0)));
+        for (; iter != children.end() && iter->first <= upper; ++iter)
+            stack.push_back(iter->second);
+    }
+
+    std::sort(results.begin(), results.end(), index_detail::result_less);
+    return results;
+}
+
+template <template <typename> class CachedScorer, typename CharT1>
+template <typename Sentence>
+std::vector<process::ExtractResult<size_t>> MetricTree<CachedScorer, CharT1>::nearest(const Sentence& query,
+                                                                                      size_t k) const
+{
+    /* max heap with the worst result in front */
+    std::vector<process::ExtractResult<size_t>> results;
+    if (nodes.empty() || k == 0) return results;
+
+    CachedScorer<char_type<Sentence>> scorer(query);
+    size_t radius = std::numeric_limits<size_t>::max();
+
+    /* (lower bound of the distance of the subtree, node) */
+    std::vector<std::pair<size_t, size_t>> stack = {{0, 0}};
+    std::vector<std::pair<size_t, size_t>> promising;
+    while (!stack.empty()) {
+        auto top = stack.back();
+        stack.pop_back();
+        /* the radius might have shrunk since the node was added */
+        if (top.first > radius) continue;
+
+        size_t node = top.second;
+        const auto& children = nodes[node].children;
+        size_t max_key = children.empty() ? 0 : children.back().first;
+        size_t score_cutoff = index_detail::saturating_add(max_key, radius);
+        size_t dist = node_distance(scorer, node, score_cutoff);
+
+        process::ExtractResult<size_t> result = {dist, node};
+        if (results.size() < k) {
+            results.push_back(result);
+            std::push_heap(results.begin(), results.end(), index_detail::result_less);
+        }
+        else if (index_detail::result_less(result, results.front())) {
+            std::pop_heap(results.begin(), results.end(), index_detail::result_less);
+            results.back() = result;
+            std::push_heap(results.begin(), results.end(), index_detail::result_less);
+        }
+        if (results.size() == k) radius = results.front().score;
+        if (dist > score_cutoff) continue;
+
+        size_t lower = (dist > radius) ? dist - radius : 0;
+        size_t upper = index_detail::saturating_add(dist, radius);
+        promising.clear();
+        auto iter = std::lower_bound(children.begin(), children.end(), std::make_pair(lower, size_t(0)));
+        for (; iter != children.end() && iter->first <= upper; ++iter) {
+            size_t bound = (iter->first > dist) ? iter->first - dist : dist - iter->first;
+            promising.emplace_back(bound, iter->second);
+        }
+
+        /* visit the children with the smallest lower bound first */
+        std::sort(promising.begin(), promising.end(), std::greater<std::pair<size_t, size_t>>());
+        stack.insert(stack.end(), promising.begin(), promising.end());
+    }
+
+    std::sort_heap(results.begin(), results.end(), index_detail::result_less);
+    return results;
+}
+
+template <typename CharT1>
+template <typename Choices>
+DeletionIndex<CharT1>::DeletionIndex(const Choices& choices, size_t max_depth, size_t prefix_length)
+    : depth(max_depth), prefix_len(prefix_length)
+{
+    if (prefix_len == 0) throw std::invalid_argument("prefix_length has to be > 0");
+
+    for (const auto& choice : choices) {
+        size_t index = lengths.size();
+        offsets.push_back(data.size());
+        data.insert(data.end(), detail::to_begin(choice), detail::to_end(choice));
+        lengths.push_back(data.size() - offsets.back());
+
+        auto first = data.begin() + static_cast<ptrdiff_t>(offsets.back());
+        for (uint64_t variant : prefix_variants(first, data.end(), depth))
+            postings[variant].push_back(index);
+    }
+}
+
+template <typename CharT1>
+void DeletionIndex<CharT1>::deletion_variants(std::vector<uint64_t>& s, size_t depth,
+                                              std::unordered_set<uint64_t>& variants)
+{
+    /* every path to a variant deletes the same number of characters, so a variant
+     * which was already found does not need to be expanded again */
+    if (!variants.insert(index_detail::hash_chars(s.begin(), s.end())).second) return;
+    if (depth == 0) return;
+
+    for (size_t i = 0; i < s.size(); ++i) {
+        std::vector<uint64_t> variant;
+        variant.reserve(s.size() - 1);
+        variant.insert(variant.end(), s.begin(), s.begin() + static_cast<ptrdiff_t>(i));
+        variant.insert(variant.end(), s.begin() + static_cast<ptrdiff_t>(i + 1), s.end());
+        deletion_variants(variant, depth - 1, variants);
+    }
+}
+
+template <typename CharT1>
+template <typename InputIt>
+std::unordered_set<uint64_t> DeletionIndex<CharT1>::prefix_variants(InputIt first, InputIt last,
+                                                                    size_t max) const
+{
+    std::vector<uint64_t> prefix;
+    for (; first != last && prefix.size() < prefix_len; ++first)
+        prefix.push_back(detail::multi_char(*first));
+
+    std::unordered_set<uint64_t> variants;
+    deletion_variants(prefix, max, variants);
+    return variants;
+}
+
+template <typename CharT1>
+template <typename Sentence>
+std::vector<size_t> DeletionIndex<CharT1>::candidates(const Sentence& query, size_t max) const
+{
+    if (max > depth) throw std::invalid_argument("max has to be <= max_depth()");
+
+    auto query_first = detail::to_begin(query);
+    auto query_last = detail::to_end(query);
+    size_t len1 = static_cast<size_t>(std::distance(query_first, query_last));
+
+    std::vector<size_t> result;
+    for (uint64_t variant : prefix_variants(query_first, query_last, max)) {
+        auto iter = postings.find(variant);
+        if (iter == postings.end()) continue;
+
+        for (size_t index : iter->second)
+            if (detail::abs_diff(len1, lengths[index]) <= max) result.push_back(index);
+    }
+
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+template <typename CharT1>
+template <template <typename> class CachedScorer, typename Sentence>
+std::vector<process::ExtractResult<size_t>> DeletionIndex<CharT1>::search(const Sentence& query,
+                                                                          size_t max) const
+{
+    static_assert(index_detail::is_osa_bounded<CachedScorer>::value,
+                  "the deletion index only supports CachedLevenshtein, CachedOSA, CachedIndel and "
+                  "CachedHamming");
+
+    auto candidate_indices = candidates(query, max);
+    CachedScorer<char_type<Sentence>> scorer(query);
+    std::vector<process::ExtractResult<size_t>> results;
+    for (size_t index : candidate_indices) {
+        auto first2 = data.begin() + static_cast<ptrdiff_t>(offsets[index]);
+        size_t dist = scorer.distance(first2, first2 + static_cast<ptrdiff_t>(lengths[index]), max);
+        if (dist <= max) results.push_back({dist, index});
+    }
+
+    std::sort(results.begin(), results.end(), index_detail::result_less);
+    return results;
+}
+
+template <typename CharT1>
+template <typename Choices>
+Trie<CharT1>::Trie(const Choices& choices) : Trie()
+{
+    for (const auto& choice : choices)
+        insert(choice);
+}
+
+template <typename CharT1>
+template <typename Sentence>
+void Trie<CharT1>::insert(const Sentence& s)
+{
+    size_t node = 0;
+    for (auto first = detail::to_begin(s); first != detail::to_end(s); ++first) {
+        auto key = std::make_pair(static_cast<CharT1>(*first), size_t(0));
+        auto& children = nodes[node].children;
+        auto iter = std::lower_bound(children.begin(), children.end(), key);
+        if (iter != children.end() && iter->first == key.first) {
+            node = iter->second;
+            continue;
+        }
+
+        size_t child = nodes.size();
+        children.insert(iter, std::make_pair(key.first, child));
+        /* children is invalidated by emplace_back */
+        nodes.emplace_back();
+        node = child;
+    }
+
+    nodes[node].indices.push_back(word_count++);
+}
+
+template <typename CharT1>
+size_t Trie<CharT1>::column_min(const std::vector<detail::LevenshteinRow>& vecs, size_t len1, size_t depth,
+                                size_t max)
+{
+    /* D[i][depth] >= |i - depth|, so only the rows in [depth - max, depth + max] can be <= max */
+    if (depth > index_detail::saturating_add(len1, max)) return max + 1;
+    size_t first_row = (depth > max) ? depth - max : 0;
+    size_t last_row = std::min(len1, index_detail::saturating_add(depth, max));
+
+    /* D[first_row][depth] = depth + the vertical deltas of the rows 1 to first_row.
+     * Row i is stored in bit i - 1 */
+    auto dist = static_cast<int64_t>(depth);
+    size_t full_words = first_row / 64;
+    for (size_t word = 0; word < full_words; ++word)
+        dist += static_cast<int64_t>(detail::popcount(vecs[word].VP)) -
+                static_cast<int64_t>(detail::popcount(vecs[word].VN));
+    if (first_row % 64) {
+        uint64_t mask = (UINT64_C(1) << (first_row % 64)) - 1;
+        dist += static_cast<int64_t>(detail::popcount(vecs[full_words].VP & mask)) -
+                static_cast<int64_t>(detail::popcount(vecs[full_words].VN & mask));
+    }
+
+    int64_t min_dist = dist;
+    for (size_t row = first_row + 1; row <= last_row; ++row) {
+        size_t bit = (row - 1) % 64;
+        size_t word = (row - 1) / 64;
+        dist += static_cast<int64_t>((vecs[word].VP >> bit) & 1);
+        dist -= static_cast<int64_t>((vecs[word].VN >> bit) & 1);
+        min_dist = std::min(min_dist, dist);
+    }
+    return static_cast<size_t>(min_dist);
+}
+
+template <typename CharT1>
+template <typename Sentence>
+std::vector<process::ExtractResult<size_t>> Trie<CharT1>::search(const Sentence& query, size_t max) const
+{
+    std::vector<process::ExtractResult<size_t>> results;
+    auto s1 = detail::make_range(query);
+    size_t len1 = s1.size();
+
+    /* the distance to the empty string is the length of the word */
+    if (len1 == 0) {
+        std::vector<std::pair<size_t, size_t>> stack = {{0, 0}};
+        while (!stack.empty()) {
+            size_t node = stack.back().first;
+            size_t depth = stack.back().second;
+            stack.pop_back();
+            for (size_t index : nodes[node].indices)
+                results.push_back({depth, index});
+            if (depth == max) continue;
+            for (const auto& child : nodes[node].children)
+                stack.emplace_back(child.second, depth + 1);
+        }
+
+        std::sort(results.begin(), results.end(), index_detail::result_less);
+        return results;
+    }
+
+    detail::BlockPatternMatchVector PM(s1);
+    uint64_t Last = UINT64_C(1) << ((len1 - 1) % 64);
+
+    /* state of Hyyrö's algorithm after depth characters. VP is set to 1^m */
+    std::vector<std::vector<detail::LevenshteinRow>> states(1);
+    states[0].resize(PM.size());
+    std::vector<size_t> dists = {len1};
+
+    for (size_t index : nodes[0].indices)
+        if (len1 <= max) results.push_back({len1, index});
+
+    struct StackEntry {
+        size_t node;
+        size_t depth;
+        CharT1 ch; /**< character of the edge leading to node */
+    };
+
+    std::vector<StackEntry> stack;
+    for (const auto& child : nodes[0].children)
+        stack.push_back({child.second, 1, child.first});
+
+    while (!stack.empty()) {
+        StackEntry entry = stack.back();
+        stack.pop_back();
+        size_t depth = entry.depth;
+
+        /* the parent state is stored at depth - 1. Deeper states belong to
+         * subtrees which were already processed and can be overwritten */
+        if (dists.size() < depth + 1) {
+            states.resize(depth + 1);
+            dists.resize(depth + 1);
+        }
+
+        states[depth] = states[depth - 1];
+        size_t dist = dists[depth - 1];
+        dist = detail::levenshtein_hyrroe2003_step(PM, Last, states[depth], dist, entry.ch, 1);
+        dists[depth] = dist;
+
+        if (dist <= max)
+            for (size_t index : nodes[entry.node].indices)
+                results.push_back({dist, index});
+
+        if (column_min(states[depth], len1, depth, max) > max) continue;
+        for (const auto& child : nodes[entry.node].children)
+            stack.push_back({child.second, depth + 1, child.first});
+    }
+
+    std::sort(results.begin(), results.end(), index_detail::result_less);
+    return results;
+}
+
+} // namespace index
+} // namespace rapidfuzz
@@ -0,0 +1,337 @@
+/* SPDX-License-Identifier: MIT */
+/* Copyright © 2022-present Max Bachmann */
+
+#pragma once
+#include <rapidfuzz/details/common.hpp>
+#include <rapidfuzz/details/parallel.hpp>
+#include <rapidfuzz/details/simd.hpp>
+#include <rapidfuzz/details/type_traits.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace rapidfuzz {
+namespace process {
+
+/**
+ * @defgroup Process Process
+ * Helpers to compare many strings with each other using the cached scorers
+ * @{
+ */
+
+/**
+ * @brief selects which member function of a cached scorer is used to
+ * calculate the scores
+ */
+enum class ScoreMethod {
+    Similarity,           /**< similarity() */
+    Distance,             /**< distance() */
+    NormalizedSimilarity, /**< normalized_similarity() */
+    NormalizedDistance    /**< normalized_distance() */
+};
+
+namespace process_detail {
+
+/* marker used when the scorer should fall back to its default score_cutoff */
+struct NoScoreCutoff {};
+
+template <ScoreMethod Method>
+struct ScoreMethodImpl;
+
+#define RAPIDFUZZ_PROCESS_SCORE_METHOD(METHOD, FUNC, HIGHER_IS_BETTER, WORST_SCORE)                          \
+    template <>                                                                                              \
+    struct ScoreMethodImpl<ScoreMethod::METHOD> {                                                            \
+        template <typename Scorer, typename Sentence>                                                        \
+        static auto call(const Scorer& scorer, const Sentence& s2, NoScoreCutoff)                            \
+            -> decltype(scorer.FUNC(s2))                                                                     \
+        {                                                                                                    \
+            return scorer.FUNC(s2);                                                                          \
+        }                                                                                                    \
+                                                                                                             \
+        template <typename Scorer, typename Sentence, typename ScoreT>                                       \
+        static auto call(const Scorer& scorer, const Sentence& s2, ScoreT score_cutoff)                      \
+            -> decltype(scorer.FUNC(s2, score_cutoff))                                                       \
+        {                                                                                                    \
+            return scorer.FUNC(s2, score_cutoff);                                                            \
+        }                                                                                                    \
+                                                                                                             \
+        template <typename Scorer, typename Sentence, typename ScoreT>                                       \
+        static auto call(const Scorer& scorer, const Sentence& s2, ScoreT score_cutoff, ScoreT score_hint)   \
+            -> decltype(scorer.FUNC(s2, score_cutoff, score_hint))                                           \
+        {                                                                                                    \
+            return scorer.FUNC(s2, score_cutoff, score_hint);                                                \
+        }                                                                                                    \
+                                                                                                             \
+        template <typename Scorer, typename ResType, typename Sentence>                                      \
+        static void call_multi(const Scorer& scorer, ResType* scores, size_t score_count,                    \
+                               const Sentence& s2, NoScoreCutoff)                                            \
+        {                                                                                                    \
+            scorer.FUNC(scores, score_count, s2);                                                            \
+        }                                                                                                    \
+                                                                                                             \
+        template <typename Scorer, typename ResType, typename Sentence, typename ScoreT>                     \
+        static void call_multi(const Scorer& scorer, ResType* scores, size_t score_count,                    \
+                               const Sentence& s2, ScoreT score_cutoff)                                      \
+        {                                                                                                    \
+            scorer.FUNC(scores, score_count, s2, score_cutoff);                                              \
+        }                                                                                                    \
+                                                                                                             \
+        static constexpr bool higher_is_better = HIGHER_IS_BETTER;                                           \
+                                                                                                             \
+        /* score_cutoff which keeps every result */                                                          \
+        template <typename ScoreT>                                                                           \
+        static ScoreT worst_score()                                                                          \
+        {                                                                                                    \
+            return WORST_SCORE;                                                                              \
+        }                                                                                                    \
+    };
+
+RAPIDFUZZ_PROCESS_SCORE_METHOD(Similarity, similarity, true, ScoreT(0))
+RAPIDFUZZ_PROCESS_SCORE_METHOD(Distance, distance, false, std::numeric_limits<ScoreT>::max())
+RAPIDFUZZ_PROCESS_SCORE_METHOD(NormalizedSimilarity, normalized_similarity, true, ScoreT(0))
+RAPIDFUZZ_PROCESS_SCORE_METHOD(NormalizedDistance, normalized_distance, false, ScoreT(1))
+
+#undef RAPIDFUZZ_PROCESS_SCORE_METHOD
+
+/* type of the scores returned by Scorer when comparing it with Sentence2 */
+template <typename Scorer, ScoreMethod Method, typename Sentence2>
+using scorer_result_t = typename std::decay<decltype(ScoreMethodImpl<Method>::call(
+    std::declval<const Scorer&>(), std::declval<const Sentence2&>(), NoScoreCutoff()))>::type;
+
+/* type of the scores returned by the scorer */
+template <template <typename> class CachedScorer, ScoreMethod Method, typename Sentence, typename Choices>
+using score_t =
+    scorer_result_t<CachedScorer<char_type<Sentence>>, Method,
+                    typename std::decay<decltype(*std::begin(std::declval<const Choices&>()))>::type>;
+
+} // namespace process_detail
+
+/**
+ * @brief calculates the scores between every query and every choice
+ *
+ * @details
+ * The cached scorer is only built once per query and then reused for all choices.
+ * The queries are distributed over the worker threads, so each worker writes
+ * a distinct set of rows into the result matrix.
+ *
+ * @code{.cpp}
+ * std::vector<std::string> queries = {"new york mets", "atlanta braves"};
+ * std::vector<std::string> choices = {"new york yankees", "new york mets", "atlanta"};
+ *
+ * std::vector<double> ratios(queries.size() * choices.size());
+ * cdist<fuzz::CachedRatio>(ratios.data(), ratios.size(), queries, choices);
+ *
+ * // Levenshtein distances with all cores, everything above 3 is reported as 4
+ * std::vector<uint8_t> distances(queries.size() * choices.size());
+ * cdist<CachedLevenshtein, ScoreMethod::Distance>(distances.data(), distances.size(), queries, choices,
+ *                                                 -1, size_t(3));
+ * @endcode
+ *
+ * @tparam CachedScorer cached scorer template like fuzz::CachedRatio or CachedLevenshtein
+ * @tparam Method member function of the scorer used to calculate the scores
+ * @tparam ResultType element type of the result matrix. Floating point scores are
+ * rounded when stored in integral types and integral types saturate at their maximum
+ *
+ * @param scores row-major result matrix with queries.size() rows and choices.size() columns
+ * @param score_count number of elements in scores
+ * @param queries random access range of strings
+ * @param choices random access range of strings
+ * @param workers number of threads used. Values < 1 use all available cores
+ * @param score_cutoff score_cutoff passed to the scorer. When it is omitted
+ * the default score_cutoff of the scorer is used
+ * @param args additional arguments passed to the constructor of the cached scorer
+ * (e.g. LevenshteinWeightTable for CachedLevenshtein)
+ *
+ * @throws std::invalid_argument when scores has less than queries.size() * choices.size() elements
+ */
+template <template <typename> class CachedScorer, ScoreMethod Method = ScoreMethod::Similarity,
+          typename ResultType, typename Queries, typename Choices>
+void cdist(ResultType* scores, size_t score_count, const Queries& queries, const Choices& choices,
+           int workers = 1);
+
+template <template <typename> class CachedScorer, ScoreMethod Method = ScoreMethod::Similarity,
+          typename ResultType, typename Queries, typename Choices, typename ScoreT, typename... Args>
+void cdist(ResultType* scores, size_t score_count, const Queries& queries, const Choices& choices,
+           int workers, ScoreT score_cutoff, const Args&... args);
+
+/**
+ * @brief result of extract and extractOne
+ */
+template <typename ScoreT>
+struct ExtractResult {
+    ScoreT score; /**< score of the choice */
+    size_t index; /**< position of the choice in choices */
+
+    /**
+     * @brief returns false when extractOne did not find a choice which reaches the score_cutoff
+     */
+    bool found() const
+    {
+        return index != std::numeric_limits<size_t>::max();
+    }
+};
+
+/**
+ * @brief finds the `limit` best matches of query in choices
+ *
+ * @details
+ * The results are kept in a bounded heap. As soon as `limit` results are found the
+ * score of the worst result is passed to the scorer as score_cutoff and score_hint,
+ * so the scorer can exit early for choices which could not be part of the result.
+ *
+ * @code{.cpp}
+ * std::vector<std::string> choices = {"new york yankees", "new york mets", "atlanta"};
+ *
+ * // {{100, 1}, {75.86, 0}}
+ * auto ratios = extract<fuzz::CachedRatio>("new york mets", choices, 2);
+ *
+ * // {{0, 1}, {5, 0}}
+ * auto distances = extract<CachedLevenshtein, ScoreMethod::Distance>("new york mets", choices, 2);
+ * @endcode
+ *
+ * @tparam CachedScorer cached scorer template like fuzz::CachedRatio or CachedLevenshtein
+ * @tparam Method member function of the scorer used to calculate the scores
+ *
+ * @param query string to search for
+ * @param choices range of strings
+ * @param limit maximum number of results
+ * @param score_cutoff only choices reaching this score are returned. When it is
+ * omitted every choice can be part of the result
+ * @param args additional arguments passed to the constructor of the cached scorer
+ *
+ * @return the best results sorted by score. Choices with the same score are sorted by index
+ */
+template <template <typename> class CachedScorer, ScoreMethod Method = ScoreMethod::Similarity,
+          typename Sentence, typename Choices>
+std::vector<ExtractResult<process_detail::score_t<CachedScorer, Method, Sentence, Choices>>>
+extract(const Sentence& query, const Choices& choices, size_t limit);
+
+template <template <typename> class CachedScorer, ScoreMethod Method = ScoreMethod::Similarity,
+          typename Sentence, typename Choices, typename ScoreT, typename... Args>
+std::vector<ExtractResult<process_detail::score_t<CachedScorer, Method, Sentence, Choices>>>
+extract(const Sentence& query, const Choices& choices, size_t limit, ScoreT score_cutoff,
+        const Args&... args);
+
+/**
+ * @brief finds the best match of query in choices
+ *
+ * @details
+ * The score of the best match so far is used as score_cutoff for the remaining choices.
+ * When multiple choices have the same score, the first one is returned.
+ *
+ * @return the best result. When no choice reaches the score_cutoff, found() returns false
+ */
+template <template <typename> class CachedScorer, ScoreMethod Method = ScoreMethod::Similarity,
+          typename Sentence, typename Choices>
+ExtractResult<process_detail::score_t<CachedScorer, Method, Sentence, Choices>>
+extractOne(const Sentence& query, const Choices& choices);
+
+template <template <typename> class CachedScorer, ScoreMethod Method = ScoreMethod::Similarity,
+          typename Sentence, typename Choices, typename ScoreT, typename... Args>
+ExtractResult<process_detail::score_t<CachedScorer, Method, Sentence, Choices>>
+extractOne(const Sentence& query, const Choices& choices, ScoreT score_cutoff, const Args&... args);
+
+#ifdef RAPIDFUZZ_SIMD
+namespace experimental {
+
+/**
+ * @brief scores strings against a fixed list of choices using the SIMD based Multi* scorers
+ *
+ * @details
+ * The choices are grouped by their length into buckets for strings with up to 8, 16, 32
+ * and 64 characters. Each bucket is scored using the matching MultiScorer<MaxLen>.
+ * Choices with more than 64 characters are scored using CachedScorer.
+ * Since the choices are preprocessed once, this is useful when many strings are compared
+ * with the same list of short choices.
+ *
+ * @code{.cpp}
+ * std::vector<std::string> choices = {"new york yankees", "new york mets", "atlanta"};
+ * BulkScorer<rapidfuzz::experimental::MultiLevenshtein, CachedLevenshtein, char> scorer(choices);
+ *
+ * std::vector<size_t> distances(scorer.size());
+ * // {5, 0, 12}
+ * scorer.score<ScoreMethod::Distance>(distances.data(), distances.size(), "new york mets");
+ * @endcode
+ *
+ * @tparam MultiScorer Multi* scorer template like rapidfuzz::experimental::MultiLevenshtein
+ * @tparam CachedScorer cached scorer template matching MultiScorer like CachedLevenshtein
+ * @tparam CharT1 character type of the choices
+ */
+template <template <int> class MultiScorer, template <typename> class CachedScorer, typename CharT1>
+class BulkScorer {
+public:
+    /**
+     * @param choices range of strings
+     * @param args additional arguments passed to the constructors of MultiScorer and CachedScorer
+     * (e.g. LevenshteinWeightTable)
+     */
+    template <typename Choices, typename... Args>
+    explicit BulkScorer(const Choices& choices, const Args&... args);
+
+    /**
+     * @brief number of choices. This is the minimum size of the result vector passed into score
+     */
+    size_t size() const
+    {
+        return choice_count;
+    }
+
+    /**
+     * @brief calculates the scores between s2 and all choices
+     *
+     * @param scores result vector. The score of each choice is stored at the position of the choice
+     * @param score_count number of elements in scores
+     * @param s2 string to compare with the choices
+     * @param score_cutoff score_cutoff passed to the scorers. When it is omitted
+     * the default score_cutoff of the scorers is used
+     *
+     * @throws std::invalid_argument when scores has less than size() elements
+     */
+    template <ScoreMethod Method = ScoreMethod::Similarity, typename ResultType, typename Sentence2>
+    void score(ResultType* scores, size_t score_count, const Sentence2& s2) const;
+
+    template <ScoreMethod Method = ScoreMethod::Similarity, typename ResultType, typename Sentence2,
+              typename ScoreT>
+    void score(ResultType* scores, size_t score_count, const Sentence2& s2, ScoreT score_cutoff) const;
+
+private:
+    template <int MaxLen>
+    struct Bucket {
+        std::unique_ptr<MultiScorer<MaxLen>> scorer;
+        std::vector<size_t> indices;
+    };
+
+    template <int MaxLen, typename... Args>
+    static void init_bucket(Bucket<MaxLen>& bucket, const Args&... args);
+
+    template <ScoreMethod Method, typename BufferType, int MaxLen, typename ResultType, typename Sentence2,
+              typename ScoreT>
+    static void score_bucket(const Bucket<MaxLen>& bucket, std::vector<BufferType>& buffer,
+                             ResultType* scores, const Sentence2& s2, ScoreT score_cutoff);
+
+    template <ScoreMethod Method, typename ResultType, typename Sentence2, typename ScoreT>
+    void _score(ResultType* scores, size_t score_count, const Sentence2& s2, ScoreT score_cutoff) const;
+
+    size_t choice_count;
+    Bucket<8> bucket8;
+    Bucket<16> bucket16;
+    Bucket<32> bucket32;
+    Bucket<64> bucket64;
+    /* choices longer than 64 characters */
+    std::vector<size_t> long_indices;
+    std::vector<std::unique_ptr<CachedScorer<CharT1>>> long_scorers;
+};
+
+} /* namespace experimental */
+#endif /* RAPIDFUZZ_SIMD */
+
+/**@}*/
+
+} // namespace process
+} // namespace rapidfuzz
+
+#include <rapidfuzz/process_impl.hpp>
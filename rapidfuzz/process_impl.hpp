@@ -0,0 +1,326 @@
+/* SPDX-License-Identifier: MIT */
+/* Copyright © 2022-present Max Bachmann */
+
+#include <rapidfuzz/details/type_traits.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace rapidfuzz {
+namespace process {
+namespace process_detail {
+
+/* floating point results only need a conversion */
+template <typename ResultType, typename T>
+rf_enable_if_t<std::is_floating_point<ResultType>::value, ResultType> score_cast(T score)
+{
+    return static_cast<ResultType>(score);
+}
+
+/* floating point scores are rounded and saturate at the limits of the result type */
+template <typename ResultType, typename T>
+rf_enable_if_t<std::is_integral<ResultType>::value && std::is_floating_point<T>::value, ResultType>
+score_cast(T score)
+{
+    T rounded = std::round(score);
+    if (rounded <= static_cast<T>(std::numeric_limits<ResultType>::min()))
+        return std::numeric_limits<ResultType>::min();
+    if (rounded >= static_cast<T>(std::numeric_limits<ResultType>::max()))
+        return std::numeric_limits<ResultType>::max();
+    return static_cast<ResultType>(rounded);
+}
+
+/* the scores of the integral scorers are never negative, so only the upper limit is relevant */
+template <typename ResultType, typename T>
+rf_enable_if_t<std::is_integral<ResultType>::value && std::is_integral<T>::value, ResultType>
+score_cast(T score)
+{
+    using Common = typename std::common_type<typename std::make_unsigned<ResultType>::type,
+                                             typename std::make_unsigned<T>::type>::type;
+    if (static_cast<Common>(score) > static_cast<Common>(std::numeric_limits<ResultType>::max()))
+        return std::numeric_limits<ResultType>::max();
+    return static_cast<ResultType>(score);
+}
+
+template <template <typename> class CachedScorer, ScoreMethod Method, typename ResultType, typename Queries,
+          typename Choices, typename ScoreT, typename... Args>
+void cdist_impl(ResultType* scores, size_t score_count, const Queries& queries, const Choices& choices,
+                int workers, ScoreT score_cutoff, const Args&... args)
+{
+    using QuerySentence = typename std::decay<decltype(*std::begin(queries))>::type;
+    using Scorer = CachedScorer<char_type<QuerySentence>>;
+
+    auto queries_first = std::begin(queries);
+    auto choices_first = std::begin(choices);
+    auto rows = static_cast<size_t>(std::distance(queries_first, std::end(queries)));
+    auto cols = static_cast<size_t>(std::distance(choices_first, std::end(choices)));
+
+    if (cols != 0 && score_count / cols < rows)
+        throw std::invalid_argument("scores has to have >= queries.size() * choices.size() elements");
+
+    if (cols == 0) return;
+
+    detail::parallel_for(workers, rows, [&](size_t row) {
+        Scorer scorer(queries_first[static_cast<ptrdiff_t>(row)], args...);
+        ResultType* row_scores = scores + row * cols;
+
+        for (size_t col = 0; col < cols; ++col)
+            row_scores[col] = score_cast<ResultType>(ScoreMethodImpl<Method>::call(
+                scorer, choices_first[static_cast<ptrdiff_t>(col)], score_cutoff));
+    });
+}
+
+template <template <typename> class CachedScorer, ScoreMethod Method, typename Sentence, typename Choices,
+          typename... Args>
+std::vector<ExtractResult<score_t<CachedScorer, Method, Sentence, Choices>>>
+extract_impl(const Sentence& query, const Choices& choices, size_t limit,
+             score_t<CachedScorer, Method, Sentence, Choices> score_cutoff, const Args&... args)
+{
+    using MethodImpl = ScoreMethodImpl<Method>;
+    using Result = ExtractResult<score_t<CachedScorer, Method, Sentence, Choices>>;
+
+    /* orders by score and afterwards by index, so the heap always pops the worst result */
+    auto is_better = [](const Result& a, const Result& b) {
+        if (a.score != b.score) return MethodImpl::higher_is_better ? a.score > b.score : a.score < b.score;
+        return a.index < b.index;
+    };
+
+    std::vector<Result> results;
+    if (limit == 0) return results;
+
+    CachedScorer<char_type<Sentence>> scorer(query, args...);
+    size_t index = 0;
+    for (auto it = std::begin(choices); it != std::end(choices); ++it, ++index) {
+        Result result;
+        result.index = index;
+        /* once the heap is full only results better than the worst one are relevant.
+         * Its score is the best available guess for the score of the next choice as well */
+        if (results.size() < limit)
+            result.score = MethodImpl::call(scorer, *it, score_cutoff);
+        else
+            result.score = MethodImpl::call(scorer, *it, score_cutoff, score_cutoff);
+
+        bool passes_cutoff =
+            MethodImpl::higher_is_better ? result.score >= score_cutoff : result.score <= score_cutoff;
+        if (!passes_cutoff) continue;
+
+        if (results.size() < limit) {
+            results.push_back(result);
+            std::push_heap(results.begin(), results.end(), is_better);
+        }
+        else if (is_better(result, results.front())) {
+            std::pop_heap(results.begin(), results.end(), is_better);
+            results.back() = result;
+            std::push_heap(results.begin(), results.end(), is_better);
+        }
+        else
+            continue;
+
+        if (results.size() == limit) {
+            score_cutoff = results.front().score;
+            /* a distance of 0 can not be improved upon */
+            if (!MethodImpl::higher_is_better && score_cutoff == 0) break;
+        }
+    }
+
+    std::sort_heap(results.begin(), results.end(), is_better);
+    return results;
+}
+
+template <template <typename> class CachedScorer, ScoreMethod Method, typename Sentence, typename Choices,
+          typename... Args>
+ExtractResult<score_t<CachedScorer, Method, Sentence, Choices>>
+extractOne_impl(const Sentence& query, const Choices& choices,
+                score_t<CachedScorer, Method, Sentence, Choices> score_cutoff, const Args&... args)
+{
+    auto results = extract_impl<CachedScorer, Method>(query, choices, 1, score_cutoff, args...);
+    if (!results.empty()) return results.front();
+
+    ExtractResult<score_t<CachedScorer, Method, Sentence, Choices>> result;
+    result.score = score_cutoff;
+    result.index = std::numeric_limits<size_t>::max();
+    return result;
+}
+
+} // namespace process_detail
+
+template <template <typename> class CachedScorer, ScoreMethod Method, typename ResultType, typename Queries,
+          typename Choices>
+void cdist(ResultType* scores, size_t score_count, const Queries& queries, const Choices& choices,
+           int workers)
+{
+    process_detail::cdist_impl<CachedScorer, Method>(scores, score_count, queries, choices, workers,
+                                                     process_detail::NoScoreCutoff());
+}
+
+template <template <typename> class CachedScorer, ScoreMethod Method, typename ResultType, typename Queries,
+          typename Choices, typename ScoreT, typename... Args>
+void cdist(ResultType* scores, size_t score_count, const Queries& queries, const Choices& choices,
+           int workers, ScoreT score_cutoff, const Args&... args)
+{
+    process_detail::cdist_impl<CachedScorer, Method>(scores, score_count, queries, choices, workers,
+                                                     score_cutoff, args...);
+}
+
+template <template <typename> class CachedScorer, ScoreMethod Method, typename Sentence, typename Choices>
+std::vector<ExtractResult<process_detail::score_t<CachedScorer, Method, Sentence, Choices>>>
+extract(const Sentence& query, const Choices& choices, size_t limit)
+{
+    using ScoreT = process_detail::score_t<CachedScorer, Method, Sentence, Choices>;
+    return process_detail::extract_impl<CachedScorer, Method>(
+        query, choices, limit, process_detail::ScoreMethodImpl<Method>::template worst_score<ScoreT>());
+}
+
+template <template <typename> class CachedScorer, ScoreMethod Method, typename Sentence, typename Choices,
+          typename ScoreT, typename... Args>
+std::vector<ExtractResult<process_detail::score_t<CachedScorer, Method, Sentence, Choices>>>
+extract(const Sentence& query, const Choices& choices, size_t limit, ScoreT score_cutoff, const Args&... args)
+{
+    using ResScoreT = process_detail::score_t<CachedScorer, Method, Sentence, Choices>;
+    return process_detail::extract_impl<CachedScorer, Method>(query, choices, limit,
+                                                              static_cast<ResScoreT>(score_cutoff), args...);
+}
+
+template <template <typename> class CachedScorer, ScoreMethod Method, typename Sentence, typename Choices>
+ExtractResult<process_detail::score_t<CachedScorer, Method, Sentence, Choices>>
+extractOne(const Sentence& query, const Choices& choices)
+{
+    using ScoreT = process_detail::score_t<CachedScorer, Method, Sentence, Choices>;
+    return process_detail::extractOne_impl<CachedScorer, Method>(
+        query, choices, process_detail::ScoreMethodImpl<Method>::template worst_score<ScoreT>());
+}
+
+template <template <typename> class CachedScorer, ScoreMethod Method, typename Sentence, typename Choices,
+          typename ScoreT, typename... Args>
+ExtractResult<process_detail::score_t<CachedScorer, Method, Sentence, Choices>>
+extractOne(const Sentence& query, const Choices& choices, ScoreT score_cutoff, const Args&... args)
+{
+    using ResScoreT = process_detail::score_t<CachedScorer, Method, Sentence, Choices>;
+    return process_detail::extractOne_impl<CachedScorer, Method>(
+        query, choices, static_cast<ResScoreT>(score_cutoff), args...);
+}
+
+#ifdef RAPIDFUZZ_SIMD
+namespace experimental {
+
+template <template <int> class MultiScorer, template <typename> class CachedScorer, typename CharT1>
+template <typename Choices, typename... Args>
+BulkScorer<MultiScorer, CachedScorer, CharT1>::BulkScorer(const Choices& choices, const Args&... args)
+    : choice_count(0)
+{
+    /* the Multi* scorers need to know the amount of strings upfront. So the buckets are
+     * determined first and the strings are inserted in a second pass */
+    std::vector<uint8_t> bucket_ids;
+    for (const auto& choice : choices) {
+        auto len = static_cast<size_t>(std::distance(detail::to_begin(choice), detail::to_end(choice)));
+        if (len <= 8) {
+            bucket8.indices.push_back(choice_count);
+            bucket_ids.push_back(0);
+        }
+        else if (len <= 16) {
+            bucket16.indices.push_back(choice_count);
+            bucket_ids.push_back(1);
+        }
+        else if (len <= 32) {
+            bucket32.indices.push_back(choice_count);
+            bucket_ids.push_back(2);
+        }
+        else if (len <= 64) {
+            bucket64.indices.push_back(choice_count);
+            bucket_ids.push_back(3);
+        }
+        else {
+            long_indices.push_back(choice_count);
+            long_scorers.emplace_back(new CachedScorer<CharT1>(choice, args...));
+            bucket_ids.push_back(4);
+        }
+        choice_count++;
+    }
+
+    init_bucket(bucket8, args...);
+    init_bucket(bucket16, args...);
+    init_bucket(bucket32, args...);
+    init_bucket(bucket64, args...);
+
+    size_t i = 0;
+    for (const auto& choice : choices) {
+        switch (bucket_ids[i++]) {
+        case 0: bucket8.scorer->insert(choice); break;
+        case 1: bucket16.scorer->insert(choice); break;
+        case 2: bucket32.scorer->insert(choice); break;
+        case 3: bucket64.scorer->insert(choice); break;
+        default: break;
+        }
+    }
+}
+
+template <template <int> class MultiScorer, template <typename> class CachedScorer, typename CharT1>
+template <int MaxLen, typename... Args>
+void BulkScorer<MultiScorer, CachedScorer, CharT1>::init_bucket(Bucket<MaxLen>& bucket, const Args&... args)
+{
+    if (!bucket.indices.empty()) bucket.scorer.reset(new MultiScorer<MaxLen>(bucket.indices.size(), args...));
+}
+
+template <template <int> class MultiScorer, template <typename> class CachedScorer, typename CharT1>
+template <ScoreMethod Method, typename BufferType, int MaxLen, typename ResultType, typename Sentence2,
+          typename ScoreT>
+void BulkScorer<MultiScorer, CachedScorer, CharT1>::score_bucket(const Bucket<MaxLen>& bucket,
+                                                                 std::vector<BufferType>& buffer,
+                                                                 ResultType* scores, const Sentence2& s2,
+                                                                 ScoreT score_cutoff)
+{
+    if (!bucket.scorer) return;
+
+    buffer.resize(bucket.scorer->result_count());
+    process_detail::ScoreMethodImpl<Method>::call_multi(*bucket.scorer, buffer.data(), buffer.size(), s2,
+                                                        score_cutoff);
+
+    for (size_t i = 0; i < bucket.indices.size(); ++i)
+        scores[bucket.indices[i]] = process_detail::score_cast<ResultType>(buffer[i]);
+}
+
+template <template <int> class MultiScorer, template <typename> class CachedScorer, typename CharT1>
+template <ScoreMethod Method, typename ResultType, typename Sentence2, typename ScoreT>
+void BulkScorer<MultiScorer, CachedScorer, CharT1>::_score(ResultType* scores, size_t score_count,
+                                                           const Sentence2& s2, ScoreT score_cutoff) const
+{
+    if (score_count < choice_count) throw std::invalid_argument("scores has to have >= size() elements");
+
+    using BufferType = process_detail::scorer_result_t<CachedScorer<CharT1>, Method, Sentence2>;
+    std::vector<BufferType> buffer;
+    score_bucket<Method>(bucket8, buffer, scores, s2, score_cutoff);
+    score_bucket<Method>(bucket16, buffer, scores, s2, score_cutoff);
+    score_bucket<Method>(bucket32, buffer, scores, s2, score_cutoff);
+    score_bucket<Method>(bucket64, buffer, scores, s2, score_cutoff);
+
+    for (size_t i = 0; i < long_indices.size(); ++i)
+        scores[long_indices[i]] = process_detail::score_cast<ResultType>(
+            process_detail::ScoreMethodImpl<Method>::call(*long_scorers[i], s2, score_cutoff));
+}
+
+template <template <int> class MultiScorer, template <typename> class CachedScorer, typename CharT1>
+template <ScoreMethod Method, typename ResultType, typename Sentence2>
+void BulkScorer<MultiScorer, CachedScorer, CharT1>::score(ResultType* scores, size_t score_count,
+                                                          const Sentence2& s2) const
+{
+    _score<Method>(scores, score_count, s2, process_detail::NoScoreCutoff());
+}
+
+template <template <int> class MultiScorer, template <typename> class CachedScorer, typename CharT1>
+template <ScoreMethod Method, typename ResultType, typename Sentence2, typename ScoreT>
+void BulkScorer<MultiScorer, CachedScorer, CharT1>::score(ResultType* scores, size_t score_count,
+                                                          const Sentence2& s2, ScoreT score_cutoff) const
+{
+    _score<Method>(scores, score_count, s2, score_cutoff);
+}
+
+} /* namespace experimental */
+#endif /* RAPIDFUZZ_SIMD */
+
+} // namespace process
+} // namespace rapidfuzz
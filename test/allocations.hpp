@@ -0,0 +1,83 @@
+#pragma once
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <stdint.h>
+
+/*
+ * Replaces the global operator new/delete with versions counting the allocations and the allocated
+ * bytes. Since this defines the replacement functions, it may only be included by one translation unit
+ * of a program. It is used by the workspace tests and by bench_allocations. Buffers allocated using
+ * rf_aligned_alloc (e.g. by the SIMD implementation of Jaro for long strings) do not use operator new
+ * and are not counted.
+ */
+namespace allocations {
+
+struct Counts {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+};
+
+inline std::atomic<uint64_t>& allocation_counter()
+{
+    static std::atomic<uint64_t> counter(0);
+    return counter;
+}
+
+inline std::atomic<uint64_t>& byte_counter()
+{
+    static std::atomic<uint64_t> counter(0);
+    return counter;
+}
+
+/* allocations made by all threads since the start of the program */
+inline Counts current()
+{
+    Counts counts;
+    counts.allocations = allocation_counter().load(std::memory_order_relaxed);
+    counts.bytes = byte_counter().load(std::memory_order_relaxed);
+    return counts;
+}
+
+} // namespace allocations
+
+/* GCC warns about a mismatched free when it inlines the replaced operator delete into a caller, whose
+ * pointer comes from the replaced operator new */
+#if defined(__GNUC__)
+#    define ALLOCATIONS_NOINLINE __attribute__((noinline))
+#else
+#    define ALLOCATIONS_NOINLINE
+#endif
+
+void* operator new(size_t size)
+{
+    allocations::allocation_counter().fetch_add(1, std::memory_order_relaxed);
+    allocations::byte_counter().fetch_add(size, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+
+ALLOCATIONS_NOINLINE void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+ALLOCATIONS_NOINLINE void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+ALLOCATIONS_NOINLINE void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+ALLOCATIONS_NOINLINE void operator delete[](void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
@@ -1,4 +1,9 @@
 #pragma once
+#include <cstring>
+#include <sstream>
+#include <stdint.h>
+#include <string>
+#include <vector>
 
 template <typename T>
 class BidirectionalIterWrapper {
@@ -73,3 +78,15 @@ std::basic_string<T> str_multiply(std::basic_string<T> a, size_t b)
 
     return output;
 }
+
+/* serializes the scorer into an 8 byte aligned buffer, like a memory mapped file */
+template <typename Scorer>
+std::vector<uint64_t> serialize_scorer(const Scorer& scorer)
+{
+    std::ostringstream out;
+    scorer.serialize(out);
+    std::string data = out.str();
+    std::vector<uint64_t> buffer((data.size() + 7) / 8);
+    if (!data.empty()) std::memcpy(buffer.data(), data.data(), data.size());
+    return buffer;
+}
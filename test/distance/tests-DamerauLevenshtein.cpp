@@ -9,6 +9,7 @@
 #include <rapidfuzz/details/types.hpp>
 #include <string>
 
+#include "../../rapidfuzz_reference/DamerauLevenshtein.hpp"
 #include <rapidfuzz/distance/DamerauLevenshtein.hpp>
 
 #include "../common.hpp"
@@ -27,6 +28,39 @@ size_t damerau_levenshtein_distance(const Sentence1& s1, const Sentence2& s2,
     rapidfuzz::experimental::CachedDamerauLevenshtein<rapidfuzz::char_type<Sentence1>> scorer(s1);
     size_t res4 = scorer.distance(s2, max);
     size_t res5 = scorer.distance(s2.begin(), s2.end(), max);
+    auto compact_scorer = scorer;
+    compact_scorer.shrink_to_fit();
+    REQUIRE(compact_scorer.distance(s2, max) == res4);
+#ifdef RAPIDFUZZ_SIMD
+    if (s1.size() <= 64) {
+        std::vector<size_t> results(512 / 8);
+
+        if (s1.size() <= 8) {
+            rapidfuzz::experimental::MultiDamerauLevenshtein<8> simd_scorer(1);
+            simd_scorer.insert(s1);
+            simd_scorer.distance(&results[0], results.size(), s2, max);
+            REQUIRE(res1 == results[0]);
+        }
+        if (s1.size() <= 16) {
+            rapidfuzz::experimental::MultiDamerauLevenshtein<16> simd_scorer(1);
+            simd_scorer.insert(s1);
+            simd_scorer.distance(&results[0], results.size(), s2, max);
+            REQUIRE(res1 == results[0]);
+        }
+        if (s1.size() <= 32) {
+            rapidfuzz::experimental::MultiDamerauLevenshtein<32> simd_scorer(1);
+            simd_scorer.insert(s1);
+            simd_scorer.distance(&results[0], results.size(), s2, max);
+            REQUIRE(res1 == results[0]);
+        }
+        if (s1.size() <= 64) {
+            rapidfuzz::experimental::MultiDamerauLevenshtein<64> simd_scorer(1);
+            simd_scorer.insert(s1);
+            simd_scorer.distance(&results[0], results.size(), s2, max);
+            REQUIRE(res1 == results[0]);
+        }
+    }
+#endif
     REQUIRE(res1 == res2);
     REQUIRE(res1 == res3);
     REQUIRE(res1 == res4);
@@ -130,4 +164,76 @@ TEST_CASE("Levenshtein")
             REQUIRE_THAT(damerau_levenshtein_normalized_similarity(s1, s2), WithinAbs(0.33333, 0.0001));
         }
     }
+
+    SECTION("damerau levenshtein matches the reference implementation")
+    {
+        /* small alphabets lead to a lot of transpositions. The lengths cover both
+         * the single word and the block based OSA filter */
+        std::vector<std::string> strings;
+        for (size_t i = 0; i < 24; ++i) {
+            std::string s;
+            for (size_t j = 0; j < (i * 13) % 150; ++j)
+                s += static_cast<char>('a' + (i * 5 + j * j + j / 3) % (2 + i % 3));
+            strings.push_back(s);
+        }
+        strings.push_back("abcdef");
+        strings.push_back("badcfe");
+        strings.push_back("fedcba");
+
+        for (const auto& s1 : strings) {
+            for (const auto& s2 : strings) {
+                REQUIRE(damerau_levenshtein_distance(s1, s2) ==
+                        rapidfuzz_reference::damerau_levenshtein_distance(s1, s2));
+                for (size_t max : {size_t{0}, size_t{1}, size_t{2}, size_t{3}, size_t{5}, size_t{20}})
+                    REQUIRE(damerau_levenshtein_distance(s1, s2, max) ==
+                            rapidfuzz_reference::damerau_levenshtein_distance(s1, s2, max));
+            }
+        }
+    }
+
+    SECTION("non ASCII characters match in the cached and uncached scorers")
+    {
+        /* bytes >= 0x80 are negative for a signed char. The transpositions are between multi byte
+         * characters and between their bytes */
+        std::vector<std::string> strings = {"caf\xc3\xa9",           "cafe\xc3\xa9",
+                                            "ca\xc3\xa9" "f",         "\xe2\x82\xac\xc3\xa9",
+                                            "\xc3\xa9\xe2\x82\xac", "\xa9\xc3\xe2\x82\xac\xff",
+                                            "\xff\xfe\x80\x7f",     "\xfe\xff\x7f\x80"};
+
+        for (const auto& s1 : strings) {
+            for (const auto& s2 : strings) {
+                REQUIRE(damerau_levenshtein_distance(s1, s2) ==
+                        rapidfuzz_reference::damerau_levenshtein_distance(s1, s2));
+                REQUIRE(damerau_levenshtein_distance(s1, s2, 2) ==
+                        rapidfuzz_reference::damerau_levenshtein_distance(s1, s2, 2));
+            }
+        }
+    }
+
+#ifdef RAPIDFUZZ_SIMD
+    SECTION("MultiDamerauLevenshtein matches the reference implementation for many strings")
+    {
+        std::vector<std::string> strings;
+        for (size_t i = 0; i < 70; ++i) {
+            std::string s;
+            for (size_t j = 0; j < (i * 7) % 33; ++j)
+                s += static_cast<char>('a' + (i * 3 + j * j + j / 2) % (2 + i % 3));
+            strings.push_back(s);
+        }
+
+        rapidfuzz::experimental::MultiDamerauLevenshtein<32> simd_scorer(strings.size());
+        for (const auto& s : strings)
+            simd_scorer.insert(s);
+
+        std::vector<size_t> results(simd_scorer.result_count());
+        for (const auto& s2 : strings) {
+            for (size_t max : {size_t{0}, size_t{1}, size_t{2}, size_t{3}, size_t{5}, size_t{40}}) {
+                simd_scorer.distance(&results[0], results.size(), s2, max);
+                for (size_t i = 0; i < strings.size(); ++i)
+                    REQUIRE(results[i] ==
+                            rapidfuzz_reference::damerau_levenshtein_distance(strings[i], s2, max));
+            }
+        }
+    }
+#endif
 }
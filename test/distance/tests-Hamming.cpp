@@ -25,6 +25,36 @@ size_t hamming_distance(const Sentence1& s1, const Sentence2& s2,
     rapidfuzz::CachedHamming<rapidfuzz::char_type<Sentence1>> scorer(s1);
     size_t res4 = scorer.distance(s2, max);
     size_t res5 = scorer.distance(s2.begin(), s2.end(), max);
+#ifdef RAPIDFUZZ_SIMD
+    if (s1.size() <= 64) {
+        std::vector<size_t> results(512 / 8);
+
+        if (s1.size() <= 8) {
+            rapidfuzz::experimental::MultiHamming<8> simd_scorer(1);
+            simd_scorer.insert(s1);
+            simd_scorer.distance(&results[0], results.size(), s2);
+            REQUIRE(res1 == results[0]);
+        }
+        if (s1.size() <= 16) {
+            rapidfuzz::experimental::MultiHamming<16> simd_scorer(1);
+            simd_scorer.insert(s1);
+            simd_scorer.distance(&results[0], results.size(), s2);
+            REQUIRE(res1 == results[0]);
+        }
+        if (s1.size() <= 32) {
+            rapidfuzz::experimental::MultiHamming<32> simd_scorer(1);
+            simd_scorer.insert(s1);
+            simd_scorer.distance(&results[0], results.size(), s2);
+            REQUIRE(res1 == results[0]);
+        }
+        if (s1.size() <= 64) {
+            rapidfuzz::experimental::MultiHamming<64> simd_scorer(1);
+            simd_scorer.insert(s1);
+            simd_scorer.distance(&results[0], results.size(), s2);
+            REQUIRE(res1 == results[0]);
+        }
+    }
+#endif
     REQUIRE(res1 == res2);
     REQUIRE(res1 == res3);
     REQUIRE(res1 == res4);
@@ -107,6 +137,44 @@ TEST_CASE("Hamming")
         REQUIRE(hamming_distance(test, diff_len) == 1);
         REQUIRE(hamming_distance(diff_len, test) == 1);
     }
+
+#ifdef RAPIDFUZZ_SIMD
+    SECTION("MultiHamming matches the scalar implementation for many strings")
+    {
+        std::vector<std::string> strings;
+        for (size_t i = 0; i < 70; ++i) {
+            std::string s;
+            for (size_t j = 0; j < i % 17; ++j)
+                s += static_cast<char>('a' + (i + j * j) % 3);
+            strings.push_back(s);
+        }
+
+        rapidfuzz::experimental::MultiHamming<16> simd_scorer(strings.size());
+        for (const auto& s : strings)
+            simd_scorer.insert(s);
+
+        std::vector<size_t> results(simd_scorer.result_count());
+        for (const auto& s2 : strings) {
+            for (size_t max : {0, 1, 3, 20}) {
+                simd_scorer.distance(&results[0], results.size(), s2, max);
+                for (size_t i = 0; i < strings.size(); ++i)
+                    REQUIRE(results[i] == rapidfuzz::hamming_distance(strings[i], s2, true, max));
+            }
+        }
+    }
+
+    SECTION("MultiHamming throws for different lengths without padding")
+    {
+        rapidfuzz::experimental::MultiHamming<8> simd_scorer(2, false);
+        simd_scorer.insert(test);
+        simd_scorer.insert(diff_a);
+        std::vector<size_t> results(simd_scorer.result_count());
+        REQUIRE_THROWS_AS(simd_scorer.distance(&results[0], results.size(), diff_len), std::invalid_argument);
+        simd_scorer.distance(&results[0], results.size(), diff_b);
+        REQUIRE(results[0] == 1);
+        REQUIRE(results[1] == 2);
+    }
+#endif
 }
 
 TEST_CASE("Hamming_editops")
@@ -25,9 +25,12 @@ size_t indel_distance(const Sentence1& s1, const Sentence2& s2,
     rapidfuzz::CachedIndel<rapidfuzz::char_type<Sentence1>> scorer(s1);
     size_t res4 = scorer.distance(s2, max);
     size_t res5 = scorer.distance(s2.begin(), s2.end(), max);
+    auto compact_scorer = scorer;
+    compact_scorer.shrink_to_fit();
+    REQUIRE(compact_scorer.distance(s2, max) == res4);
 #ifdef RAPIDFUZZ_SIMD
-    if (s1.size() <= 64) {
-        std::vector<size_t> results(256 / 8);
+    if (s1.size() <= 256) {
+        std::vector<size_t> results(512 / 8);
 
         if (s1.size() <= 8) {
             rapidfuzz::experimental::MultiIndel<8> simd_scorer(1);
@@ -53,12 +56,34 @@ size_t indel_distance(const Sentence1& s1, const Sentence2& s2,
             simd_scorer.distance(&results[0], results.size(), s2, max);
             REQUIRE(res1 == results[0]);
         }
+        if (s1.size() <= 128) {
+            rapidfuzz::experimental::MultiIndel<128> simd_scorer(1);
+            simd_scorer.insert(s1);
+            simd_scorer.distance(&results[0], results.size(), s2, max);
+            REQUIRE(res1 == results[0]);
+        }
+        if (s1.size() <= 256) {
+            rapidfuzz::experimental::MultiIndel<256> simd_scorer(1);
+            simd_scorer.insert(s1);
+            simd_scorer.distance(&results[0], results.size(), s2, max);
+            REQUIRE(res1 == results[0]);
+        }
     }
 #endif
     REQUIRE(res1 == res2);
     REQUIRE(res1 == res3);
     REQUIRE(res1 == res4);
     REQUIRE(res1 == res5);
+
+    /* the state is advanced by a prefix and then by the remaining characters */
+    auto state = scorer.make_state();
+    auto mid = s2.begin() + static_cast<ptrdiff_t>(s2.size() / 2);
+    scorer.append(state, s2.begin(), mid);
+    scorer.append(state, mid, s2.end());
+    REQUIRE(state.length() == s2.size());
+    size_t res6 = state.distance();
+    if (res6 > max) res6 = max + 1;
+    REQUIRE(res6 == res1);
     return res1;
 }
 
@@ -73,8 +98,8 @@ size_t indel_similarity(const Sentence1& s1, const Sentence2& s2, size_t max = 0
     size_t res4 = scorer.similarity(s2, max);
     size_t res5 = scorer.similarity(s2.begin(), s2.end(), max);
 #ifdef RAPIDFUZZ_SIMD
-    if (s1.size() <= 64) {
-        std::vector<size_t> results(256 / 8);
+    if (s1.size() <= 256) {
+        std::vector<size_t> results(512 / 8);
 
         if (s1.size() <= 8) {
             rapidfuzz::experimental::MultiIndel<8> simd_scorer(1);
@@ -91,11 +116,21 @@ size_t indel_similarity(const Sentence1& s1, const Sentence2& s2, size_t max = 0
             simd_scorer.insert(s1);
             simd_scorer.similarity(&results[0], results.size(), s2, max);
         }
-        else {
+        else if (s1.size() <= 64) {
             rapidfuzz::experimental::MultiIndel<64> simd_scorer(1);
             simd_scorer.insert(s1);
             simd_scorer.similarity(&results[0], results.size(), s2, max);
         }
+        else if (s1.size() <= 128) {
+            rapidfuzz::experimental::MultiIndel<128> simd_scorer(1);
+            simd_scorer.insert(s1);
+            simd_scorer.similarity(&results[0], results.size(), s2, max);
+        }
+        else {
+            rapidfuzz::experimental::MultiIndel<256> simd_scorer(1);
+            simd_scorer.insert(s1);
+            simd_scorer.similarity(&results[0], results.size(), s2, max);
+        }
 
         REQUIRE(res1 == results[0]);
     }
@@ -120,8 +155,8 @@ double indel_normalized_distance(const Sentence1& s1, const Sentence2& s2, doubl
     double res4 = scorer.normalized_distance(s2, score_cutoff);
     double res5 = scorer.normalized_distance(s2.begin(), s2.end(), score_cutoff);
 #ifdef RAPIDFUZZ_SIMD
-    if (s1.size() <= 64) {
-        std::vector<double> results(256 / 8);
+    if (s1.size() <= 256) {
+        std::vector<double> results(512 / 8);
 
         if (s1.size() <= 8) {
             rapidfuzz::experimental::MultiIndel<8> simd_scorer(1);
@@ -138,11 +173,21 @@ double indel_normalized_distance(const Sentence1& s1, const Sentence2& s2, doubl
             simd_scorer.insert(s1);
             simd_scorer.normalized_distance(&results[0], results.size(), s2, score_cutoff);
         }
-        else {
+        else if (s1.size() <= 64) {
             rapidfuzz::experimental::MultiIndel<64> simd_scorer(1);
             simd_scorer.insert(s1);
             simd_scorer.normalized_distance(&results[0], results.size(), s2, score_cutoff);
         }
+        else if (s1.size() <= 128) {
+            rapidfuzz::experimental::MultiIndel<128> simd_scorer(1);
+            simd_scorer.insert(s1);
+            simd_scorer.normalized_distance(&results[0], results.size(), s2, score_cutoff);
+        }
+        else {
+            rapidfuzz::experimental::MultiIndel<256> simd_scorer(1);
+            simd_scorer.insert(s1);
+            simd_scorer.normalized_distance(&results[0], results.size(), s2, score_cutoff);
+        }
 
         REQUIRE_THAT(res1, WithinAbs(results[0], 0.0001));
     }
@@ -167,8 +212,8 @@ double indel_normalized_similarity(const Sentence1& s1, const Sentence2& s2, dou
     double res4 = scorer.normalized_similarity(s2, score_cutoff);
     double res5 = scorer.normalized_similarity(s2.begin(), s2.end(), score_cutoff);
 #ifdef RAPIDFUZZ_SIMD
-    if (s1.size() <= 64) {
-        std::vector<double> results(256 / 8);
+    if (s1.size() <= 256) {
+        std::vector<double> results(512 / 8);
 
         if (s1.size() <= 8) {
             rapidfuzz::experimental::MultiIndel<8> simd_scorer(1);
@@ -185,11 +230,21 @@ double indel_normalized_similarity(const Sentence1& s1, const Sentence2& s2, dou
             simd_scorer.insert(s1);
             simd_scorer.normalized_similarity(&results[0], results.size(), s2, score_cutoff);
         }
-        else {
+        else if (s1.size() <= 64) {
             rapidfuzz::experimental::MultiIndel<64> simd_scorer(1);
             simd_scorer.insert(s1);
             simd_scorer.normalized_similarity(&results[0], results.size(), s2, score_cutoff);
         }
+        else if (s1.size() <= 128) {
+            rapidfuzz::experimental::MultiIndel<128> simd_scorer(1);
+            simd_scorer.insert(s1);
+            simd_scorer.normalized_similarity(&results[0], results.size(), s2, score_cutoff);
+        }
+        else {
+            rapidfuzz::experimental::MultiIndel<256> simd_scorer(1);
+            simd_scorer.insert(s1);
+            simd_scorer.normalized_similarity(&results[0], results.size(), s2, score_cutoff);
+        }
 
         REQUIRE_THAT(res1, WithinAbs(results[0], 0.0001));
     }
@@ -285,3 +340,26 @@ TEST_CASE("Indel")
         }
     }
 }
+
+#ifdef RAPIDFUZZ_SIMD
+TEST_CASE("Indel serialization")
+{
+    std::vector<std::u32string> strings = {U"", U"new york mets", U"\u00e4\u00f6\u00fc\U0001F600", U"braves"};
+    rapidfuzz::experimental::MultiIndel<16> scorer(strings.size());
+    for (const auto& s : strings)
+        scorer.insert(s);
+
+    std::vector<uint64_t> buffer = serialize_scorer(scorer);
+    size_t size = buffer.size() * sizeof(uint64_t);
+    auto loaded = rapidfuzz::experimental::MultiIndel<16>::deserialize(buffer.data(), size);
+    REQUIRE_THROWS_AS(loaded.insert(std::u32string(U"a")), std::invalid_argument);
+
+    std::vector<double> results(loaded.result_count());
+    for (const auto& s2 : {std::u32string(U"new yrok"), std::u32string(U"\U0001F600\u00e4")}) {
+        loaded.normalized_distance(&results[0], results.size(), s2);
+        for (size_t i = 0; i < strings.size(); ++i)
+            REQUIRE_THAT(results[i],
+                         WithinAbs(rapidfuzz::indel_normalized_distance(strings[i], s2), 0.000001));
+    }
+}
+#endif
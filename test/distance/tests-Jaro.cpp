@@ -28,11 +28,14 @@ double jaro_similarity(const Sentence1& s1, const Sentence2& s2, double score_cu
     rapidfuzz::CachedJaro<rapidfuzz::char_type<Sentence1>> scorer(s1);
     double res6 = scorer.similarity(s2, score_cutoff);
     double res7 = scorer.similarity(s2.begin(), s2.end(), score_cutoff);
+    auto compact_scorer = scorer;
+    compact_scorer.shrink_to_fit();
+    REQUIRE(compact_scorer.similarity(s2, score_cutoff) == res6);
     double res8 = scorer.normalized_similarity(s2, score_cutoff);
     double res9 = scorer.normalized_similarity(s2.begin(), s2.end(), score_cutoff);
 
 #ifdef RAPIDFUZZ_SIMD
-    std::vector<double> results(256 / 8);
+    std::vector<double> results(512 / 8);
     if (s1.size() <= 8) {
         rapidfuzz::experimental::MultiJaro<8> simd_scorer(32);
         for (size_t i = 0; i < 32; ++i)
@@ -102,7 +105,7 @@ double jaro_distance(const Sentence1& s1, const Sentence2& s2, double score_cuto
     double res9 = scorer.normalized_distance(s2.begin(), s2.end(), score_cutoff);
 
 #ifdef RAPIDFUZZ_SIMD
-    std::vector<double> results(256 / 8);
+    std::vector<double> results(512 / 8);
     if (s1.size() <= 8) {
         rapidfuzz::experimental::MultiJaro<8> simd_scorer(32);
         for (size_t i = 0; i < 32; ++i)
@@ -255,3 +258,28 @@ TEST_CASE("JaroTest")
 #endif
     }
 }
+
+#ifdef RAPIDFUZZ_SIMD
+TEST_CASE("Jaro serialization")
+{
+    std::vector<std::string> strings = {"", "00100100", "new york mets", "new york yankees"};
+    rapidfuzz::experimental::MultiJaro<16> scorer(strings.size());
+    for (const auto& s : strings)
+        scorer.insert(s);
+
+    std::vector<uint64_t> buffer = serialize_scorer(scorer);
+    size_t size = buffer.size() * sizeof(uint64_t);
+    auto loaded = rapidfuzz::experimental::MultiJaro<16>::deserialize(buffer.data(), size);
+    REQUIRE_THROWS_AS(loaded.insert(std::string("a")), std::invalid_argument);
+
+    std::vector<double> expected(scorer.result_count());
+    std::vector<double> results(loaded.result_count());
+    for (const auto& s2 : {std::string("new yrok mets"), std::string("10010010")}) {
+        scorer.similarity(&expected[0], expected.size(), s2);
+        loaded.similarity(&results[0], results.size(), s2);
+        REQUIRE(results == expected);
+        for (size_t i = 0; i < strings.size(); ++i)
+            REQUIRE_THAT(results[i], WithinAbs(rapidfuzz::jaro_similarity(strings[i], s2), 0.000001));
+    }
+}
+#endif
@@ -25,11 +25,14 @@ double jaro_winkler_similarity(const Sentence1& s1, const Sentence2& s2, double
     rapidfuzz::CachedJaroWinkler<rapidfuzz::char_type<Sentence1>> scorer(s1, prefix_weight);
     double res5 = scorer.similarity(s2, score_cutoff);
     double res6 = scorer.similarity(s2.begin(), s2.end(), score_cutoff);
+    auto compact_scorer = scorer;
+    compact_scorer.shrink_to_fit();
+    REQUIRE(compact_scorer.similarity(s2, score_cutoff) == res5);
     double res7 = scorer.normalized_similarity(s2, score_cutoff);
     double res8 = scorer.normalized_similarity(s2.begin(), s2.end(), score_cutoff);
 
 #ifdef RAPIDFUZZ_SIMD
-    std::vector<double> results(256 / 8);
+    std::vector<double> results(512 / 8);
     if (s1.size() <= 8) {
         rapidfuzz::experimental::MultiJaroWinkler<8> simd_scorer(32, prefix_weight);
         for (unsigned int i = 0; i < 32; ++i)
@@ -85,7 +88,7 @@ double jaro_winkler_distance(const Sentence1& s1, const Sentence2& s2, double pr
     double res8 = scorer.normalized_distance(s2.begin(), s2.end(), score_cutoff);
 
 #ifdef RAPIDFUZZ_SIMD
-    std::vector<double> results(256 / 8);
+    std::vector<double> results(512 / 8);
     if (s1.size() <= 8) {
         rapidfuzz::experimental::MultiJaroWinkler<8> simd_scorer(1, prefix_weight);
         simd_scorer.insert(s1);
@@ -214,4 +217,29 @@ TEST_CASE("JaroWinklerTest")
                             "0000000000000000000000000000000000000000000000000000")),
             WithinAbs(0.852344, 0.000001));
     }
-}
\ No newline at end of file
+}
+#ifdef RAPIDFUZZ_SIMD
+TEST_CASE("JaroWinkler serialization")
+{
+    std::vector<std::string> strings = {"", "00100100", "new york mets", "new york yankees"};
+    rapidfuzz::experimental::MultiJaroWinkler<16> scorer(strings.size(), 0.2);
+    for (const auto& s : strings)
+        scorer.insert(s);
+
+    std::vector<uint64_t> buffer = serialize_scorer(scorer);
+    size_t size = buffer.size() * sizeof(uint64_t);
+    auto loaded = rapidfuzz::experimental::MultiJaroWinkler<16>::deserialize(buffer.data(), size);
+    REQUIRE_THROWS_AS(loaded.insert(std::string("a")), std::invalid_argument);
+
+    std::vector<double> expected(scorer.result_count());
+    std::vector<double> results(loaded.result_count());
+    for (const auto& s2 : {std::string("new yrok mets"), std::string("10010010")}) {
+        scorer.similarity(&expected[0], expected.size(), s2);
+        loaded.similarity(&results[0], results.size(), s2);
+        REQUIRE(results == expected);
+        for (size_t i = 0; i < strings.size(); ++i)
+            REQUIRE_THAT(results[i],
+                         WithinAbs(rapidfuzz::jaro_winkler_similarity(strings[i], s2, 0.2), 0.000001));
+    }
+}
+#endif
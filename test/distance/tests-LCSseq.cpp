@@ -25,9 +25,12 @@ size_t lcs_seq_distance(const Sentence1& s1, const Sentence2& s2,
     rapidfuzz::CachedLCSseq<rapidfuzz::char_type<Sentence1>> scorer(s1);
     size_t res4 = scorer.distance(s2, max);
     size_t res5 = scorer.distance(s2.begin(), s2.end(), max);
+    auto compact_scorer = scorer;
+    compact_scorer.shrink_to_fit();
+    REQUIRE(compact_scorer.distance(s2, max) == res4);
 #ifdef RAPIDFUZZ_SIMD
-    if (s1.size() <= 64) {
-        std::vector<size_t> results(256 / 8);
+    if (s1.size() <= 256) {
+        std::vector<size_t> results(512 / 8);
 
         if (s1.size() <= 8) {
             rapidfuzz::experimental::MultiLCSseq<8> simd_scorer(1);
@@ -53,12 +56,34 @@ size_t lcs_seq_distance(const Sentence1& s1, const Sentence2& s2,
             simd_scorer.distance(&results[0], results.size(), s2, max);
             REQUIRE(res1 == results[0]);
         }
+        if (s1.size() <= 128) {
+            rapidfuzz::experimental::MultiLCSseq<128> simd_scorer(1);
+            simd_scorer.insert(s1);
+            simd_scorer.distance(&results[0], results.size(), s2, max);
+            REQUIRE(res1 == results[0]);
+        }
+        if (s1.size() <= 256) {
+            rapidfuzz::experimental::MultiLCSseq<256> simd_scorer(1);
+            simd_scorer.insert(s1);
+            simd_scorer.distance(&results[0], results.size(), s2, max);
+            REQUIRE(res1 == results[0]);
+        }
     }
 #endif
     REQUIRE(res1 == res2);
     REQUIRE(res1 == res3);
     REQUIRE(res1 == res4);
     REQUIRE(res1 == res5);
+
+    /* the state is advanced by a prefix and then by the remaining characters */
+    auto state = scorer.make_state();
+    auto mid = s2.begin() + static_cast<ptrdiff_t>(s2.size() / 2);
+    scorer.append(state, s2.begin(), mid);
+    scorer.append(state, mid, s2.end());
+    REQUIRE(state.length() == s2.size());
+    size_t res6 = state.distance();
+    if (res6 > max) res6 = max + 1;
+    REQUIRE(res6 == res1);
     return res1;
 }
 
@@ -73,8 +98,8 @@ size_t lcs_seq_similarity(const Sentence1& s1, const Sentence2& s2, size_t max =
     size_t res4 = scorer.similarity(s2, max);
     size_t res5 = scorer.similarity(s2.begin(), s2.end(), max);
 #ifdef RAPIDFUZZ_SIMD
-    if (s1.size() <= 64) {
-        std::vector<size_t> results(256 / 8);
+    if (s1.size() <= 256) {
+        std::vector<size_t> results(512 / 8);
 
         if (s1.size() <= 8) {
             rapidfuzz::experimental::MultiLCSseq<8> simd_scorer(1);
@@ -91,11 +116,21 @@ size_t lcs_seq_similarity(const Sentence1& s1, const Sentence2& s2, size_t max =
             simd_scorer.insert(s1);
             simd_scorer.similarity(&results[0], results.size(), s2, max);
         }
-        else {
+        else if (s1.size() <= 64) {
             rapidfuzz::experimental::MultiLCSseq<64> simd_scorer(1);
             simd_scorer.insert(s1);
             simd_scorer.similarity(&results[0], results.size(), s2, max);
         }
+        else if (s1.size() <= 128) {
+            rapidfuzz::experimental::MultiLCSseq<128> simd_scorer(1);
+            simd_scorer.insert(s1);
+            simd_scorer.similarity(&results[0], results.size(), s2, max);
+        }
+        else {
+            rapidfuzz::experimental::MultiLCSseq<256> simd_scorer(1);
+            simd_scorer.insert(s1);
+            simd_scorer.similarity(&results[0], results.size(), s2, max);
+        }
 
         REQUIRE(res1 == results[0]);
     }
@@ -241,4 +276,46 @@ TEST_CASE("SIMD wraparound")
         REQUIRE(results[3] == 510);
     }
 }
+
+TEST_CASE("SIMD")
+{
+    SECTION("sequences longer than 64 characters")
+    {
+        /* enough strings to fill multiple groups with lengths spread over all words */
+        std::vector<std::string> strings;
+        for (size_t i = 0; i < 37; ++i) {
+            std::string s;
+            for (size_t j = 0; j < (i * 41) % 193; ++j)
+                s += static_cast<char>('a' + (i * 7 + j * j) % 5);
+            strings.push_back(s);
+        }
+
+        rapidfuzz::experimental::MultiLCSseq<192> scorer(strings.size());
+        for (const auto& s : strings)
+            scorer.insert(s);
+
+        std::vector<std::string> queries = {strings[5], strings[20], "abcde",
+                                            str_multiply(std::string("dab"), 90)};
+        std::vector<size_t> results(scorer.result_count());
+        for (const auto& s2 : queries) {
+            scorer.similarity(&results[0], results.size(), s2);
+            for (size_t i = 0; i < strings.size(); ++i)
+                REQUIRE(results[i] == rapidfuzz::lcs_seq_similarity(strings[i], s2));
+
+            scorer.similarity(&results[0], results.size(), s2, 70);
+            for (size_t i = 0; i < strings.size(); ++i)
+                REQUIRE(results[i] == rapidfuzz::lcs_seq_similarity(strings[i], s2, 70));
+        }
+
+        std::vector<uint64_t> buffer = serialize_scorer(scorer);
+        size_t size = buffer.size() * sizeof(uint64_t);
+        auto loaded = rapidfuzz::experimental::MultiLCSseq<192>::deserialize(buffer.data(), size);
+        std::vector<size_t> loaded_results(loaded.result_count());
+        for (const auto& s2 : queries) {
+            scorer.similarity(&results[0], results.size(), s2);
+            loaded.similarity(&loaded_results[0], loaded_results.size(), s2);
+            REQUIRE(loaded_results == results);
+        }
+    }
+}
 #endif
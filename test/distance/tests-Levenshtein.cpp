@@ -30,10 +30,13 @@ size_t levenshtein_distance(const Sentence1& s1, const Sentence2& s2,
     rapidfuzz::CachedLevenshtein<rapidfuzz::char_type<Sentence1>> scorer(s1, weights);
     size_t res4 = scorer.distance(s2, max);
     size_t res5 = scorer.distance(s2.begin(), s2.end(), max);
+    auto compact_scorer = scorer;
+    compact_scorer.shrink_to_fit();
+    REQUIRE(compact_scorer.distance(s2, max) == res4);
 #ifdef RAPIDFUZZ_SIMD
-    if (weights.delete_cost == 1 && weights.insert_cost == 1 && weights.replace_cost == 1 && s1.size() <= 64)
+    if (weights.delete_cost == 1 && weights.insert_cost == 1 && weights.replace_cost == 1 && s1.size() <= 256)
     {
-        std::vector<size_t> results(256 / 8);
+        std::vector<size_t> results(512 / 8);
 
         if (s1.size() <= 8) {
             rapidfuzz::experimental::MultiLevenshtein<8> simd_scorer(1);
@@ -59,12 +62,36 @@ size_t levenshtein_distance(const Sentence1& s1, const Sentence2& s2,
             simd_scorer.distance(&results[0], results.size(), s2, max);
             REQUIRE(res1 == results[0]);
         }
+        if (s1.size() <= 128) {
+            rapidfuzz::experimental::MultiLevenshtein<128> simd_scorer(1);
+            simd_scorer.insert(s1);
+            simd_scorer.distance(&results[0], results.size(), s2, max);
+            REQUIRE(res1 == results[0]);
+        }
+        if (s1.size() <= 256) {
+            rapidfuzz::experimental::MultiLevenshtein<256> simd_scorer(1);
+            simd_scorer.insert(s1);
+            simd_scorer.distance(&results[0], results.size(), s2, max);
+            REQUIRE(res1 == results[0]);
+        }
     }
 #endif
     REQUIRE(res1 == res2);
     REQUIRE(res1 == res3);
     REQUIRE(res1 == res4);
     REQUIRE(res1 == res5);
+
+    if (weights.insert_cost == weights.delete_cost && weights.insert_cost == weights.replace_cost) {
+        /* the state is advanced by a prefix and then by the remaining characters */
+        auto state = scorer.make_state();
+        auto mid = s2.begin() + static_cast<ptrdiff_t>(s2.size() / 2);
+        scorer.append(state, s2.begin(), mid);
+        scorer.append(state, mid, s2.end());
+        REQUIRE(state.length() == s2.size());
+        size_t res6 = state.distance();
+        if (res6 > max) res6 = max + 1;
+        REQUIRE(res6 == res1);
+    }
     return res1;
 }
 
@@ -541,5 +568,259 @@ TEST_CASE("SIMD")
 
         REQUIRE(results[count - 1] == 16);
     }
+
+    SECTION("sequences longer than 64 characters")
+    {
+        /* enough strings to fill multiple groups with lengths spread over all words */
+        std::vector<std::string> strings;
+        for (size_t i = 0; i < 37; ++i) {
+            std::string s;
+            for (size_t j = 0; j < (i * 41) % 193; ++j)
+                s += static_cast<char>('a' + (i * 7 + j * j) % 5);
+            strings.push_back(s);
+        }
+
+        rapidfuzz::experimental::MultiLevenshtein<192> scorer(strings.size());
+        for (const auto& s : strings)
+            scorer.insert(s);
+
+        std::vector<std::string> queries = {strings[5], strings[20], "abcde",
+                                            str_multiply(std::string("dab"), 90)};
+        std::vector<size_t> results(scorer.result_count());
+        for (const auto& s2 : queries) {
+            scorer.distance(&results[0], results.size(), s2);
+            for (size_t i = 0; i < strings.size(); ++i)
+                REQUIRE(results[i] == rapidfuzz::levenshtein_distance(strings[i], s2));
+
+            scorer.distance(&results[0], results.size(), s2, 70);
+            for (size_t i = 0; i < strings.size(); ++i)
+                REQUIRE(results[i] == rapidfuzz::levenshtein_distance(strings[i], s2, {1, 1, 1}, 70));
+        }
+    }
+
+    SECTION("serialization")
+    {
+        std::vector<std::u32string> strings = {U"", U"new york", U"\u00e4\u00f6\u00fc\U0001F600 abc",
+                                               U"\U0001F600\U0001F601", U"atlanta braves vs new york"};
+        rapidfuzz::experimental::MultiLevenshtein<32> scorer(strings.size());
+        for (const auto& s : strings)
+            scorer.insert(s);
+
+        std::vector<uint64_t> buffer = serialize_scorer(scorer);
+        size_t size = buffer.size() * sizeof(uint64_t);
+        auto loaded = rapidfuzz::experimental::MultiLevenshtein<32>::deserialize(buffer.data(), size);
+        REQUIRE(loaded.result_count() == scorer.result_count());
+
+        std::vector<std::u32string> queries = {U"new yrok", U"\U0001F600\u00e4 abc", U""};
+        std::vector<size_t> expected(scorer.result_count());
+        std::vector<size_t> results(loaded.result_count());
+        for (const auto& s2 : queries) {
+            scorer.distance(&expected[0], expected.size(), s2);
+            loaded.distance(&results[0], results.size(), s2);
+            REQUIRE(results == expected);
+            for (size_t i = 0; i < strings.size(); ++i)
+                REQUIRE(results[i] == rapidfuzz::levenshtein_distance(strings[i], s2));
+        }
+
+        /* the loaded scorer is read only */
+        REQUIRE_THROWS_AS(loaded.insert(std::u32string(U"a")), std::invalid_argument);
+
+        /* copies own their bitvectors, so they stay valid without the buffer */
+        auto copy = loaded;
+        std::fill(buffer.begin(), buffer.end(), 0);
+        copy.distance(&results[0], results.size(), queries[0]);
+        scorer.distance(&expected[0], expected.size(), queries[0]);
+        REQUIRE(results == expected);
+    }
+
+    SECTION("serialization of incompatible scorers")
+    {
+        rapidfuzz::experimental::MultiLevenshtein<16> scorer(3);
+        scorer.insert(std::string("abc"));
+        std::vector<uint64_t> buffer = serialize_scorer(scorer);
+        size_t size = buffer.size() * sizeof(uint64_t);
+
+        using rapidfuzz::experimental::MultiLevenshtein;
+        using rapidfuzz::experimental::MultiLCSseq;
+        REQUIRE_NOTHROW(MultiLevenshtein<16>::deserialize(buffer.data(), size));
+        REQUIRE_THROWS_AS(MultiLevenshtein<8>::deserialize(buffer.data(), size), std::invalid_argument);
+        REQUIRE_THROWS_AS(MultiLCSseq<16>::deserialize(buffer.data(), size), std::invalid_argument);
+        REQUIRE_THROWS_AS(MultiLevenshtein<16>::deserialize(buffer.data(), size - 8), std::invalid_argument);
+        REQUIRE_THROWS_AS(MultiLevenshtein<16>::deserialize(buffer.data(), 0), std::invalid_argument);
+
+        std::vector<uint64_t> unaligned(buffer.size() + 1);
+        char* unaligned_data = reinterpret_cast<char*>(unaligned.data()) + 1;
+        std::memcpy(unaligned_data, buffer.data(), size);
+        REQUIRE_THROWS_AS(MultiLevenshtein<16>::deserialize(unaligned_data, size), std::invalid_argument);
+
+        buffer[0] ^= 1;
+        REQUIRE_THROWS_AS(MultiLevenshtein<16>::deserialize(buffer.data(), size), std::invalid_argument);
+    }
+
+    SECTION("serialization of a corrupted hashmap")
+    {
+        rapidfuzz::experimental::MultiLevenshtein<16> scorer(3);
+        scorer.insert(std::u32string(U"a\U0001F600"));
+        std::vector<uint64_t> buffer = serialize_scorer(scorer);
+        size_t size = buffer.size() * sizeof(uint64_t);
+
+        /* header, input count, block count and hashmap flag followed by the bitvectors */
+        size_t block_count = static_cast<size_t>(buffer[7]);
+        REQUIRE(buffer[8] == 1);
+        size_t map_start = 9 + 256 * block_count;
+        REQUIRE(map_start + 256 <= buffer.size());
+        REQUIRE_NOTHROW(rapidfuzz::experimental::MultiLevenshtein<16>::deserialize(buffer.data(), size));
+
+        /* a hashmap without free slots, so the lookup of any other character would never finish */
+        for (size_t i = 0; i < 128; ++i) {
+            buffer[map_start + 2 * i] = 0x1F601;
+            buffer[map_start + 2 * i + 1] = 1;
+        }
+        REQUIRE_THROWS_AS(rapidfuzz::experimental::MultiLevenshtein<16>::deserialize(buffer.data(), size),
+                          std::invalid_argument);
+    }
 }
 #endif
+
+TEST_CASE("Levenshtein State")
+{
+    std::string s1 = str_multiply(std::string("new york mets "), 10);
+    std::string query = str_multiply(std::string("nwe york mets! "), 10);
+    rapidfuzz::CachedLevenshtein<char> scorer(s1);
+
+    SECTION("typing one character at a time matches a full comparison")
+    {
+        auto state = scorer.make_state();
+        REQUIRE(state.distance() == s1.size());
+        for (size_t i = 0; i < query.size(); ++i) {
+            scorer.append(state, query.substr(i, 1));
+            REQUIRE(state.distance() == rapidfuzz::levenshtein_distance(s1, query.substr(0, i + 1)));
+        }
+    }
+
+    SECTION("copies of a state can be continued independently")
+    {
+        auto state = scorer.make_state();
+        scorer.append(state, std::string("new york"));
+        auto copy = state;
+        scorer.append(state, std::string(" mets"));
+        scorer.append(copy, std::string(" yankees"));
+        REQUIRE(state.distance() == rapidfuzz::levenshtein_distance(s1, std::string("new york mets")));
+        REQUIRE(copy.distance() == rapidfuzz::levenshtein_distance(s1, std::string("new york yankees")));
+    }
+
+    SECTION("weights")
+    {
+        rapidfuzz::CachedLevenshtein<char> weighted_scorer(s1, rapidfuzz::LevenshteinWeightTable{2, 2, 2});
+        auto state = weighted_scorer.make_state();
+        weighted_scorer.append(state, query);
+        REQUIRE(state.distance() == rapidfuzz::levenshtein_distance(s1, query, {2, 2, 2}));
+
+        rapidfuzz::CachedLevenshtein<char> indel_scorer(s1, rapidfuzz::LevenshteinWeightTable{1, 1, 2});
+        REQUIRE_THROWS_AS(indel_scorer.make_state(), std::invalid_argument);
+    }
+
+    SECTION("empty s1")
+    {
+        rapidfuzz::CachedLevenshtein<char> empty_scorer(std::string(""));
+        auto state = empty_scorer.make_state();
+        empty_scorer.append(state, std::string("abc"));
+        REQUIRE(state.distance() == 3);
+    }
+
+    SECTION("compact layout")
+    {
+        auto compact_scorer = scorer;
+        compact_scorer.shrink_to_fit();
+        auto state = compact_scorer.make_state();
+        compact_scorer.append(state, query);
+        REQUIRE(state.distance() == rapidfuzz::levenshtein_distance(s1, query));
+    }
+}
+
+TEST_CASE("Levenshtein find_all")
+{
+    auto check_find_all = [](const std::string& s1, const std::string& s2, size_t max) {
+        auto matches = rapidfuzz::levenshtein_find_all(s1, s2, max);
+        rapidfuzz::CachedLevenshtein<char> scorer(s1);
+        auto cached_matches = scorer.find_all(make_bidir(s2.begin()), make_bidir(s2.end()), max);
+        auto end_matches = rapidfuzz::levenshtein_find_all(s1, s2, max, false);
+        REQUIRE(matches == cached_matches);
+        scorer.shrink_to_fit();
+        REQUIRE(matches == scorer.find_all(s2, max));
+        REQUIRE(matches.size() == end_matches.size());
+
+        /* searching the text in chunks finds the same occurrences */
+        for (size_t chunk_size : {size_t{1}, size_t{3}, size_t{64}}) {
+            for (bool find_start : {true, false}) {
+                auto state = scorer.make_search_state(max, find_start);
+                std::vector<rapidfuzz::ScoreAlignment<size_t>> chunk_matches;
+                for (size_t pos = 0; pos < s2.size(); pos += chunk_size) {
+                    const auto chunk = s2.substr(pos, chunk_size);
+                    auto new_matches =
+                        scorer.find_all(state, make_bidir(chunk.begin()), make_bidir(chunk.end()));
+                    chunk_matches.insert(chunk_matches.end(), new_matches.begin(), new_matches.end());
+                }
+                auto last_matches = scorer.find_all(state, std::string());
+                chunk_matches.insert(chunk_matches.end(), last_matches.begin(), last_matches.end());
+                REQUIRE(state.length() == s2.size());
+                REQUIRE(chunk_matches == (find_start ? matches : end_matches));
+            }
+        }
+
+        size_t match_idx = 0;
+        for (size_t end = 0; end <= s2.size(); ++end) {
+            /* distance of the best substring ending at end and the shortest substring with this distance */
+            size_t best = std::numeric_limits<size_t>::max();
+            size_t best_start = end;
+            for (size_t start = end + 1; start-- > 0;) {
+                size_t dist = rapidfuzz::levenshtein_distance(s1, s2.substr(start, end - start));
+                if (dist < best) {
+                    best = dist;
+                    best_start = start;
+                }
+            }
+
+            if (best > max) continue;
+            REQUIRE(match_idx < matches.size());
+            REQUIRE(matches[match_idx] ==
+                    rapidfuzz::ScoreAlignment<size_t>(best, 0, s1.size(), best_start, end));
+            REQUIRE(end_matches[match_idx] ==
+                    rapidfuzz::ScoreAlignment<size_t>(best, 0, s1.size(), end, end));
+            match_idx++;
+        }
+        REQUIRE(match_idx == matches.size());
+    };
+
+    std::string text = "2024-01-01 connection timeout\\n2024-01-02 conection timed out\\n2024-01-03 ok";
+    check_find_all("timeout", text, 0);
+    check_find_all("timeout", text, 1);
+    check_find_all("connection timeout", text, 3);
+    check_find_all("", "abc", 0);
+    check_find_all("abc", "", 3);
+    check_find_all("abc", "xyz", 2);
+
+    std::string long_pattern = str_multiply(std::string("abcdefghij"), 8);
+    std::string long_text =
+        "xx" + long_pattern.substr(0, 40) + "y" + long_pattern.substr(41) + "zz" + long_pattern;
+    check_find_all(long_pattern, long_text, 0);
+    check_find_all(long_pattern, long_text, 2);
+
+    /* the reversed pattern of multiples of 64 characters does not need to be shifted */
+    std::string block_pattern = str_multiply(std::string("abcdefgh"), 16);
+    std::string block_text = "x" + block_pattern.substr(0, 70) + block_pattern.substr(71) + "yy";
+    check_find_all(block_pattern, block_text, 1);
+
+    check_find_all("caf\xc3\xa9", "le caf\xc3\xa9 au cafe\xc3\xa9 \xff\xc3\xa9", 1);
+
+    SECTION("weights")
+    {
+        rapidfuzz::CachedLevenshtein<char> scorer(std::string("timeout"),
+                                                  rapidfuzz::LevenshteinWeightTable{2, 2, 2});
+        auto matches = scorer.find_all(text, 2);
+        auto unit_matches = rapidfuzz::levenshtein_find_all(std::string("timeout"), text, 1);
+        REQUIRE(matches.size() == unit_matches.size());
+        for (size_t i = 0; i < matches.size(); ++i)
+            REQUIRE(matches[i].score == 2 * unit_matches[i].score);
+    }
+}
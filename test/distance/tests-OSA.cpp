@@ -21,9 +21,12 @@ size_t osa_distance(const Sentence1& s1, const Sentence2& s2, size_t max = std::
     rapidfuzz::CachedOSA<rapidfuzz::char_type<Sentence1>> scorer(s1);
     size_t res4 = scorer.distance(s2, max);
     size_t res5 = scorer.distance(s2.begin(), s2.end(), max);
+    auto compact_scorer = scorer;
+    compact_scorer.shrink_to_fit();
+    REQUIRE(compact_scorer.distance(s2, max) == res4);
 #ifdef RAPIDFUZZ_SIMD
     if (s1.size() <= 64) {
-        std::vector<size_t> results(256 / 8);
+        std::vector<size_t> results(512 / 8);
 
         if (s1.size() <= 8) {
             rapidfuzz::experimental::MultiOSA<8> simd_scorer(1);
@@ -95,3 +98,25 @@ TEST_CASE("osa[simple]")
         REQUIRE(osa_distance(s1, s2) == 3);
     }
 }
+
+#ifdef RAPIDFUZZ_SIMD
+TEST_CASE("OSA serialization")
+{
+    std::vector<std::string> strings = {"", "CA", "new york mets", "atlanta braves vs"};
+    rapidfuzz::experimental::MultiOSA<32> scorer(strings.size());
+    for (const auto& s : strings)
+        scorer.insert(s);
+
+    std::vector<uint64_t> buffer = serialize_scorer(scorer);
+    size_t size = buffer.size() * sizeof(uint64_t);
+    auto loaded = rapidfuzz::experimental::MultiOSA<32>::deserialize(buffer.data(), size);
+    REQUIRE_THROWS_AS(loaded.insert(std::string("a")), std::invalid_argument);
+
+    std::vector<size_t> results(loaded.result_count());
+    for (const auto& s2 : {std::string("AC"), std::string("nwe york mest")}) {
+        loaded.distance(&results[0], results.size(), s2);
+        for (size_t i = 0; i < strings.size(); ++i)
+            REQUIRE(results[i] == rapidfuzz::osa_distance(strings[i], s2));
+    }
+}
+#endif
@@ -7,6 +7,7 @@
 #    include <catch2/catch_test_macros.hpp>
 #endif
 
+#include <rapidfuzz/details/PatternMatchVector.hpp>
 #include <rapidfuzz/details/common.hpp>
 
 TEST_CASE("remove affix")
@@ -40,3 +41,37 @@ TEST_CASE("remove affix")
         REQUIRE(s2_ == rapidfuzz::detail::make_range("abbbba"));
     }
 }
+
+TEST_CASE("CompactBlockPatternMatchVector")
+{
+    /* ASCII, extended ASCII, characters above 255 and negative characters spread over three blocks */
+    std::vector<int64_t> s1;
+    for (int64_t i = 0; i < 150; ++i) {
+        if (i % 7 == 0)
+            s1.push_back(0x1F600 + i % 3);
+        else if (i % 11 == 0)
+            s1.push_back(-i);
+        else if (i % 5 == 0)
+            s1.push_back(200 + i % 4);
+        else
+            s1.push_back('a' + i % 13);
+    }
+
+    rapidfuzz::detail::BlockPatternMatchVector PM(rapidfuzz::detail::make_range(s1));
+    rapidfuzz::detail::CompactBlockPatternMatchVector compact_PM(PM);
+    REQUIRE(compact_PM.size() == PM.size());
+
+    std::vector<int64_t> keys = {-150, -22, -11, -1, 0x1F600, 0x1F601, 0x1F602, 0x1F603, 1000};
+    for (int64_t ch = 0; ch < 300; ++ch)
+        keys.push_back(ch);
+
+    for (size_t block = 0; block < PM.size(); ++block)
+        for (int64_t key : keys)
+            REQUIRE(compact_PM.get(block, key) == PM.get(block, key));
+
+    /* copies of the dense layout are independent */
+    rapidfuzz::detail::BlockPatternMatchVector copy = PM;
+    PM = rapidfuzz::detail::BlockPatternMatchVector(0);
+    for (size_t block = 0; block < copy.size(); ++block)
+        REQUIRE(compact_PM.get(block, int64_t(0x1F600)) == copy.get(block, int64_t(0x1F600)));
+}
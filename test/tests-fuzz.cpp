@@ -255,3 +255,84 @@ TEST_CASE("RatioTest")
         score_test(97.5274725, fuzz::partial_ratio(str2, str1, 97.5));
     }
 }
+
+static double partial_ratio_brute_force(const std::string& s1, const std::string& s2)
+{
+    double best = 0;
+    size_t len1 = s1.size();
+    for (size_t end = 1; end <= s2.size(); ++end) {
+        size_t start = (end > len1) ? end - len1 : 0;
+        best = std::max(best, fuzz::ratio(s1, s2.substr(start, end - start)));
+    }
+    for (size_t start = s2.size() - len1; start < s2.size(); ++start)
+        best = std::max(best, fuzz::ratio(s1, s2.substr(start)));
+    return best;
+}
+
+TEST_CASE("partial_ratio long needles")
+{
+    /* haystack with a small alphabet, so most windows share a lot of characters with the needle */
+    std::string haystack;
+    for (size_t i = 0; i < 3000; ++i)
+        haystack += static_cast<char>('a' + (i * i + i / 7) % 5);
+
+    for (size_t len1 : {size_t{64}, size_t{65}, size_t{130}, size_t{257}}) {
+        for (size_t pos : {size_t(0), size_t(1000), 3000 - len1}) {
+            std::string needle = haystack.substr(pos, len1);
+            /* modify the needle, so it is not contained in the haystack verbatim */
+            needle[len1 / 2] = 'x';
+            needle.erase(len1 / 3, 1);
+            needle += "yz";
+
+            double expected = partial_ratio_brute_force(needle, haystack);
+            auto alignment = fuzz::partial_ratio_alignment(needle, haystack);
+            score_test(expected, alignment.score);
+            size_t dest_len = alignment.dest_end - alignment.dest_start;
+            score_test(expected, fuzz::ratio(needle, haystack.substr(alignment.dest_start, dest_len)));
+            score_test(expected, fuzz::partial_ratio(needle, haystack, expected - 0.1));
+            score_test(0, fuzz::partial_ratio(needle, haystack, expected + 0.1));
+
+            fuzz::CachedPartialRatio<char> scorer(needle);
+            score_test(expected, scorer.similarity(haystack));
+        }
+    }
+}
+
+TEST_CASE("Cached scorers match the uncached implementation")
+{
+    std::vector<std::string> strings = {"new york mets",
+                                        "new YORK mets",
+                                        "the wonderful new york mets",
+                                        "new york mets vs atlanta braves",
+                                        "atlanta braves vs new york mets",
+                                        "new york mets - atlanta braves",
+                                        "new york city mets - atlanta braves",
+                                        "mets mets new york new",
+                                        "york",
+                                        "a",
+                                        "",
+                                        str_multiply(std::string("new york mets "), 8),
+                                        str_multiply(std::string("braves atlanta "), 3) + "new york"};
+
+    for (const auto& s1 : strings) {
+        fuzz::CachedWRatio<char> wratio(s1);
+        fuzz::CachedTokenRatio<char> token_ratio(s1);
+        fuzz::CachedPartialTokenRatio<char> partial_token_ratio(s1);
+
+        for (const auto& s2 : strings) {
+            for (double score_cutoff : {0.0, 50.0, 90.0}) {
+                score_test(fuzz::WRatio(s1, s2, score_cutoff), wratio.similarity(s2, score_cutoff));
+                score_test(fuzz::token_ratio(s1, s2, score_cutoff), token_ratio.similarity(s2, score_cutoff));
+                score_test(fuzz::partial_token_ratio(s1, s2, score_cutoff),
+                           partial_token_ratio.similarity(s2, score_cutoff));
+            }
+        }
+    }
+
+    /* the ratio of the sorted tokens is 80 with one rounding and slightly below with the other */
+    std::string s1 = "dodgerx braves citd";
+    std::string s2 = "city dodgers bravem";
+    REQUIRE(fuzz::CachedWRatio<char>(s1).similarity(s2, 80.0) == fuzz::WRatio(s1, s2, 80.0));
+    REQUIRE(fuzz::CachedTokenRatio<char>(s1).similarity(s2, 84.21052631578948) ==
+            fuzz::token_ratio(s1, s2, 84.21052631578948));
+}
@@ -0,0 +1,298 @@
+#if CATCH2_VERSION == 2
+#    include <catch2/catch.hpp>
+#else
+#    include <catch2/catch_test_macros.hpp>
+#endif
+
+#include <rapidfuzz/distance/DamerauLevenshtein.hpp>
+#include <rapidfuzz/distance/Hamming.hpp>
+#include <rapidfuzz/distance/Indel.hpp>
+#include <rapidfuzz/distance/Levenshtein.hpp>
+#include <rapidfuzz/distance/OSA.hpp>
+#include <rapidfuzz/index.hpp>
+
+#include "common.hpp"
+
+static std::vector<std::string> get_choices()
+{
+    std::vector<std::string> choices = {"new york mets",
+                                        "new york mets vs atlanta braves",
+                                        "new york city mets",
+                                        "",
+                                        "{",
+                                        "a",
+                                        "ab",
+                                        "ba",
+                                        "new yrok mets",
+                                        "nwe york mest",
+                                        str_multiply(std::string("abcdefgh"), 12)};
+
+    /* small alphabet, so a lot of strings share q-grams */
+    for (size_t i = 0; i < 150; ++i) {
+        std::string s;
+        for (size_t j = 0; j < (i * 7) % 19; ++j)
+            s += static_cast<char>('a' + (i * 5 + j * j + j / 3) % (2 + i % 4));
+        choices.push_back(s);
+    }
+    return choices;
+}
+
+template <template <typename> class CachedScorer>
+static std::vector<rapidfuzz::process::ExtractResult<size_t>>
+brute_force_search(const std::vector<std::string>& choices, const std::string& query, size_t max)
+{
+    CachedScorer<char> scorer(query);
+    std::vector<rapidfuzz::process::ExtractResult<size_t>> results;
+    for (size_t i = 0; i < choices.size(); ++i) {
+        size_t dist = scorer.distance(choices[i], max);
+        if (dist <= max) results.push_back({dist, i});
+    }
+
+    std::stable_sort(results.begin(), results.end(),
+                     [](const rapidfuzz::process::ExtractResult<size_t>& a,
+                        const rapidfuzz::process::ExtractResult<size_t>& b) { return a.score < b.score; });
+    return results;
+}
+
+template <typename ScoreT>
+static void require_equal(const std::vector<rapidfuzz::process::ExtractResult<ScoreT>>& a,
+                          const std::vector<rapidfuzz::process::ExtractResult<ScoreT>>& b)
+{
+    REQUIRE(a.size() == b.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        REQUIRE(a[i].score == b[i].score);
+        REQUIRE(a[i].index == b[i].index);
+    }
+}
+
+TEST_CASE("QGramIndex")
+{
+    auto choices = get_choices();
+
+    SECTION("search finds the same choices as a linear scan")
+    {
+        for (size_t q : {size_t{1}, size_t{2}, size_t{3}, size_t{4}}) {
+            rapidfuzz::index::QGramIndex<char> qgram_index(choices, q);
+            REQUIRE(qgram_index.size() == choices.size());
+            REQUIRE(qgram_index.qgram_size() == q);
+
+            for (const auto& query : choices) {
+                for (size_t max : {size_t{0}, size_t{1}, size_t{2}, size_t{3}, size_t{6}}) {
+                    require_equal(qgram_index.search(query, max),
+                                  brute_force_search<rapidfuzz::CachedLevenshtein>(choices, query, max));
+                    require_equal(qgram_index.search<rapidfuzz::CachedIndel>(query, max),
+                                  brute_force_search<rapidfuzz::CachedIndel>(choices, query, max));
+                }
+            }
+        }
+    }
+
+    SECTION("candidates are filtered by their shared q-grams")
+    {
+        rapidfuzz::index::QGramIndex<char> qgram_index(choices, 3);
+        auto candidates = qgram_index.candidates(std::string("new york mets"), 2);
+        REQUIRE(std::find(candidates.begin(), candidates.end(), 0) != candidates.end());
+        REQUIRE(std::find(candidates.begin(), candidates.end(), 2) == candidates.end());
+        REQUIRE(candidates.size() < choices.size() / 10);
+    }
+
+    SECTION("empty index")
+    {
+        rapidfuzz::index::QGramIndex<char> qgram_index(std::vector<std::string>{}, 2);
+        REQUIRE(qgram_index.search(std::string("test"), 3).empty());
+    }
+
+    SECTION("q has to be > 0")
+    {
+        REQUIRE_THROWS_AS(rapidfuzz::index::QGramIndex<char>(choices, 0), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Indices with queries of another character type")
+{
+    /* UTF-8 bytes >= 0x80 are negative as char, but not as unsigned char or wchar_t */
+    std::vector<std::string> choices = {"caf\xc3\xa9 cr\xc3\xa8me", "new york mets"};
+    std::basic_string<unsigned char> unsigned_query(choices[0].begin(), choices[0].end());
+    std::wstring wide_query;
+    for (unsigned char ch : unsigned_query)
+        wide_query += static_cast<wchar_t>(ch);
+
+    SECTION("QGramIndex")
+    {
+        rapidfuzz::index::QGramIndex<char> qgram_index(choices, 2);
+        REQUIRE(qgram_index.candidates(unsigned_query, 0) == std::vector<size_t>{0});
+        REQUIRE(qgram_index.candidates(wide_query, 0) == std::vector<size_t>{0});
+
+        auto results = qgram_index.search(unsigned_query, 1);
+        REQUIRE(results.size() == 1);
+        REQUIRE(results[0].score == 0);
+        REQUIRE(results[0].index == 0);
+    }
+
+    SECTION("DeletionIndex")
+    {
+        rapidfuzz::index::DeletionIndex<char> deletion_index(choices, 1);
+        REQUIRE(deletion_index.candidates(unsigned_query, 0) == std::vector<size_t>{0});
+        REQUIRE(deletion_index.candidates(wide_query, 0) == std::vector<size_t>{0});
+
+        auto results = deletion_index.search(unsigned_query, 0);
+        REQUIRE(results.size() == 1);
+        REQUIRE(results[0].score == 0);
+        REQUIRE(results[0].index == 0);
+    }
+}
+
+template <template <typename> class CachedScorer>
+static void test_metric_tree(const std::vector<std::string>& choices)
+{
+    /* half of the tree is built in bulk, the remaining strings are inserted one by one */
+    auto half = static_cast<ptrdiff_t>(choices.size() / 2);
+    std::vector<std::string> first_half(choices.begin(), choices.begin() + half);
+    rapidfuzz::index::MetricTree<CachedScorer, char> tree(first_half);
+    for (size_t i = first_half.size(); i < choices.size(); ++i)
+        tree.insert(choices[i]);
+    REQUIRE(tree.size() == choices.size());
+
+    for (const auto& query : choices) {
+        for (size_t max : {size_t{0}, size_t{1}, size_t{2}, size_t{5}})
+            require_equal(tree.search(query, max), brute_force_search<CachedScorer>(choices, query, max));
+
+        auto all = brute_force_search<CachedScorer>(choices, query, std::numeric_limits<size_t>::max());
+        for (size_t k : {size_t{1}, size_t{3}, size_t{10}}) {
+            std::vector<rapidfuzz::process::ExtractResult<size_t>> expected(
+                all.begin(), all.begin() + static_cast<ptrdiff_t>(k));
+            require_equal(tree.nearest(query, k), expected);
+        }
+        require_equal(tree.nearest(query, choices.size() + 5), all);
+    }
+}
+
+TEST_CASE("MetricTree")
+{
+    auto choices = get_choices();
+
+    SECTION("search and nearest match a linear scan")
+    {
+        test_metric_tree<rapidfuzz::CachedLevenshtein>(choices);
+        test_metric_tree<rapidfuzz::experimental::CachedDamerauLevenshtein>(choices);
+        test_metric_tree<rapidfuzz::CachedIndel>(choices);
+        test_metric_tree<rapidfuzz::CachedHamming>(choices);
+    }
+
+    SECTION("empty tree")
+    {
+        rapidfuzz::index::MetricTree<rapidfuzz::CachedLevenshtein, char> tree;
+        REQUIRE(tree.size() == 0);
+        REQUIRE(tree.search(std::string("test"), 3).empty());
+        REQUIRE(tree.nearest(std::string("test"), 3).empty());
+    }
+}
+
+TEST_CASE("DeletionIndex")
+{
+    auto choices = get_choices();
+
+    SECTION("search finds the same choices as a linear scan")
+    {
+        for (size_t prefix_length : {size_t{1}, size_t{3}, size_t{7}, size_t{100}}) {
+            rapidfuzz::index::DeletionIndex<char> deletion_index(choices, 2, prefix_length);
+            REQUIRE(deletion_index.size() == choices.size());
+            REQUIRE(deletion_index.max_depth() == 2);
+            REQUIRE(deletion_index.prefix_length() == prefix_length);
+
+            for (const auto& query : choices) {
+                for (size_t max : {size_t{0}, size_t{1}, size_t{2}}) {
+                    require_equal(deletion_index.search(query, max),
+                                  brute_force_search<rapidfuzz::CachedLevenshtein>(choices, query, max));
+                    require_equal(deletion_index.search<rapidfuzz::CachedOSA>(query, max),
+                                  brute_force_search<rapidfuzz::CachedOSA>(choices, query, max));
+                    require_equal(deletion_index.search<rapidfuzz::CachedIndel>(query, max),
+                                  brute_force_search<rapidfuzz::CachedIndel>(choices, query, max));
+                }
+            }
+        }
+    }
+
+    SECTION("transpositions are found")
+    {
+        rapidfuzz::index::DeletionIndex<char> deletion_index(choices, 1);
+        auto results = deletion_index.search<rapidfuzz::CachedOSA>(std::string("nwe york mets"), 1);
+        REQUIRE(results.size() == 2);
+        REQUIRE(results[0].index == 0);
+        REQUIRE(results[1].index == 9);
+    }
+
+    SECTION("shorter prefixes store fewer variants")
+    {
+        rapidfuzz::index::DeletionIndex<char> short_prefix(choices, 2, 3);
+        rapidfuzz::index::DeletionIndex<char> long_prefix(choices, 2, 7);
+        REQUIRE(short_prefix.variant_count() < long_prefix.variant_count());
+    }
+
+    SECTION("max has to be <= max_depth")
+    {
+        rapidfuzz::index::DeletionIndex<char> deletion_index(choices, 1);
+        REQUIRE_THROWS_AS(deletion_index.search(std::string("test"), 2), std::invalid_argument);
+        REQUIRE_THROWS_AS(rapidfuzz::index::DeletionIndex<char>(choices, 1, 0), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Trie")
+{
+    auto choices = get_choices();
+    choices.push_back(str_multiply(std::string("abcdefgh"), 12) + "x");
+    choices.push_back(str_multiply(std::string("abcdefgh"), 9));
+
+    SECTION("search finds the same choices as a linear scan")
+    {
+        rapidfuzz::index::Trie<char> trie(choices);
+        REQUIRE(trie.size() == choices.size());
+
+        for (const auto& query : choices)
+            for (size_t max : {size_t{0}, size_t{1}, size_t{2}, size_t{3}, size_t{5}})
+                require_equal(trie.search(query, max),
+                              brute_force_search<rapidfuzz::CachedLevenshtein>(choices, query, max));
+
+        for (size_t max : {size_t{0}, size_t{1}, size_t{4}})
+            require_equal(trie.search(std::string("new york"), max),
+                          brute_force_search<rapidfuzz::CachedLevenshtein>(choices, "new york", max));
+    }
+
+    SECTION("shared prefixes are stored once")
+    {
+        rapidfuzz::index::Trie<char> trie(choices);
+        size_t total_length = 0;
+        for (const auto& choice : choices)
+            total_length += choice.size();
+        REQUIRE(trie.node_count() < total_length / 2);
+    }
+
+    SECTION("non ASCII characters")
+    {
+        /* UTF-8 bytes >= 0x80 are negative for a signed char */
+        std::vector<std::string> words = {"caf\xc3\xa9", "na\xc3\xafve", "cafe", "naive"};
+        rapidfuzz::index::Trie<char> trie(words);
+
+        auto results = trie.search(words[0], 0);
+        REQUIRE(results.size() == 1);
+        REQUIRE(results[0].index == 0);
+
+        results = trie.search(words[1], 0);
+        REQUIRE(results.size() == 1);
+        REQUIRE(results[0].index == 1);
+
+        for (const auto& query : words)
+            for (size_t max : {size_t{0}, size_t{1}, size_t{2}})
+                require_equal(trie.search(query, max),
+                              brute_force_search<rapidfuzz::CachedLevenshtein>(words, query, max));
+    }
+
+    SECTION("empty trie")
+    {
+        rapidfuzz::index::Trie<char> trie;
+        REQUIRE(trie.size() == 0);
+        REQUIRE(trie.node_count() == 1);
+        REQUIRE(trie.search(std::string("test"), 3).empty());
+        REQUIRE(trie.search(std::string(""), 3).empty());
+    }
+}
@@ -0,0 +1,410 @@
+#if CATCH2_VERSION == 2
+#    include <catch2/catch.hpp>
+#else
+#    include <catch2/catch_test_macros.hpp>
+#    include <catch2/matchers/catch_matchers_floating_point.hpp>
+#endif
+
+#include <memory>
+#include <type_traits>
+
+#include <rapidfuzz/distance/Indel.hpp>
+#include <rapidfuzz/distance/JaroWinkler.hpp>
+#include <rapidfuzz/distance/Levenshtein.hpp>
+#include <rapidfuzz/fuzz.hpp>
+#include <rapidfuzz/process.hpp>
+
+#include "common.hpp"
+
+namespace fuzz = rapidfuzz::fuzz;
+namespace process = rapidfuzz::process;
+
+static std::vector<std::string> get_queries()
+{
+    return {"new york mets", "new YORK mets", "the wonderful new york mets", "", "atlanta braves",
+            str_multiply(std::string("abcdefgh"), 40)};
+}
+
+static std::vector<std::string> get_choices()
+{
+    return {"new york mets vs atlanta braves",
+            "atlanta braves vs new york mets",
+            "new york city mets",
+            "",
+            "{",
+            str_multiply(std::string("abcdefgh"), 19),
+            "new york mets - atlanta braves"};
+}
+
+TEST_CASE("cdist")
+{
+    auto queries = get_queries();
+    auto choices = get_choices();
+    size_t rows = queries.size();
+    size_t cols = choices.size();
+
+    SECTION("ratio matches the scorer for every worker count")
+    {
+        for (int workers : {1, 2, 4, -1}) {
+            std::vector<double> scores(rows * cols);
+            process::cdist<fuzz::CachedRatio>(scores.data(), scores.size(), queries, choices, workers, 50.0);
+
+            for (size_t i = 0; i < rows; ++i)
+                for (size_t j = 0; j < cols; ++j)
+                    REQUIRE_THAT(scores[i * cols + j],
+                                 Catch::Matchers::WithinAbs(fuzz::ratio(queries[i], choices[j], 50.0), 1e-6));
+        }
+    }
+
+    SECTION("levenshtein score methods")
+    {
+        std::vector<size_t> distances(rows * cols);
+        std::vector<size_t> similarities(rows * cols);
+        std::vector<double> norm_distances(rows * cols);
+        std::vector<double> norm_similarities(rows * cols);
+
+        process::cdist<rapidfuzz::CachedLevenshtein, process::ScoreMethod::Distance>(
+            distances.data(), distances.size(), queries, choices, 3);
+        process::cdist<rapidfuzz::CachedLevenshtein, process::ScoreMethod::Similarity>(
+            similarities.data(), similarities.size(), queries, choices, 3, size_t(5));
+        process::cdist<rapidfuzz::CachedLevenshtein, process::ScoreMethod::NormalizedDistance>(
+            norm_distances.data(), norm_distances.size(), queries, choices, 3);
+        process::cdist<rapidfuzz::CachedLevenshtein, process::ScoreMethod::NormalizedSimilarity>(
+            norm_similarities.data(), norm_similarities.size(), queries, choices, 3, 0.5);
+
+        for (size_t i = 0; i < rows; ++i) {
+            for (size_t j = 0; j < cols; ++j) {
+                REQUIRE(distances[i * cols + j] == rapidfuzz::levenshtein_distance(queries[i], choices[j]));
+                REQUIRE(similarities[i * cols + j] ==
+                        rapidfuzz::levenshtein_similarity(queries[i], choices[j], {1, 1, 1}, 5));
+                REQUIRE_THAT(norm_distances[i * cols + j],
+                             Catch::Matchers::WithinAbs(
+                                 rapidfuzz::levenshtein_normalized_distance(queries[i], choices[j]), 1e-6));
+                REQUIRE_THAT(norm_similarities[i * cols + j],
+                             Catch::Matchers::WithinAbs(rapidfuzz::levenshtein_normalized_similarity(
+                                                            queries[i], choices[j], {1, 1, 1}, 0.5),
+                                                        1e-6));
+            }
+        }
+    }
+
+    SECTION("scorer arguments are forwarded")
+    {
+        rapidfuzz::LevenshteinWeightTable weights = {1, 1, 2};
+        std::vector<size_t> distances(rows * cols);
+        process::cdist<rapidfuzz::CachedLevenshtein, process::ScoreMethod::Distance>(
+            distances.data(), distances.size(), queries, choices, 2, std::numeric_limits<size_t>::max(),
+            weights);
+
+        for (size_t i = 0; i < rows; ++i)
+            for (size_t j = 0; j < cols; ++j)
+                REQUIRE(distances[i * cols + j] ==
+                        rapidfuzz::levenshtein_distance(queries[i], choices[j], weights));
+    }
+
+    SECTION("integral result types round and saturate")
+    {
+        std::vector<uint8_t> ratios(rows * cols);
+        process::cdist<fuzz::CachedRatio>(ratios.data(), ratios.size(), queries, choices, 2);
+
+        std::vector<uint8_t> distances(rows * cols);
+        process::cdist<rapidfuzz::CachedLevenshtein, process::ScoreMethod::Distance>(
+            distances.data(), distances.size(), queries, choices, 2);
+
+        for (size_t i = 0; i < rows; ++i) {
+            for (size_t j = 0; j < cols; ++j) {
+                double ratio = fuzz::ratio(queries[i], choices[j]);
+                REQUIRE(ratios[i * cols + j] == static_cast<uint8_t>(std::round(ratio)));
+
+                size_t dist = rapidfuzz::levenshtein_distance(queries[i], choices[j]);
+                REQUIRE(distances[i * cols + j] == std::min<size_t>(dist, 255));
+            }
+        }
+    }
+
+    SECTION("too small result matrix")
+    {
+        std::vector<double> scores(rows * cols - 1);
+        REQUIRE_THROWS_AS(process::cdist<fuzz::CachedRatio>(scores.data(), scores.size(), queries, choices),
+                          std::invalid_argument);
+    }
+
+    SECTION("empty inputs")
+    {
+        std::vector<std::string> empty;
+        std::vector<double> scores;
+        process::cdist<fuzz::CachedRatio>(scores.data(), scores.size(), empty, choices, 4);
+        process::cdist<fuzz::CachedRatio>(scores.data(), scores.size(), queries, empty, 4);
+    }
+}
+
+template <typename ScoreT, typename Func>
+static std::vector<process::ExtractResult<ScoreT>>
+brute_force_extract(const std::vector<std::string>& choices, size_t limit, bool higher_is_better, Func scorer)
+{
+    std::vector<process::ExtractResult<ScoreT>> results;
+    for (size_t i = 0; i < choices.size(); ++i) {
+        process::ExtractResult<ScoreT> result;
+        result.score = scorer(choices[i]);
+        result.index = i;
+        results.push_back(result);
+    }
+
+    std::stable_sort(results.begin(), results.end(),
+                     [&](const process::ExtractResult<ScoreT>& a, const process::ExtractResult<ScoreT>& b) {
+                         return higher_is_better ? a.score > b.score : a.score < b.score;
+                     });
+    if (results.size() > limit) results.resize(limit);
+    return results;
+}
+
+template <typename ScoreT>
+static void check_results(const std::vector<process::ExtractResult<ScoreT>>& results,
+                          const std::vector<process::ExtractResult<ScoreT>>& expected)
+{
+    REQUIRE(results.size() == expected.size());
+    for (size_t i = 0; i < results.size(); ++i) {
+        REQUIRE(results[i].index == expected[i].index);
+        REQUIRE(results[i].score == expected[i].score);
+    }
+}
+
+TEST_CASE("extract")
+{
+    auto queries = get_queries();
+    auto choices = get_choices();
+    /* duplicates to test the ordering of results with the same score */
+    choices.push_back("new york city mets");
+    choices.push_back("new york mets");
+    choices.push_back("new york mets");
+
+    SECTION("ratio")
+    {
+        for (const auto& query : queries) {
+            for (size_t limit = 0; limit <= choices.size() + 1; ++limit) {
+                auto results = process::extract<fuzz::CachedRatio>(query, choices, limit);
+                auto expected = brute_force_extract<double>(choices, limit, true, [&](const std::string& s) {
+                    return fuzz::ratio(query, s);
+                });
+                check_results(results, expected);
+
+                auto filtered = process::extract<fuzz::CachedRatio>(query, choices, limit, 60.0);
+                expected.erase(std::remove_if(expected.begin(), expected.end(),
+                                              [](const process::ExtractResult<double>& r) {
+                                                  return r.score < 60.0;
+                                              }),
+                               expected.end());
+                check_results(filtered, expected);
+            }
+        }
+    }
+
+    SECTION("levenshtein distance")
+    {
+        for (const auto& query : queries) {
+            for (size_t limit = 0; limit <= choices.size() + 1; ++limit) {
+                auto results = process::extract<rapidfuzz::CachedLevenshtein, process::ScoreMethod::Distance>(
+                    query, choices, limit);
+                auto expected = brute_force_extract<size_t>(choices, limit, false, [&](const std::string& s) {
+                    return rapidfuzz::levenshtein_distance(query, s);
+                });
+                check_results(results, expected);
+
+                rapidfuzz::LevenshteinWeightTable weights = {1, 1, 2};
+                auto weighted =
+                    process::extract<rapidfuzz::CachedLevenshtein, process::ScoreMethod::Distance>(
+                        query, choices, limit, size_t(20), weights);
+                expected = brute_force_extract<size_t>(choices, limit, false, [&](const std::string& s) {
+                    return rapidfuzz::levenshtein_distance(query, s, weights);
+                });
+                expected.erase(std::remove_if(expected.begin(), expected.end(),
+                                              [](const process::ExtractResult<size_t>& r) {
+                                                  return r.score > 20;
+                                              }),
+                               expected.end());
+                check_results(weighted, expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("extractOne")
+{
+    auto queries = get_queries();
+    auto choices = get_choices();
+
+    for (const auto& query : queries) {
+        auto best = process::extractOne<fuzz::CachedRatio>(query, choices);
+        auto expected = brute_force_extract<double>(choices, 1, true, [&](const std::string& s) {
+            return fuzz::ratio(query, s);
+        });
+        REQUIRE(best.found());
+        REQUIRE(best.index == expected[0].index);
+        REQUIRE(best.score == expected[0].score);
+
+        auto best_dist =
+            process::extractOne<rapidfuzz::CachedLevenshtein, process::ScoreMethod::Distance>(query, choices);
+        auto expected_dist = brute_force_extract<size_t>(choices, 1, false, [&](const std::string& s) {
+            return rapidfuzz::levenshtein_distance(query, s);
+        });
+        REQUIRE(best_dist.found());
+        REQUIRE(best_dist.index == expected_dist[0].index);
+        REQUIRE(best_dist.score == expected_dist[0].score);
+    }
+
+    REQUIRE(process::extractOne<fuzz::CachedRatio>("new york mets", choices).index == 2);
+    REQUIRE(!process::extractOne<fuzz::CachedRatio>("xyz", choices, 90.0).found());
+    REQUIRE(!process::extractOne<fuzz::CachedRatio>("xyz", std::vector<std::string>()).found());
+}
+
+#ifdef RAPIDFUZZ_SIMD
+static std::vector<std::string> get_bulk_choices()
+{
+    std::vector<std::string> choices;
+    /* cover all buckets including the fallback for strings longer than 64 characters */
+    for (size_t len = 0; len <= 80; len += 3)
+        for (const char* pattern : {"aabc", "cbaa", "new york mets "})
+            choices.push_back(str_multiply(std::string(pattern), 20).substr(0, len));
+    return choices;
+}
+
+TEST_CASE("BulkScorer")
+{
+    namespace rf_exp = rapidfuzz::experimental;
+    using process::experimental::BulkScorer;
+    auto queries = get_queries();
+    auto choices = get_bulk_choices();
+
+    SECTION("levenshtein")
+    {
+        rapidfuzz::LevenshteinWeightTable weights = {1, 1, 1};
+        BulkScorer<rf_exp::MultiLevenshtein, rapidfuzz::CachedLevenshtein, char> scorer(choices, weights);
+        REQUIRE(scorer.size() == choices.size());
+
+        std::vector<size_t> distances(scorer.size());
+        std::vector<double> norm_sims(scorer.size());
+        std::vector<uint8_t> cut_distances(scorer.size());
+        for (const auto& query : queries) {
+            scorer.score<process::ScoreMethod::Distance>(distances.data(), distances.size(), query);
+            scorer.score<process::ScoreMethod::NormalizedSimilarity>(norm_sims.data(), norm_sims.size(),
+                                                                     query, 0.3);
+            scorer.score<process::ScoreMethod::Distance>(cut_distances.data(), cut_distances.size(), query,
+                                                         size_t(10));
+
+            for (size_t i = 0; i < choices.size(); ++i) {
+                REQUIRE(distances[i] == rapidfuzz::levenshtein_distance(choices[i], query, weights));
+                double expected_sim =
+                    rapidfuzz::levenshtein_normalized_similarity(choices[i], query, weights, 0.3);
+                REQUIRE_THAT(norm_sims[i], Catch::Matchers::WithinAbs(expected_sim, 1e-6));
+                REQUIRE(cut_distances[i] == rapidfuzz::levenshtein_distance(choices[i], query, weights, 10));
+            }
+        }
+    }
+
+    SECTION("indel")
+    {
+        BulkScorer<rf_exp::MultiIndel, rapidfuzz::CachedIndel, char> scorer(choices);
+        std::vector<size_t> similarities(scorer.size());
+        for (const auto& query : queries) {
+            scorer.score(similarities.data(), similarities.size(), query);
+            for (size_t i = 0; i < choices.size(); ++i)
+                REQUIRE(similarities[i] == rapidfuzz::indel_similarity(choices[i], query));
+        }
+    }
+
+    SECTION("jaro winkler")
+    {
+        BulkScorer<rf_exp::MultiJaroWinkler, rapidfuzz::CachedJaroWinkler, char> scorer(choices, 0.2);
+        std::vector<double> similarities(scorer.size());
+        for (const auto& query : queries) {
+            scorer.score(similarities.data(), similarities.size(), query, 0.5);
+            for (size_t i = 0; i < choices.size(); ++i) {
+                double expected = rapidfuzz::jaro_winkler_similarity(choices[i], query, 0.2, 0.5);
+                REQUIRE_THAT(similarities[i], Catch::Matchers::WithinAbs(expected, 1e-6));
+            }
+        }
+    }
+
+    SECTION("ratio")
+    {
+        BulkScorer<fuzz::experimental::MultiRatio, fuzz::CachedRatio, char> scorer(choices);
+        std::vector<double> ratios(scorer.size());
+        for (const auto& query : queries) {
+            scorer.score(ratios.data(), ratios.size(), query);
+            for (size_t i = 0; i < choices.size(); ++i)
+                REQUIRE_THAT(ratios[i], Catch::Matchers::WithinAbs(fuzz::ratio(choices[i], query), 1e-6));
+        }
+
+        std::vector<double> too_small(scorer.size() - 1);
+        REQUIRE_THROWS_AS(scorer.score(too_small.data(), too_small.size(), queries[0]),
+                          std::invalid_argument);
+    }
+
+    SECTION("partial_ratio, token_set_ratio and WRatio")
+    {
+        choices.push_back("york new mets new");
+        choices.push_back("caf\xe9 mets");
+        queries.push_back("mets caf\xe9 york");
+
+        BulkScorer<fuzz::experimental::MultiPartialRatio, fuzz::CachedPartialRatio, char> partial_scorer(
+            choices);
+        BulkScorer<fuzz::experimental::MultiTokenSetRatio, fuzz::CachedTokenSetRatio, char> token_set_scorer(
+            choices);
+        BulkScorer<fuzz::experimental::MultiWRatio, fuzz::CachedWRatio, char> wratio_scorer(choices);
+
+        std::vector<double> scores(choices.size());
+        for (const auto& query : queries) {
+            for (double score_cutoff : {0.0, 50.0, 80.0}) {
+                partial_scorer.score(scores.data(), scores.size(), query, score_cutoff);
+                for (size_t i = 0; i < choices.size(); ++i) {
+                    double expected = fuzz::partial_ratio(choices[i], query, score_cutoff);
+                    REQUIRE_THAT(scores[i], Catch::Matchers::WithinAbs(expected, 1e-6));
+                }
+
+                token_set_scorer.score(scores.data(), scores.size(), query, score_cutoff);
+                for (size_t i = 0; i < choices.size(); ++i) {
+                    double expected = fuzz::token_set_ratio(choices[i], query, score_cutoff);
+                    REQUIRE_THAT(scores[i], Catch::Matchers::WithinAbs(expected, 1e-6));
+                }
+
+                wratio_scorer.score(scores.data(), scores.size(), query, score_cutoff);
+                for (size_t i = 0; i < choices.size(); ++i) {
+                    double expected = fuzz::WRatio(choices[i], query, score_cutoff);
+                    REQUIRE_THAT(scores[i], Catch::Matchers::WithinAbs(expected, 1e-6));
+                }
+            }
+        }
+
+        fuzz::experimental::MultiWRatio<8> scorer(1);
+        scorer.insert(std::string("test"));
+        REQUIRE_THROWS_AS(scorer.insert(std::string("test")), std::invalid_argument);
+    }
+
+    SECTION("moved MultiTokenSetRatio keeps its tokens")
+    {
+        using TokenSetScorer = fuzz::experimental::MultiTokenSetRatio<64>;
+        static_assert(!std::is_copy_constructible<TokenSetScorer>::value,
+                      "the tokens point into the strings of the scorer");
+
+        std::vector<std::string> short_choices;
+        for (const auto& choice : choices)
+            if (choice.size() <= 64) short_choices.push_back(choice);
+
+        std::unique_ptr<TokenSetScorer> source(new TokenSetScorer(short_choices.size()));
+        for (const auto& choice : short_choices)
+            source->insert(choice);
+
+        TokenSetScorer scorer(std::move(*source));
+        source.reset();
+
+        std::vector<double> scores(scorer.result_count());
+        for (const auto& query : queries) {
+            scorer.similarity(scores.data(), scores.size(), query);
+            for (size_t i = 0; i < short_choices.size(); ++i) {
+                double expected = fuzz::token_set_ratio(short_choices[i], query);
+                REQUIRE_THAT(scores[i], Catch::Matchers::WithinAbs(expected, 1e-6));
+            }
+        }
+    }
+}
+#endif
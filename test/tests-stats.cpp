@@ -0,0 +1,328 @@
+#if CATCH2_VERSION == 2
+#    include <catch2/catch.hpp>
+#else
+#    include <catch2/catch_test_macros.hpp>
+#endif
+
+#include <cstring>
+#include <rapidfuzz/distance.hpp>
+#include <rapidfuzz/fuzz.hpp>
+#include <rapidfuzz/process.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* compiled with RAPIDFUZZ_ENABLE_STATS */
+
+using rapidfuzz::StatsPath;
+
+static rapidfuzz::PathStats path_stats(StatsPath path)
+{
+    return rapidfuzz::stats_snapshot()[path];
+}
+
+/* total amount of calls of all implementations */
+static uint64_t total_calls()
+{
+    rapidfuzz::Stats stats = rapidfuzz::stats_snapshot();
+    uint64_t calls = 0;
+    for (size_t i = 0; i < static_cast<size_t>(StatsPath::Count); ++i)
+        calls += stats[static_cast<StatsPath>(i)].calls;
+    return calls;
+}
+
+static std::string repeat_alphabet(size_t len)
+{
+    std::string str;
+    for (size_t i = 0; i < len; ++i)
+        str += static_cast<char>('a' + i % 26);
+    return str;
+}
+
+TEST_CASE("Stats")
+{
+    rapidfuzz::stats_reset();
+
+    SECTION("reset clears all counters")
+    {
+        rapidfuzz::levenshtein_distance(std::string("kitten"), std::string("sitting"));
+        REQUIRE(total_calls() != 0);
+
+        rapidfuzz::stats_reset();
+        REQUIRE(total_calls() == 0);
+    }
+
+    SECTION("snapshots are a copy")
+    {
+        rapidfuzz::Stats before = rapidfuzz::stats_snapshot();
+        rapidfuzz::levenshtein_distance(std::string("kitten"), std::string("sitting"));
+        REQUIRE(before[StatsPath::LevenshteinHyrroe2003].calls == 0);
+        REQUIRE(path_stats(StatsPath::LevenshteinHyrroe2003).calls == 1);
+    }
+
+    SECTION("snapshots of multiple threads can be combined")
+    {
+        rapidfuzz::levenshtein_distance(std::string("kitten"), std::string("sitting"));
+
+        rapidfuzz::Stats worker_stats;
+        std::thread worker([&] {
+            rapidfuzz::levenshtein_distance(std::string("kitten"), std::string("sitting"));
+            rapidfuzz::levenshtein_distance(std::string("kitten"), std::string("sitting"));
+            worker_stats = rapidfuzz::stats_snapshot();
+        });
+        worker.join();
+
+        /* the worker does not update the counters of this thread */
+        rapidfuzz::Stats stats = rapidfuzz::stats_snapshot();
+        REQUIRE(stats[StatsPath::LevenshteinHyrroe2003].calls == 1);
+        REQUIRE(worker_stats[StatsPath::LevenshteinHyrroe2003].calls == 2);
+
+        stats += worker_stats;
+        REQUIRE(stats[StatsPath::LevenshteinHyrroe2003].calls == 3);
+        REQUIRE(stats[StatsPath::LevenshteinHyrroe2003].words == 3 * std::strlen("sitting"));
+    }
+
+    SECTION("cdist adds the counters of its workers")
+    {
+        /* the rows take long enough, so the workers process some of them */
+        std::vector<std::string> strings;
+        for (size_t i = 0; i < 64; ++i)
+            strings.push_back("x" + repeat_alphabet(200 + 7 * i));
+        std::vector<size_t> scores(strings.size() * strings.size());
+
+        rapidfuzz::process::cdist<rapidfuzz::CachedLevenshtein, rapidfuzz::process::ScoreMethod::Distance>(
+            scores.data(), scores.size(), strings, strings, 1);
+        rapidfuzz::Stats single_thread = rapidfuzz::stats_snapshot();
+        REQUIRE(single_thread[StatsPath::LevenshteinBlock].calls != 0);
+
+        rapidfuzz::stats_reset();
+        rapidfuzz::process::cdist<rapidfuzz::CachedLevenshtein, rapidfuzz::process::ScoreMethod::Distance>(
+            scores.data(), scores.size(), strings, strings, 4);
+        rapidfuzz::Stats multi_thread = rapidfuzz::stats_snapshot();
+        for (size_t i = 0; i < static_cast<size_t>(StatsPath::Count); ++i) {
+            auto path = static_cast<StatsPath>(i);
+            REQUIRE(multi_thread[path].calls == single_thread[path].calls);
+            REQUIRE(multi_thread[path].words == single_thread[path].words);
+        }
+    }
+
+    SECTION("names")
+    {
+        using rapidfuzz::to_string;
+        REQUIRE(std::string(to_string(StatsPath::LevenshteinSmallBand)) == "Levenshtein/small_band");
+        REQUIRE(std::string(to_string(StatsPath::FuzzWRatio)) == "fuzz/WRatio");
+        for (size_t i = 0; i < static_cast<size_t>(StatsPath::Count); ++i)
+            REQUIRE(std::string(to_string(static_cast<StatsPath>(i))) != "unknown");
+    }
+}
+
+TEST_CASE("Stats Levenshtein")
+{
+    rapidfuzz::stats_reset();
+
+    SECTION("filter")
+    {
+        REQUIRE(rapidfuzz::levenshtein_distance(std::string("abc"), std::string("abc"), {1, 1, 1}, 0) == 0);
+        REQUIRE(rapidfuzz::levenshtein_distance(std::string("a"), std::string("abcdef"), {1, 1, 1}, 2) == 3);
+        REQUIRE(path_stats(StatsPath::LevenshteinFilter).calls == 2);
+        REQUIRE(total_calls() == 2);
+    }
+
+    SECTION("mbleven")
+    {
+        std::string s1 = "abcdef";
+        REQUIRE(rapidfuzz::levenshtein_distance(s1, std::string("abxdef"), {1, 1, 1}, 2) == 1);
+        rapidfuzz::CachedLevenshtein<char> scorer(s1);
+        REQUIRE(scorer.distance(std::string("abxdef"), 2) == 1);
+
+        REQUIRE(path_stats(StatsPath::LevenshteinMbleven).calls == 2);
+        REQUIRE(total_calls() == 2);
+    }
+
+    SECTION("hyrroe2003")
+    {
+        REQUIRE(rapidfuzz::levenshtein_distance(std::string("xbcdefgh"), std::string("bcdefghy")) == 2);
+
+        auto stats = path_stats(StatsPath::LevenshteinHyrroe2003);
+        REQUIRE(stats.calls == 1);
+        REQUIRE(stats.words == 8);
+        REQUIRE(stats.early_exits == 0);
+        REQUIRE(total_calls() == 1);
+    }
+
+    SECTION("small band with early exit")
+    {
+        std::string s1(200, 'a');
+        std::string s2(200, 'b');
+        REQUIRE(rapidfuzz::levenshtein_distance(s1, s2, {1, 1, 1}, 10) == 11);
+
+        auto stats = path_stats(StatsPath::LevenshteinSmallBand);
+        REQUIRE(stats.calls == 1);
+        REQUIRE(stats.early_exits == 1);
+        REQUIRE(stats.words > 0);
+        REQUIRE(stats.words < s2.size());
+    }
+
+    SECTION("block")
+    {
+        std::string s1 = repeat_alphabet(300);
+        std::string s2 = s1;
+        s2[10] = '0';
+        s2[290] = '1';
+        REQUIRE(rapidfuzz::levenshtein_distance(s1, s2) == 2);
+
+        auto stats = path_stats(StatsPath::LevenshteinBlock);
+        REQUIRE(stats.calls == 1);
+        REQUIRE(stats.early_exits == 0);
+        REQUIRE(stats.words >= s2.size() - 20);
+    }
+
+    SECTION("wagner fischer")
+    {
+        REQUIRE(rapidfuzz::levenshtein_distance(std::string("xabc"), std::string("abcy"), {1, 2, 2}) == 3);
+
+        auto stats = path_stats(StatsPath::LevenshteinWagnerFischer);
+        REQUIRE(stats.calls == 1);
+        REQUIRE(stats.words == 16);
+    }
+
+#ifdef RAPIDFUZZ_SIMD
+    SECTION("simd")
+    {
+        rapidfuzz::experimental::MultiLevenshtein<8> scorer(2);
+        scorer.insert(std::string("kitten"));
+        scorer.insert(std::string("sitting"));
+        std::vector<size_t> results(scorer.result_count());
+        scorer.distance(&results[0], results.size(), std::string("mitten"));
+
+        REQUIRE(path_stats(StatsPath::LevenshteinSimd).calls == 1);
+        REQUIRE(total_calls() == 1);
+    }
+#endif
+}
+
+TEST_CASE("Stats Indel")
+{
+    rapidfuzz::stats_reset();
+
+    SECTION("filter")
+    {
+        REQUIRE(rapidfuzz::indel_distance(std::string("a"), std::string("abcdef"), 2) == 3);
+        REQUIRE(path_stats(StatsPath::LCSseqFilter).calls == 1);
+    }
+
+    SECTION("mbleven")
+    {
+        REQUIRE(rapidfuzz::indel_distance(std::string("abcdef"), std::string("abdcef"), 2) == 2);
+        REQUIRE(path_stats(StatsPath::LCSseqMbleven).calls == 1);
+    }
+
+    SECTION("unroll")
+    {
+        REQUIRE(rapidfuzz::indel_distance(std::string("xbcdefgh"), std::string("bcdefghy")) == 2);
+
+        auto stats = path_stats(StatsPath::LCSseqUnroll);
+        REQUIRE(stats.calls == 1);
+        REQUIRE(stats.words == 8);
+    }
+
+    SECTION("blockwise")
+    {
+        std::string s1 = repeat_alphabet(1000);
+        std::string s2 = "0" + s1.substr(1, 998) + "1";
+        REQUIRE(rapidfuzz::indel_distance(s1, s2) == 4);
+
+        auto stats = path_stats(StatsPath::LCSseqBlockwise);
+        REQUIRE(stats.calls == 1);
+        REQUIRE(stats.words > 0);
+    }
+}
+
+TEST_CASE("Stats other metrics")
+{
+    rapidfuzz::stats_reset();
+
+    SECTION("OSA")
+    {
+        REQUIRE(rapidfuzz::osa_distance(std::string("xbcd"), std::string("xbdc")) == 1);
+        REQUIRE(path_stats(StatsPath::OSAHyrroe2003).calls == 1);
+
+        std::string s1 = repeat_alphabet(100);
+        REQUIRE(rapidfuzz::osa_distance(s1, "0" + s1.substr(1, 98) + "1") == 2);
+        auto stats = path_stats(StatsPath::OSABlock);
+        REQUIRE(stats.calls == 1);
+        REQUIRE(stats.words == 2 * s1.size());
+
+        REQUIRE(rapidfuzz::osa_distance(std::string("abc"), std::string("abc")) == 0);
+        REQUIRE(path_stats(StatsPath::OSAFilter).calls == 1);
+    }
+
+    SECTION("DamerauLevenshtein")
+    {
+        /* OSA distance 3, Damerau Levenshtein distance 2 */
+        using rapidfuzz::experimental::damerau_levenshtein_distance;
+        REQUIRE(damerau_levenshtein_distance(std::string("ca"), std::string("abc")) == 2);
+        auto stats = path_stats(StatsPath::DamerauLevenshteinZhao);
+        REQUIRE(stats.calls == 1);
+        REQUIRE(stats.words > 0);
+        REQUIRE(path_stats(StatsPath::OSAHyrroe2003).calls == 1);
+
+        /* the OSA distance is enough */
+        REQUIRE(damerau_levenshtein_distance(std::string("abc"), std::string("acb")) == 1);
+        REQUIRE(path_stats(StatsPath::DamerauLevenshteinFilter).calls == 1);
+        REQUIRE(path_stats(StatsPath::DamerauLevenshteinZhao).calls == 1);
+    }
+
+    SECTION("Jaro")
+    {
+        rapidfuzz::jaro_similarity(std::string("martha"), std::string("marhta"));
+        REQUIRE(path_stats(StatsPath::JaroSingleWord).calls == 1);
+
+        std::string s1 = repeat_alphabet(100);
+        rapidfuzz::jaro_similarity(s1, "0" + s1.substr(1));
+        REQUIRE(path_stats(StatsPath::JaroBlock).calls == 1);
+
+        rapidfuzz::jaro_similarity(std::string(""), std::string(""));
+        REQUIRE(path_stats(StatsPath::JaroFilter).calls == 1);
+    }
+
+    SECTION("Hamming, Prefix and Postfix")
+    {
+        REQUIRE(rapidfuzz::hamming_distance(std::string("karolin"), std::string("kathrin")) == 3);
+        REQUIRE(path_stats(StatsPath::Hamming).calls == 1);
+        REQUIRE(path_stats(StatsPath::Hamming).words == 7);
+
+        REQUIRE(rapidfuzz::prefix_similarity(std::string("abcd"), std::string("abxx")) == 2);
+        REQUIRE(path_stats(StatsPath::Prefix).words == 2);
+
+        REQUIRE(rapidfuzz::postfix_similarity(std::string("xxcd"), std::string("abcd")) == 2);
+        REQUIRE(path_stats(StatsPath::Postfix).words == 2);
+    }
+}
+
+TEST_CASE("Stats fuzz")
+{
+    rapidfuzz::stats_reset();
+
+    SECTION("partial_ratio stops at a perfect match")
+    {
+        REQUIRE(rapidfuzz::fuzz::partial_ratio(std::string("abcd"), std::string("xxxabcdxxxxxxxxx")) == 100);
+
+        auto stats = path_stats(StatsPath::FuzzPartialRatio);
+        REQUIRE(stats.calls == 1);
+        REQUIRE(stats.words > 0);
+        REQUIRE(stats.early_exits == 1);
+    }
+
+    SECTION("scorers count the scorers they use")
+    {
+        rapidfuzz::fuzz::WRatio(std::string("this is a test"), std::string("this is a test!"));
+        REQUIRE(path_stats(StatsPath::FuzzWRatio).calls == 1);
+        REQUIRE(path_stats(StatsPath::FuzzRatio).calls >= 1);
+        REQUIRE(path_stats(StatsPath::FuzzTokenRatio).calls == 1);
+
+        rapidfuzz::fuzz::CachedTokenSetRatio<char> scorer(std::string("fuzzy wuzzy was a bear"));
+        scorer.similarity(std::string("wuzzy fuzzy was a bear"));
+        REQUIRE(path_stats(StatsPath::FuzzTokenSetRatio).calls == 1);
+    }
+}
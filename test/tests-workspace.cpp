@@ -0,0 +1,261 @@
+#if CATCH2_VERSION == 2
+#    include <catch2/catch.hpp>
+#else
+#    include <catch2/catch_test_macros.hpp>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <rapidfuzz/details/parallel.hpp>
+#include <rapidfuzz/distance.hpp>
+#include <rapidfuzz/fuzz.hpp>
+#include <thread>
+
+#include "allocations.hpp"
+#include "common.hpp"
+
+/* number of heap allocations made by func */
+template <typename Func>
+static size_t count_allocations(Func func)
+{
+    uint64_t before = allocations::current().allocations;
+    func();
+    return static_cast<size_t>(allocations::current().allocations - before);
+}
+
+/* calls func once to warm up the workspace and returns the allocations of the second call */
+template <typename Func>
+static size_t steady_state_allocations(Func func)
+{
+    rapidfuzz::Workspace workspace;
+    rapidfuzz::WorkspaceGuard guard(workspace);
+    auto first = func();
+    decltype(first) second;
+    size_t allocations = count_allocations([&] { second = func(); });
+    REQUIRE(first == second);
+    return allocations;
+}
+
+template <typename Scorer, typename Sentence>
+static size_t steady_state_allocations(const Scorer& scorer, const Sentence& s2)
+{
+    return steady_state_allocations([&] { return scorer.similarity(s2); });
+}
+
+#ifdef RAPIDFUZZ_SIMD
+template <typename MultiScorer>
+static size_t multi_allocations(MultiScorer& scorer, const std::vector<std::string>& choices,
+                                const std::string& query)
+{
+    for (const auto& choice : choices)
+        scorer.insert(choice);
+
+    std::vector<double> scores(scorer.result_count());
+    return steady_state_allocations([&] {
+        scorer.similarity(scores.data(), scores.size(), query);
+        double sum = 0;
+        for (double score : scores)
+            sum += score;
+        return sum;
+    });
+}
+#endif
+
+TEST_CASE("Workspace")
+{
+    using rapidfuzz::detail::ScratchFrame;
+    using rapidfuzz::detail::ScratchVector;
+
+    SECTION("scratch buffers use the heap without a bound workspace")
+    {
+        ScratchFrame frame;
+        ScratchVector<int> vec(100);
+        REQUIRE(vec.size() == 100);
+    }
+
+    SECTION("frames rewind the workspace")
+    {
+        rapidfuzz::Workspace workspace;
+        rapidfuzz::WorkspaceGuard guard(workspace);
+
+        const int* first_data;
+        {
+            ScratchFrame frame;
+            ScratchVector<int> vec(100, 1);
+            first_data = vec.data();
+        }
+        size_t capacity = workspace.capacity();
+        REQUIRE(capacity >= 100 * sizeof(int));
+
+        size_t allocations = count_allocations([&] {
+            ScratchFrame frame;
+            ScratchVector<int> vec(100, 2);
+            REQUIRE(vec.data() == first_data);
+        });
+        REQUIRE(allocations == 0);
+        REQUIRE(workspace.capacity() == capacity);
+
+        workspace.release();
+        REQUIRE(workspace.capacity() == 0);
+    }
+
+    SECTION("buffers of an outer frame stay valid")
+    {
+        rapidfuzz::Workspace workspace(64);
+        rapidfuzz::WorkspaceGuard guard(workspace);
+
+        ScratchFrame outer;
+        ScratchVector<size_t> vec;
+        for (size_t i = 0; i < 1000; ++i) {
+            ScratchFrame inner;
+            ScratchVector<size_t> tmp(i + 1, i);
+            vec.push_back(tmp.back());
+        }
+
+        for (size_t i = 0; i < 1000; ++i)
+            REQUIRE(vec[i] == i);
+    }
+
+    SECTION("guards restore the previous workspace")
+    {
+        rapidfuzz::Workspace workspace1;
+        rapidfuzz::Workspace workspace2;
+        rapidfuzz::WorkspaceGuard guard1(workspace1);
+        {
+            rapidfuzz::WorkspaceGuard guard2(workspace2);
+            ScratchFrame frame;
+            ScratchVector<int> vec(10);
+            REQUIRE(workspace2.capacity() != 0);
+        }
+        REQUIRE(workspace1.capacity() == 0);
+
+        ScratchFrame frame;
+        ScratchVector<int> vec(10);
+        REQUIRE(workspace1.capacity() != 0);
+    }
+
+    SECTION("parallel_for keeps the workspace of the calling thread")
+    {
+        rapidfuzz::Workspace workspace;
+        rapidfuzz::WorkspaceGuard guard(workspace);
+        std::thread::id caller = std::this_thread::get_id();
+
+        for (int workers : {1, 4}) {
+            std::atomic<size_t> caller_tasks(0);
+            std::atomic<size_t> foreign(0);
+            rapidfuzz::detail::parallel_for(workers, 64, [&](size_t) {
+                bool is_caller = std::this_thread::get_id() == caller;
+                caller_tasks += is_caller;
+                if (is_caller != (rapidfuzz::detail::bound_workspace() == &workspace)) ++foreign;
+                /* give the calling thread a share of the tasks */
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            });
+            REQUIRE(caller_tasks != 0);
+            REQUIRE(foreign == 0);
+        }
+        REQUIRE(rapidfuzz::detail::bound_workspace() == &workspace);
+    }
+}
+
+TEST_CASE("Scoring with a bound Workspace does not allocate")
+{
+    std::string a = str_multiply(std::string("abcdefghijklmnopqrstuvwxyz0123456789"), 10);
+    std::string b = str_multiply(std::string("abcdefghijklmnopqrstuvwxyz01234 6789"), 11);
+
+    SECTION("Levenshtein")
+    {
+        rapidfuzz::CachedLevenshtein<char> scorer(a);
+        REQUIRE(steady_state_allocations(scorer, b) == 0);
+    }
+
+    SECTION("LCSseq")
+    {
+        rapidfuzz::CachedLCSseq<char> scorer(a);
+        REQUIRE(steady_state_allocations(scorer, b) == 0);
+    }
+
+    SECTION("OSA")
+    {
+        rapidfuzz::CachedOSA<char> scorer(a);
+        REQUIRE(steady_state_allocations(scorer, b) == 0);
+    }
+
+    SECTION("DamerauLevenshtein")
+    {
+        rapidfuzz::experimental::CachedDamerauLevenshtein<char> scorer(a);
+        REQUIRE(steady_state_allocations(scorer, b) == 0);
+    }
+
+    SECTION("partial_ratio")
+    {
+        rapidfuzz::fuzz::CachedPartialRatio<char> scorer("xyz0123456789abcdefghijk");
+        REQUIRE(steady_state_allocations(scorer, b) == 0);
+
+        /* strings of the same length are aligned in both directions */
+        rapidfuzz::fuzz::CachedPartialRatio<char> scorer2(a);
+        REQUIRE(steady_state_allocations(scorer2, b.substr(0, a.size())) == 0);
+    }
+
+    SECTION("free functions")
+    {
+        using namespace rapidfuzz;
+        REQUIRE(steady_state_allocations([&] { return levenshtein_distance(a, b); }) == 0);
+        REQUIRE(steady_state_allocations([&] { return lcs_seq_similarity(a, b); }) == 0);
+        REQUIRE(steady_state_allocations([&] { return osa_distance(a, b); }) == 0);
+        REQUIRE(steady_state_allocations([&] { return jaro_similarity(a, b); }) == 0);
+        REQUIRE(steady_state_allocations([&] { return fuzz::ratio(a, b); }) == 0);
+        REQUIRE(steady_state_allocations([&] { return fuzz::partial_ratio(a, b); }) == 0);
+        REQUIRE(steady_state_allocations([&] { return fuzz::WRatio(a, b); }) == 0);
+    }
+
+    SECTION("token based ratios")
+    {
+        std::string s1 = "new york mets vs atlanta braves";
+        std::string s2 = "atlanta braves vs new yrok mets at the citi field";
+
+        REQUIRE(steady_state_allocations(rapidfuzz::fuzz::CachedTokenSortRatio<char>(s1), s2) == 0);
+        REQUIRE(steady_state_allocations(rapidfuzz::fuzz::CachedTokenSetRatio<char>(s1), s2) == 0);
+        REQUIRE(steady_state_allocations(rapidfuzz::fuzz::CachedTokenRatio<char>(s1), s2) == 0);
+        REQUIRE(steady_state_allocations(rapidfuzz::fuzz::CachedWRatio<char>(s1), s2) == 0);
+    }
+
+#ifdef RAPIDFUZZ_SIMD
+    SECTION("Multi scorers")
+    {
+        std::vector<std::string> choices = {"new york mets", "atlanta braves vs new yrok mets",
+                                            "abcdefghijklmnopqrstuvwxyz", "new york"};
+        std::string query = "new york mets vs atlanta braves";
+
+        rapidfuzz::fuzz::experimental::MultiPartialRatio<64> partial_ratio(choices.size());
+        REQUIRE(multi_allocations(partial_ratio, choices, query) == 0);
+        rapidfuzz::fuzz::experimental::MultiTokenSetRatio<64> token_set_ratio(choices.size());
+        REQUIRE(multi_allocations(token_set_ratio, choices, query) == 0);
+        rapidfuzz::fuzz::experimental::MultiWRatio<64> wratio(choices.size());
+        REQUIRE(multi_allocations(wratio, choices, query) == 0);
+    }
+#endif
+}
+
+TEST_CASE("Scoring with a bound Workspace returns the same results")
+{
+    std::vector<std::string> strings = {"",
+                                        "new york mets",
+                                        "new york mets vs atlanta braves",
+                                        "atlanta braves vs new yrok mets at the citi field",
+                                        str_multiply(std::string("abcdefghij "), 20),
+                                        str_multiply(std::string("bcdefghija "), 25)};
+
+    rapidfuzz::Workspace workspace;
+    for (const auto& s1 : strings) {
+        for (const auto& s2 : strings) {
+            double expected_wratio = rapidfuzz::fuzz::WRatio(s1, s2);
+            double expected_partial = rapidfuzz::fuzz::partial_token_ratio(s1, s2);
+            size_t expected_lev = rapidfuzz::levenshtein_distance(s1, s2);
+
+            rapidfuzz::WorkspaceGuard guard(workspace);
+            REQUIRE(rapidfuzz::fuzz::WRatio(s1, s2) == expected_wratio);
+            REQUIRE(rapidfuzz::fuzz::partial_token_ratio(s1, s2) == expected_partial);
+            REQUIRE(rapidfuzz::levenshtein_distance(s1, s2) == expected_lev);
+        }
+    }
+}
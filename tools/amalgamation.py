@@ -71,7 +71,11 @@ def concatenate_file(out, filename: str) -> int:
 
             next_header = m.group(1)
             # We have to avoid re-expanding the same header over and
-            # over again
+            # over again. *.impl files are meant to be included multiple
+            # times (once per instruction set), so they are always expanded
+            if next_header.endswith('.impl'):
+                concatenated += concatenate_file(out, os.path.join(root_path, next_header))
+                continue
             if next_header in concatenated_headers:
                 continue
             concatenated_headers.add(next_header)